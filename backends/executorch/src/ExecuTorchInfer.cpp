@@ -1,11 +1,12 @@
 #include "ExecuTorchInfer.hpp"
 
-#include <cstring>
+#include "ITensorConverter.hpp"
+
 #include <glog/logging.h>
 #include <numeric>
 
 using executorch::aten::ScalarType;
-using executorch::extension::make_tensor_ptr;
+using executorch::extension::from_blob;
 using executorch::extension::TensorPtr;
 
 namespace {
@@ -46,48 +47,47 @@ std::vector<int64_t> shape_with_batch(const std::vector<int64_t>& shape, size_t
     return result;
 }
 
-TensorPtr make_input_tensor(ScalarType input_type, const std::vector<int64_t>& shape,
-                            const std::vector<uint8_t>& bytes) {
-    const auto et_shape = to_executorch_dims(shape);
+// Wraps the caller's bytes in place; the view must outlive forward().
+TensorPtr make_input_tensor(ScalarType input_type, const std::vector<int64_t>& shape, const TensorView& bytes) {
     const auto expected_numel = num_elements(shape);
 
+    size_t element_size = 0;
+    const char* type_name = nullptr;
     switch (input_type) {
-    case ScalarType::Float: {
-        const auto expected_bytes = expected_numel * sizeof(float);
-        if (bytes.size() != expected_bytes) {
-            throw InferenceExecutionException("ExecuTorch float input byte size mismatch");
-        }
-        std::vector<float> values(expected_numel);
-        std::memcpy(values.data(), bytes.data(), expected_bytes);
-        return make_tensor_ptr(et_shape, std::move(values));
-    }
-    case ScalarType::Int: {
-        const auto expected_bytes = expected_numel * sizeof(int32_t);
-        if (bytes.size() != expected_bytes) {
-            throw InferenceExecutionException("ExecuTorch int32 input byte size mismatch");
-        }
-        std::vector<int32_t> values(expected_numel);
-        std::memcpy(values.data(), bytes.data(), expected_bytes);
-        return make_tensor_ptr(et_shape, std::move(values));
-    }
-    case ScalarType::Long: {
-        const auto expected_bytes = expected_numel * sizeof(int64_t);
-        if (bytes.size() != expected_bytes) {
-            throw InferenceExecutionException("ExecuTorch int64 input byte size mismatch");
-        }
-        std::vector<int64_t> values(expected_numel);
-        std::memcpy(values.data(), bytes.data(), expected_bytes);
-        return make_tensor_ptr(et_shape, std::move(values));
-    }
-    case ScalarType::Byte: {
-        if (bytes.size() != expected_numel) {
-            throw InferenceExecutionException("ExecuTorch uint8 input byte size mismatch");
-        }
-        return make_tensor_ptr(et_shape, bytes);
-    }
+    case ScalarType::Float:
+        element_size = sizeof(float);
+        type_name = "float";
+        break;
+    case ScalarType::Int:
+        element_size = sizeof(int32_t);
+        type_name = "int32";
+        break;
+    case ScalarType::Long:
+        element_size = sizeof(int64_t);
+        type_name = "int64";
+        break;
+    case ScalarType::Byte:
+        element_size = sizeof(uint8_t);
+        type_name = "uint8";
+        break;
     default:
         throw InferenceExecutionException("ExecuTorch input scalar type is not supported by neuriplo");
     }
+
+    if (bytes.size_bytes != expected_numel * element_size) {
+        throw InferenceExecutionException(std::string("ExecuTorch ") + type_name + " input byte size mismatch");
+    }
+    return from_blob(const_cast<uint8_t*>(bytes.data), to_executorch_dims(shape), input_type);
+}
+
+// ExecuTorch maps the program through its MmapDataLoader itself; it has no
+// prefault switch, so only the lock setting carries over.
+executorch::extension::Module::LoadMode module_load_mode(const MmapTuning& mmap) {
+    using LoadMode = executorch::extension::Module::LoadMode;
+    if (mmap.enabled == TuningToggle::Off) {
+        return LoadMode::File;
+    }
+    return mmap.lock == TuningToggle::On ? LoadMode::MmapUseMlockIgnoreErrors : LoadMode::Mmap;
 }
 
 } // namespace
@@ -142,8 +142,9 @@ TensorDtype ExecuTorchInfer::scalarTypeToRawDtype(ScalarType type) {
 }
 
 ExecuTorchInfer::ExecuTorchInfer(const std::string& model_path, bool use_gpu, size_t batch_size,
-                                 const std::vector<std::vector<int64_t>>& input_sizes)
-    : InferenceInterface{model_path, use_gpu, batch_size, input_sizes}, module_(model_path) {
+                                 const std::vector<std::vector<int64_t>>& input_sizes, const MmapTuning& mmap)
+    : InferenceInterface{model_path, use_gpu, batch_size, input_sizes},
+      module_(model_path, module_load_mode(mmap.with_env_defaults())) {
     LOG(INFO) << "ExecuTorch backend configured with delegate: " << NEURIPLO_EXECUTORCH_DELEGATE;
 
     gpu_available_ = false;
@@ -216,7 +217,7 @@ std::vector<int64_t> ExecuTorchInfer::resolve_shape(const std::vector<int64_t>&
 }
 
 executorch::runtime::Result<std::vector<executorch::runtime::EValue>>
-ExecuTorchInfer::run_forward(const std::vector<std::vector<uint8_t>>& input_tensors) {
+ExecuTorchInfer::run_forward(const std::vector<TensorView>& input_tensors) {
     validate_input(input_tensors);
 
     const auto& inputs = inference_metadata_.getInputs();
@@ -233,7 +234,14 @@ ExecuTorchInfer::run_forward(const std::vector<std::vector<uint8_t>>& input_tens
 
     for (size_t i = 0; i < inputs.size(); ++i) {
         const auto input_type = i < input_types_.size() ? input_types_[i] : ScalarType::Float;
-        bound_input_tensors_.push_back(make_input_tensor(input_type, inputs[i].shape, input_tensors[i]));
+        // Methods exported with dynamic dims resize their inputs up to the
+        // exported bounds, so a per-call shape only has to keep the rank.
+        const std::vector<int64_t> shape =
+            input_tensors[i].has_shape()
+                ? resolve_input_shape(input_tensors[i], i, std::vector<int64_t>(inputs[i].shape.size(), -1),
+                                      tensor_data_type_size(inputs[i].datatype))
+                : inputs[i].shape;
+        bound_input_tensors_.push_back(make_input_tensor(input_type, shape, input_tensors[i]));
         bound_input_values_.emplace_back(*bound_input_tensors_.back());
     }
 
@@ -255,34 +263,22 @@ void ExecuTorchInfer::append_output_tensors(const std::vector<executorch::runtim
         output_values.reserve(output_numel);
 
         switch (output_tensor.scalar_type()) {
-        case ScalarType::Float: {
-            const float* data = output_tensor.const_data_ptr<float>();
-            for (size_t j = 0; j < output_numel; ++j) {
-                output_values.emplace_back(data[j]);
-            }
+        case ScalarType::Float:
+            tensor_converter().append_elements(output_values, output_tensor.const_data_ptr<float>(), output_numel,
+                                               ElementType::Float32);
             break;
-        }
-        case ScalarType::Int: {
-            const int32_t* data = output_tensor.const_data_ptr<int32_t>();
-            for (size_t j = 0; j < output_numel; ++j) {
-                output_values.emplace_back(data[j]);
-            }
+        case ScalarType::Int:
+            tensor_converter().append_elements(output_values, output_tensor.const_data_ptr<int32_t>(), output_numel,
+                                               ElementType::Int32);
             break;
-        }
-        case ScalarType::Long: {
-            const int64_t* data = output_tensor.const_data_ptr<int64_t>();
-            for (size_t j = 0; j < output_numel; ++j) {
-                output_values.emplace_back(data[j]);
-            }
+        case ScalarType::Long:
+            tensor_converter().append_elements(output_values, output_tensor.const_data_ptr<int64_t>(), output_numel,
+                                               ElementType::Int64);
             break;
-        }
-        case ScalarType::Byte: {
-            const uint8_t* data = output_tensor.const_data_ptr<uint8_t>();
-            for (size_t j = 0; j < output_numel; ++j) {
-                output_values.emplace_back(data[j]);
-            }
+        case ScalarType::Byte:
+            tensor_converter().append_elements(output_values, output_tensor.const_data_ptr<uint8_t>(), output_numel,
+                                               ElementType::UInt8);
             break;
-        }
         default:
             throw InferenceExecutionException("ExecuTorch output scalar type is not supported by neuriplo");
         }
@@ -343,6 +339,11 @@ ExecuTorchInfer::raw_outputs_from_values(const std::vector<executorch::runtime::
 
 std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
 ExecuTorchInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+ExecuTorchInfer::get_infer_results(const std::vector<TensorView>& input_tensors) {
     const auto result = run_forward(input_tensors);
     if (!result.ok()) {
         throw InferenceExecutionException("ExecuTorch forward() failed");
@@ -356,6 +357,10 @@ ExecuTorchInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& inpu
 
 std::vector<RawOutputTensor>
 ExecuTorchInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> ExecuTorchInfer::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
     const auto result = run_forward(input_tensors);
     if (!result.ok()) {
         throw InferenceExecutionException("ExecuTorch forward() failed");
@@ -1,4 +1,5 @@
 #pragma once
+#include "BackendTuning.hpp"
 #include "InferenceInterface.hpp"
 
 #include <executorch/extension/module/module.h>
@@ -9,11 +10,15 @@
 class ExecuTorchInfer : public InferenceInterface {
   public:
     ExecuTorchInfer(const std::string& model_path, bool use_gpu = false, size_t batch_size = 1,
-                    const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>());
+                    const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>(),
+                    const MmapTuning& mmap = MmapTuning());
 
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& input_tensors) override;
     std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& input_tensors) override;
 
   private:
     std::vector<int64_t> resolve_shape(const std::vector<int64_t>& metadata_shape,
@@ -29,7 +34,7 @@ class ExecuTorchInfer : public InferenceInterface {
     std::vector<executorch::runtime::EValue> bound_input_values_;
 
     executorch::runtime::Result<std::vector<executorch::runtime::EValue>>
-    run_forward(const std::vector<std::vector<uint8_t>>& input_tensors);
+    run_forward(const std::vector<TensorView>& input_tensors);
     void append_output_tensors(const std::vector<executorch::runtime::EValue>& result_values,
                                std::vector<std::vector<TensorElement>>& output_vectors,
                                std::vector<std::vector<int64_t>>& shape_vectors) const;
@@ -20,6 +20,12 @@ class ExecuTorchRuntimeFactory : public IBackendRuntimeFactory {
         return std::make_unique<ExecuTorchInfer>(model_path, use_gpu, batch_size, input_sizes);
     }
 
+    std::unique_ptr<InferenceInterface> create_backend(const std::string& model_path, bool use_gpu, size_t batch_size,
+                                                       const std::vector<std::vector<int64_t>>& input_sizes,
+                                                       const BackendTuning& tuning) override {
+        return std::make_unique<ExecuTorchInfer>(model_path, use_gpu, batch_size, input_sizes, tuning.mmap);
+    }
+
     std::unique_ptr<IAllocator> create_allocator() override { return std::make_unique<HostAllocator>(); }
     std::unique_ptr<ITensorConverter> create_converter() override { return std::make_unique<HostTensorConverter>(); }
 
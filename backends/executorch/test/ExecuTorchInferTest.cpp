@@ -1,5 +1,7 @@
 #include "ExecuTorchInfer.hpp"
 
+#include "RawOutputConformance.hpp"
+
 #include <cstring>
 #include <filesystem>
 #include <fstream>
@@ -93,6 +95,22 @@ TEST_F(ExecuTorchInferTest, IntegrationTest) {
     ASSERT_EQ(shape_vectors[0][0], 1);
 }
 
+// Raw path must stay byte-identical to the variant path - only runs with real model
+TEST_F(ExecuTorchInferTest, RawMatchesVariant) {
+    if (!has_real_model) {
+        GTEST_SKIP() << "Skipping integration test - no real ExecuTorch model available";
+    }
+
+    cv::Mat input = cv::Mat::zeros(224, 224, CV_32FC3);
+    cv::Mat blob;
+    cv::dnn::blobFromImage(input, blob, 1.f / 255.f, cv::Size(224, 224), cv::Scalar(), true, false);
+
+    std::vector<uint8_t> input_data(blob.total() * blob.elemSize());
+    std::memcpy(input_data.data(), blob.data, input_data.size());
+    std::vector<std::vector<uint8_t>> input_tensors = {input_data};
+    EXPECT_TRUE(RawMatchesVariant(*real_infer, input_tensors));
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -1,5 +1,7 @@
 #include "GGMLInfer.hpp"
 
+#include "ITensorConverter.hpp"
+
 #include <fstream>
 #include <ggml-cpu.h>
 #include <sstream>
@@ -12,8 +14,11 @@ GGMLInfer::GGMLInfer(const std::string& model_path, bool use_gpu, size_t batch_s
     try {
         LOG(INFO) << "Running using GGML runtime: " << model_path;
 
-        // Initialize GGML
-        ggml_init_params params = {.mem_size = 1024 * 1024 * 1024, // 1GB
+        // Initialize GGML. With no_alloc the context only holds tensor and
+        // graph metadata (data lives in the backend buffer), so size it for
+        // that instead of reserving a fixed 1 GB arena per instance.
+        constexpr size_t kMaxContextTensors = 16;
+        ggml_init_params params = {.mem_size = ggml_tensor_overhead() * kMaxContextTensors + ggml_graph_overhead(),
                                    .mem_buffer = nullptr,
                                    .no_alloc = true};
 
@@ -131,8 +136,7 @@ void GGMLInfer::setup_input_output_tensors(const std::vector<std::vector<int64_t
     output_names_.push_back("output");
 }
 
-std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-GGMLInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+void GGMLInfer::compute_graph(const std::vector<TensorView>& input_tensors) {
 
     if (!model_loaded_) {
         throw std::runtime_error("Model not loaded");
@@ -144,33 +148,43 @@ GGMLInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tens
                                  std::to_string(input_tensors.size()) + " inputs");
     }
 
-    const std::vector<uint8_t>& input_raw = input_tensors[0];
+    const TensorView& input_raw = input_tensors[0];
 
-    start_timer();
+    // Validate input size against tensor expectation
+    size_t expected_bytes = ggml_nbytes(input_tensor_);
 
-    try {
-        // Validate input size against tensor expectation
-        size_t expected_bytes = ggml_nbytes(input_tensor_);
+    if (input_raw.size_bytes != expected_bytes) {
+        throw std::runtime_error("Input data size mismatch. Expected " + std::to_string(expected_bytes) +
+                                 " bytes (based on tensor type/shape), got " + std::to_string(input_raw.size_bytes));
+    }
 
-        if (input_raw.size() != expected_bytes) {
-            throw std::runtime_error("Input data size mismatch. Expected " + std::to_string(expected_bytes) +
-                                     " bytes (based on tensor type/shape), got " + std::to_string(input_raw.size()));
-        }
+    // Copy data directly to tensor
+    // We assume input_raw contains the correct byte representation for the tensor's type (F32, F16, etc.)
+    std::memcpy(input_tensor_->data, input_raw.data, input_raw.size_bytes);
+
+    // Log for debugging
+    LOG(INFO) << "Copied " << input_raw.size_bytes
+              << " bytes to input tensor (Type: " << ggml_type_name(input_tensor_->type) << ")";
 
-        // Copy data directly to tensor
-        // We assume input_raw contains the correct byte representation for the tensor's type (F32, F16, etc.)
-        std::memcpy(input_tensor_->data, input_raw.data(), input_raw.size());
+    // Execute the graph (if backend is available)
+    if (backend_) {
+        ggml_backend_graph_compute(backend_, graph_);
+    } else {
+        LOG(WARNING) << "No backend available, skipping graph computation";
+    }
+}
 
-        // Log for debugging
-        LOG(INFO) << "Copied " << input_raw.size()
-                  << " bytes to input tensor (Type: " << ggml_type_name(input_tensor_->type) << ")";
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+GGMLInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
 
-        // Execute the graph (if backend is available)
-        if (backend_) {
-            ggml_backend_graph_compute(backend_, graph_);
-        } else {
-            LOG(WARNING) << "No backend available, skipping graph computation";
-        }
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+GGMLInfer::get_infer_results(const std::vector<TensorView>& input_tensors) {
+    start_timer();
+
+    try {
+        compute_graph(input_tensors);
 
         // Get output tensors
         std::vector<std::vector<TensorElement>> outputs;
@@ -178,10 +192,10 @@ GGMLInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tens
 
         // For demonstration, we'll create a simple output
         // In practice, you would iterate through the actual output tensors
-        std::vector<TensorElement> output_data(1000, 0.0f); // Placeholder
+        std::vector<TensorElement> output_data(kPlaceholderOutputElements, 0.0f); // Placeholder
         outputs.push_back(output_data);
 
-        std::vector<int64_t> output_shape = {static_cast<int64_t>(batch_size_), 1000};
+        std::vector<int64_t> output_shape = {static_cast<int64_t>(batch_size_), kPlaceholderOutputElements};
         shapes.push_back(output_shape);
 
         end_timer();
@@ -194,16 +208,38 @@ GGMLInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tens
     }
 }
 
-std::vector<TensorElement> GGMLInfer::tensor_to_vector(struct ggml_tensor* tensor) {
-    std::vector<TensorElement> result;
-    size_t total_elements = ggml_nelements(tensor);
-    result.reserve(total_elements);
+std::vector<RawOutputTensor> GGMLInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> GGMLInfer::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
+    start_timer();
+
+    try {
+        compute_graph(input_tensors);
+
+        // Same placeholder as the variant path, emitted as zeroed float32 bytes.
+        RawOutputTensor raw;
+        raw.dtype = TensorDtype::FP32;
+        raw.bytes = std::vector<uint8_t>(kPlaceholderOutputElements * sizeof(float), 0);
+        raw.shape = {static_cast<int64_t>(batch_size_), kPlaceholderOutputElements};
+
+        std::vector<RawOutputTensor> raw_outputs;
+        raw_outputs.push_back(std::move(raw));
 
-    float* data = static_cast<float*>(tensor->data);
-    for (size_t i = 0; i < total_elements; ++i) {
-        result.push_back(data[i]);
+        end_timer();
+
+        return raw_outputs;
+
+    } catch (const std::exception& e) {
+        end_timer();
+        throw InferenceExecutionException(e.what());
     }
+}
 
+std::vector<TensorElement> GGMLInfer::tensor_to_vector(struct ggml_tensor* tensor) {
+    std::vector<TensorElement> result;
+    tensor_converter().append_elements(result, tensor->data, ggml_nelements(tensor), ElementType::Float32);
     return result;
 }
 
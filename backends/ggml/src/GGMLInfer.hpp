@@ -23,8 +23,17 @@ class GGMLInfer : public InferenceInterface {
 
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& input_tensors) override;
 
   private:
+    // Element count of the placeholder output emitted until real output
+    // tensors are wired up.
+    static constexpr int64_t kPlaceholderOutputElements = 1000;
+
+    void compute_graph(const std::vector<TensorView>& input_tensors);
     void load_model(const std::string& model_path);
     void setup_backend(bool use_gpu);
     void setup_input_output_tensors(const std::vector<std::vector<int64_t>>& input_sizes);
@@ -1,5 +1,7 @@
 #include "TFDetectionAPI.hpp"
 
+#include "ITensorConverter.hpp"
+
 enum class CHW { C = 1, H, W };
 
 TFDetectionAPI::TFDetectionAPI(const std::string& model_path, bool use_gpu, size_t batch_size,
@@ -70,8 +72,7 @@ TFDetectionAPI::TFDetectionAPI(const std::string& model_path, bool use_gpu, size
     state_ = BackendState::Ready;
 }
 
-std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-TFDetectionAPI::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+std::vector<tensorflow::Tensor> TFDetectionAPI::run_session(const std::vector<TensorView>& input_tensors) {
 
     // TensorFlow backend currently supports only single input models
     if (input_tensors.size() != 1) {
@@ -79,7 +80,7 @@ TFDetectionAPI::get_infer_results(const std::vector<std::vector<uint8_t>>& input
                                  std::to_string(input_tensors.size()) + " inputs");
     }
 
-    const std::vector<uint8_t>& input_data = input_tensors[0];
+    const TensorView& input_data = input_tensors[0];
 
     // The input_data is assumed to be in NCHW format (batch, channels, height, width)
     // TensorFlow expects NHWC format (batch, height, width, channels)
@@ -127,17 +128,17 @@ TFDetectionAPI::get_infer_results(const std::vector<std::vector<uint8_t>>& input
 
     switch (input_info_.dtype()) {
     case tensorflow::DataType::DT_FLOAT: {
-        transpose_nchw_to_nhwc(input_tensor.flat<float>().data(), reinterpret_cast<const float*>(input_data.data()));
+        transpose_nchw_to_nhwc(input_tensor.flat<float>().data(), reinterpret_cast<const float*>(input_data.data));
         break;
     }
     case tensorflow::DataType::DT_UINT8: {
         transpose_nchw_to_nhwc(input_tensor.flat<uint8_t>().data(),
-                               reinterpret_cast<const uint8_t*>(input_data.data()));
+                               reinterpret_cast<const uint8_t*>(input_data.data));
         break;
     }
     case tensorflow::DataType::DT_INT32: {
         transpose_nchw_to_nhwc(input_tensor.flat<int32_t>().data(),
-                               reinterpret_cast<const int32_t*>(input_data.data()));
+                               reinterpret_cast<const int32_t*>(input_data.data));
         break;
     }
     default:
@@ -154,6 +155,17 @@ TFDetectionAPI::get_infer_results(const std::vector<std::vector<uint8_t>>& input
         LOG(ERROR) << "Error running session: " << status.ToString();
         throw std::runtime_error("Failed to run TensorFlow session: " + status.ToString());
     }
+    return outputs;
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+TFDetectionAPI::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+TFDetectionAPI::get_infer_results(const std::vector<TensorView>& input_tensors) {
+    std::vector<tensorflow::Tensor> outputs = run_session(input_tensors);
 
     std::vector<std::vector<TensorElement>> convertedOutputs;
     std::vector<std::vector<int64_t>> shapes;
@@ -169,17 +181,14 @@ TFDetectionAPI::get_infer_results(const std::vector<std::vector<uint8_t>>& input
         shapes.push_back(outputShape);
 
         if (tensor.dtype() == tensorflow::DataType::DT_FLOAT) {
-            for (int i = 0; i < tensor.NumElements(); ++i) {
-                outputData.emplace_back(tensor.flat<float>()(i)); // Use emplace_back for variant
-            }
+            tensor_converter().append_elements(outputData, tensor.flat<float>().data(), tensor.NumElements(),
+                                               ElementType::Float32);
         } else if (tensor.dtype() == tensorflow::DataType::DT_INT32) {
-            for (int i = 0; i < tensor.NumElements(); ++i) {
-                outputData.emplace_back(tensor.flat<int32_t>()(i));
-            }
+            tensor_converter().append_elements(outputData, tensor.flat<int32_t>().data(), tensor.NumElements(),
+                                               ElementType::Int32);
         } else if (tensor.dtype() == tensorflow::DataType::DT_INT64) {
-            for (int i = 0; i < tensor.NumElements(); ++i) {
-                outputData.emplace_back(tensor.flat<int64_t>()(i));
-            }
+            tensor_converter().append_elements(outputData, tensor.flat<int64_t>().data(), tensor.NumElements(),
+                                               ElementType::Int64);
         } else {
             throw std::runtime_error("Unsupported output data type encountered.");
         }
@@ -187,4 +196,44 @@ TFDetectionAPI::get_infer_results(const std::vector<std::vector<uint8_t>>& input
         convertedOutputs.push_back(outputData);
     }
     return std::make_tuple(convertedOutputs, shapes);
-}
\ No newline at end of file
+}
+
+std::vector<RawOutputTensor>
+TFDetectionAPI::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> TFDetectionAPI::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
+    std::vector<tensorflow::Tensor> outputs = run_session(input_tensors);
+
+    std::vector<RawOutputTensor> raw_outputs;
+    raw_outputs.reserve(outputs.size());
+    for (tensorflow::Tensor& tensor : outputs) {
+        RawOutputTensor raw;
+        switch (tensor.dtype()) {
+        case tensorflow::DataType::DT_FLOAT:
+            raw.dtype = TensorDtype::FP32;
+            break;
+        case tensorflow::DataType::DT_INT32:
+            raw.dtype = TensorDtype::INT32;
+            break;
+        case tensorflow::DataType::DT_INT64:
+            raw.dtype = TensorDtype::INT64;
+            break;
+        default:
+            throw std::runtime_error("Unsupported output data type encountered.");
+        }
+
+        raw.shape.reserve(tensor.dims());
+        for (int i = 0; i < tensor.dims(); ++i) {
+            raw.shape.push_back(tensor.dim_size(i));
+        }
+
+        // Session::Run returns freshly allocated, reference-counted tensors, so
+        // the buffer keeps the tensor alive instead of copying its bytes.
+        const auto bytes = tensor.tensor_data();
+        raw.bytes = TensorBuffer::adopt(bytes.data(), bytes.size(), std::move(tensor));
+        raw_outputs.push_back(std::move(raw));
+    }
+    return raw_outputs;
+}
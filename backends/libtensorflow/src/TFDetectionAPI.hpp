@@ -17,8 +17,14 @@ class TFDetectionAPI : public InferenceInterface {
 
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& input_tensors) override;
 
   private:
+    std::vector<tensorflow::Tensor> run_session(const std::vector<TensorView>& input_tensors);
+
     tensorflow::SavedModelBundle bundle_;
     tensorflow::TensorInfo input_info_;
     std::string input_name_;
@@ -1,3 +1,4 @@
+#include "RawOutputConformance.hpp"
 #include "TFDetectionAPI.hpp"
 
 #include <filesystem>
@@ -149,6 +150,18 @@ TEST_F(TensorFlowInferTest, IntegrationTest) {
     }
 }
 
+// Raw path must stay byte-identical to the variant path - only runs with real model
+TEST_F(TensorFlowInferTest, RawMatchesVariant) {
+    if (!has_real_model) {
+        GTEST_SKIP() << "Skipping integration test - no real model available";
+    }
+
+    // NCHW: 1 batch × 3 channels × 224 height × 224 width
+    std::vector<uint8_t> input_data(1 * 3 * 224 * 224 * sizeof(float), 0);
+    std::vector<std::vector<uint8_t>> input_tensors = {input_data};
+    EXPECT_TRUE(RawMatchesVariant(*real_infer, input_tensors));
+}
+
 // Unit test - only runs with mock
 TEST_F(TensorFlowInferTest, MockUnitTest) {
     if (has_real_model) {
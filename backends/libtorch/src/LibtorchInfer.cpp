@@ -1,5 +1,7 @@
 #include "LibtorchInfer.hpp"
 
+#include "ITensorConverter.hpp"
+
 #include <sstream>
 
 std::string LibtorchInfer::print_shape(const std::vector<int64_t>& shape) {
@@ -218,6 +220,10 @@ LibtorchInfer::LibtorchInfer(const std::string& model_path, bool use_gpu, size_t
 
 std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
 LibtorchInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+torch::jit::IValue LibtorchInfer::run_forward(const std::vector<TensorView>& input_tensors) {
 
     // Convert input images to torch tensors
     std::vector<torch::jit::IValue> torch_inputs;
@@ -241,21 +247,66 @@ LibtorchInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_
 
         // Validate size
         size_t element_size = c10::elementSize(dtype);
-        if (input_data.size() % element_size != 0) {
+        if (input_data.size_bytes % element_size != 0) {
             throw std::runtime_error("Input buffer size not multiple of element size for input " + std::to_string(i));
         }
 
-        std::vector<int64_t> tensor_dims = shape;
+        // TorchScript traces carry no reliable sizes, so a per-call shape
+        // only has to keep the input's rank and match its byte count.
+        std::vector<int64_t> tensor_dims =
+            input_data.has_shape()
+                ? resolve_input_shape(input_data, i, std::vector<int64_t>(shape.size(), -1), element_size)
+                : shape;
 
         auto options = torch::TensorOptions().dtype(dtype);
-        torch::Tensor input = torch::from_blob(const_cast<uint8_t*>(input_data.data()), tensor_dims, options);
+        torch::Tensor input = torch::from_blob(const_cast<uint8_t*>(input_data.data), tensor_dims, options);
 
         input = input.to(device_);
         torch_inputs.push_back(input);
     }
 
     // Run inference
-    auto output = module_.forward(torch_inputs);
+    return module_.forward(torch_inputs);
+}
+
+// Flattens tensor / tuple / list module outputs into CPU-resident, contiguous
+// tensors; non-tensor tuple or list elements are skipped.
+std::vector<torch::Tensor> LibtorchInfer::output_tensors(const torch::jit::IValue& output) {
+    std::vector<torch::Tensor> tensors;
+    if (output.isTuple()) {
+        // Handle tuple output
+        auto tuple_outputs = output.toTuple()->elements();
+        for (const auto& output_tensor : tuple_outputs) {
+            if (!output_tensor.isTensor()) {
+                continue;
+            }
+            tensors.push_back(output_tensor.toTensor().to(torch::kCPU).contiguous());
+        }
+    } else if (output.isList()) {
+        // Handle list output (new!)
+        auto list_outputs = output.toList();
+        for (size_t i = 0; i < list_outputs.size(); ++i) {
+            auto element = list_outputs.get(i);
+            if (!element.isTensor()) {
+                continue;
+            }
+            tensors.push_back(element.toTensor().to(torch::kCPU).contiguous());
+        }
+    } else if (output.isTensor()) {
+        // Handle single tensor output
+        tensors.push_back(output.toTensor().to(torch::kCPU).contiguous());
+    } else {
+        LOG(ERROR) << "Unsupported output type: neither tensor, tuple, nor list";
+        state_ = BackendState::Failed;
+        throw InferenceExecutionException("LibTorch output is neither tensor, tuple, nor list");
+    }
+    return tensors;
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+LibtorchInfer::get_infer_results(const std::vector<TensorView>& input_tensors) {
+
+    auto output = run_forward(input_tensors);
 
     std::vector<std::vector<TensorElement>> output_vectors;
     std::vector<std::vector<int64_t>> shape_vectors;
@@ -267,20 +318,14 @@ LibtorchInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_
 
         const auto data_type = tensor.scalar_type();
         switch (data_type) {
-        case torch::kFloat32: {
-            const float* output_data = tensor.data_ptr<float>();
-            for (size_t i = 0; i < tensor.numel(); ++i) {
-                tensor_data.emplace_back(output_data[i]);
-            }
+        case torch::kFloat32:
+            tensor_converter().append_elements(tensor_data, tensor.data_ptr<float>(), tensor.numel(),
+                                               ElementType::Float32);
             break;
-        }
-        case torch::kInt64: {
-            const int64_t* output_data = tensor.data_ptr<int64_t>();
-            for (size_t i = 0; i < tensor.numel(); ++i) {
-                tensor_data.emplace_back(output_data[i]);
-            }
+        case torch::kInt64:
+            tensor_converter().append_elements(tensor_data, tensor.data_ptr<int64_t>(), tensor.numel(),
+                                               ElementType::Int64);
             break;
-        }
         default:
             LOG(ERROR) << "Unsupported tensor type: " << data_type;
             state_ = BackendState::Failed;
@@ -290,44 +335,56 @@ LibtorchInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_
         return tensor_data;
     };
 
-    if (output.isTuple()) {
-        // Handle tuple output
-        auto tuple_outputs = output.toTuple()->elements();
-        for (const auto& output_tensor : tuple_outputs) {
-            if (!output_tensor.isTensor()) {
-                continue;
-            }
+    for (const torch::Tensor& tensor : output_tensors(output)) {
+        output_vectors.push_back(process_tensor(tensor));
+        shape_vectors.push_back(tensor.sizes().vec());
+    }
 
-            torch::Tensor tensor = output_tensor.toTensor().to(torch::kCPU).contiguous();
+    return std::make_tuple(output_vectors, shape_vectors);
+}
 
-            output_vectors.push_back(process_tensor(tensor));
-            shape_vectors.push_back(tensor.sizes().vec());
-        }
-    } else if (output.isList()) {
-        // Handle list output (new!)
-        auto list_outputs = output.toList();
-        for (size_t i = 0; i < list_outputs.size(); ++i) {
-            auto element = list_outputs.get(i);
-            if (!element.isTensor()) {
-                continue;
-            }
+std::vector<RawOutputTensor>
+LibtorchInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> LibtorchInfer::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
 
-            torch::Tensor tensor = element.toTensor().to(torch::kCPU).contiguous();
+    auto output = run_forward(input_tensors);
 
-            output_vectors.push_back(process_tensor(tensor));
-            shape_vectors.push_back(tensor.sizes().vec());
+    std::vector<RawOutputTensor> raw_outputs;
+    for (torch::Tensor& tensor : output_tensors(output)) {
+        RawOutputTensor raw;
+        raw.shape = tensor.sizes().vec();
+
+        const auto data_type = tensor.scalar_type();
+        switch (data_type) {
+        case torch::kFloat32:
+            raw.dtype = TensorDtype::FP32;
+            break;
+        case torch::kInt32:
+            raw.dtype = TensorDtype::INT32;
+            break;
+        case torch::kInt64:
+            raw.dtype = TensorDtype::INT64;
+            break;
+        case torch::kUInt8:
+            raw.dtype = TensorDtype::UINT8;
+            break;
+        default:
+            LOG(ERROR) << "Unsupported tensor type: " << data_type;
+            state_ = BackendState::Failed;
+            throw InferenceExecutionException("Unsupported output tensor type for LibTorch: " +
+                                              std::to_string(static_cast<int>(data_type)));
         }
-    } else if (output.isTensor()) {
-        // Handle single tensor output
-        torch::Tensor tensor = output.toTensor().to(torch::kCPU).contiguous();
 
-        output_vectors.push_back(process_tensor(tensor));
-        shape_vectors.push_back(tensor.sizes().vec());
-    } else {
-        LOG(ERROR) << "Unsupported output type: neither tensor, tuple, nor list";
-        state_ = BackendState::Failed;
-        throw InferenceExecutionException("LibTorch output is neither tensor, tuple, nor list");
+        // forward() allocates its outputs, so the buffer holds a reference to
+        // the tensor storage instead of copying it.
+        const void* data = tensor.data_ptr();
+        const size_t size_bytes = tensor.nbytes();
+        raw.bytes = TensorBuffer::adopt(data, size_bytes, std::move(tensor));
+        raw_outputs.push_back(std::move(raw));
     }
 
-    return std::make_tuple(output_vectors, shape_vectors);
-}
\ No newline at end of file
+    return raw_outputs;
+}
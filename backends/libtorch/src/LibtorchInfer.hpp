@@ -11,9 +11,15 @@ class LibtorchInfer : public InferenceInterface {
                   const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>());
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& input_tensors) override;
 
   private:
     std::string print_shape(const std::vector<int64_t>& shape);
+    torch::jit::IValue run_forward(const std::vector<TensorView>& input_tensors);
+    std::vector<torch::Tensor> output_tensors(const torch::jit::IValue& output);
     torch::DeviceType device_;
     torch::jit::script::Module module_;
     std::vector<c10::ScalarType> input_types_;
@@ -1,5 +1,7 @@
 #include "LibtorchInfer.hpp"
 
+#include "RawOutputConformance.hpp"
+
 #include <filesystem>
 #include <fstream>
 #include <glog/logging.h>
@@ -139,6 +141,22 @@ TEST_F(LibtorchInferTest, IntegrationTest) {
     }
 }
 
+// Raw path must stay byte-identical to the variant path - only runs with real model
+TEST_F(LibtorchInferTest, RawMatchesVariant) {
+    if (!has_real_model) {
+        GTEST_SKIP() << "Skipping integration test - no real model available";
+    }
+
+    cv::Mat input = cv::Mat::zeros(224, 224, CV_32FC3);
+    cv::Mat blob;
+    cv::dnn::blobFromImage(input, blob, 1.f / 255.f, cv::Size(224, 224), cv::Scalar(), true, false);
+
+    std::vector<uint8_t> input_data(blob.total() * blob.elemSize());
+    memcpy(input_data.data(), blob.data, input_data.size());
+    std::vector<std::vector<uint8_t>> input_tensors = {input_data};
+    EXPECT_TRUE(RawMatchesVariant(*real_infer, input_tensors));
+}
+
 // Unit test - only runs with mock
 TEST_F(LibtorchInferTest, MockUnitTest) {
     if (has_real_model) {
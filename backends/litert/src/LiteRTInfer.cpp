@@ -1,15 +1,21 @@
 #include "LiteRTInfer.hpp"
 
+#include "ConvertKernels.hpp"
+#include "ITensorConverter.hpp"
+
 #include <cmath>
 #include <cstring>
+#include <filesystem>
 #include <numeric>
 #include <stdexcept>
 #include <tensorflow/lite/builtin_ops.h>
 #include <tensorflow/lite/c/common.h>
+#include <tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h>
 #include <tensorflow/lite/interpreter.h>
 #include <tensorflow/lite/kernels/kernel_util.h>
 #include <tensorflow/lite/kernels/register.h>
 #include <tensorflow/lite/model.h>
+#include <tensorflow/lite/version.h>
 
 namespace {
 
@@ -49,6 +55,22 @@ TensorDataType neuriplo_dtype_from_tflite(TfLiteType type) {
     }
 }
 
+// Element kinds the output paths emit; anything else is rejected at inference.
+TensorDtype raw_dtype_from_tflite(TfLiteType type) {
+    switch (type) {
+    case kTfLiteFloat32:
+        return TensorDtype::FP32;
+    case kTfLiteUInt8:
+        return TensorDtype::UINT8;
+    case kTfLiteInt32:
+        return TensorDtype::INT32;
+    case kTfLiteInt64:
+        return TensorDtype::INT64;
+    default:
+        throw InferenceExecutionException("Unsupported LiteRT output tensor type: " + tensor_type_name(type));
+    }
+}
+
 std::vector<int64_t> shape_from_dims(const TfLiteIntArray* dims) {
     std::vector<int64_t> shape;
     if (dims == nullptr) {
@@ -61,13 +83,6 @@ std::vector<int64_t> shape_from_dims(const TfLiteIntArray* dims) {
     return shape;
 }
 
-template <typename T> void append_tensor_data(std::vector<TensorElement>& output, const T* data, size_t count) {
-    output.reserve(count);
-    for (size_t i = 0; i < count; ++i) {
-        output.emplace_back(data[i]);
-    }
-}
-
 size_t element_count_from_shape(const std::vector<int64_t>& shape) {
     return std::accumulate(shape.begin(), shape.end(), size_t{1}, [](size_t total, int64_t dim) {
         if (dim <= 0) {
@@ -86,10 +101,9 @@ bool is_nhwc_model_input(const TfLiteTensor* tensor) {
     return (c_dim == 1 || c_dim == 3) && h_dim > 3;
 }
 
-void transpose_nchw_to_nhwc(const std::vector<uint8_t>& src, std::vector<uint8_t>& dst, int batch, int channels,
-                            int height, int width) {
-    const auto* src_ptr = reinterpret_cast<const float*>(src.data());
-    auto* dst_ptr = reinterpret_cast<float*>(dst.data());
+void transpose_nchw_to_nhwc(const uint8_t* src, uint8_t* dst, int batch, int channels, int height, int width) {
+    const auto* src_ptr = reinterpret_cast<const float*>(src);
+    auto* dst_ptr = reinterpret_cast<float*>(dst);
 
     for (int b = 0; b < batch; ++b) {
         for (int c = 0; c < channels; ++c) {
@@ -262,27 +276,52 @@ const TfLiteRegistration* Register_SIGN_WITH_INTEGERS() {
 } // namespace
 
 LiteRTInfer::LiteRTInfer(const std::string& model_path, bool use_gpu, size_t batch_size,
-                         const std::vector<std::vector<int64_t>>& input_sizes)
+                         const std::vector<std::vector<int64_t>>& input_sizes, const ArtifactCache& artifact_cache,
+                         const MmapTuning& mmap)
     : InferenceInterface{model_path, use_gpu, batch_size, input_sizes} {
     if (use_gpu) {
         LOG(WARNING) << "LiteRT backend currently uses the CPU interpreter; GPU/delegate selection is not wired";
     }
 
-    model_ = tflite::FlatBufferModel::BuildFromFile(model_path.c_str());
+    const MmapTuning mmap_tuning = mmap.with_env_defaults();
+    if (mmap_tuning.enabled != TuningToggle::Off) {
+        // One mapping for every instance of the model in the process, with
+        // optional prefault/lock; BuildFromFile would map it per instance.
+        mapped_model_ = MappedModel::open(model_path, mmap_tuning);
+        model_ = tflite::FlatBufferModel::BuildFromBuffer(reinterpret_cast<const char*>(mapped_model_->data()),
+                                                          mapped_model_->size());
+    } else {
+        model_ = tflite::FlatBufferModel::BuildFromFile(model_path.c_str());
+    }
     if (!model_) {
         throw ModelLoadException("Unable to load LiteRT flatbuffer: " + model_path);
     }
 
-    tflite::ops::builtin::BuiltinOpResolver resolver;
+    // Packed XNNPACK weights depend only on the model, the runtime build and
+    // the host's vector extensions, not on input shapes.
+    ArtifactKey weight_cache_key;
+    weight_cache_key.backend_id = "litert";
+    weight_cache_key.backend_version = TFLITE_VERSION_STRING;
+    weight_cache_key.model_path = model_path;
+    weight_cache_key.options = std::string("xnnpack;simd=") + simd_level_name(detected_simd_level());
+    weight_cache_key.extension = ".xnnpack_cache";
+    const std::string weight_cache = artifact_cache.artifact_path(weight_cache_key);
+
+    // With a weight cache the XNNPACK delegate is applied explicitly below,
+    // in place of the default one the builtin resolver would apply.
+    std::unique_ptr<tflite::ops::builtin::BuiltinOpResolver> resolver =
+        weight_cache.empty() ? std::make_unique<tflite::ops::builtin::BuiltinOpResolver>()
+                             : std::make_unique<tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates>();
     // onnx2tf lowers ONNX GridSample to this custom op; register our kernel so
     // models that use it (e.g. RT-DETR/D-FINE deformable attention) run on the
     // builtin interpreter.
-    resolver.AddCustom("ONNX_GRIDSAMPLE", Register_ONNX_GRIDSAMPLE());
+    resolver->AddCustom("ONNX_GRIDSAMPLE", Register_ONNX_GRIDSAMPLE());
     // Replace the builtin SIGN kernel with one that also handles integer inputs
     // (the stock kernel is float-only and rejects the INT64 sign math in these
     // models).
-    resolver.AddBuiltin(static_cast<tflite::BuiltinOperator>(kTfLiteBuiltinSign), Register_SIGN_WITH_INTEGERS(), 1, 2);
-    tflite::InterpreterBuilder builder(*model_, resolver);
+    resolver->AddBuiltin(static_cast<tflite::BuiltinOperator>(kTfLiteBuiltinSign), Register_SIGN_WITH_INTEGERS(), 1,
+                         2);
+    tflite::InterpreterBuilder builder(*model_, *resolver);
     if (builder(&interpreter_) != kTfLiteOk || !interpreter_) {
         throw ModelLoadException("Unable to create LiteRT interpreter for: " + model_path);
     }
@@ -295,20 +334,94 @@ LiteRTInfer::LiteRTInfer(const std::string& model_path, bool use_gpu, size_t bat
         }
     }
 
+    // A missing weight cache is built in a staging file, which XNNPACK fills
+    // while it prepares its subgraphs, and published once tensors are
+    // allocated.
+    std::error_code error;
+    const bool weights_cached = !weight_cache.empty() && std::filesystem::exists(weight_cache, error);
+    const std::string cache_file =
+        weight_cache.empty() || weights_cached ? weight_cache : ArtifactCache::staging_path(weight_cache);
+    bool xnnpack_applied = false;
+    if (!cache_file.empty()) {
+        xnnpack_applied = applyXnnpackWeightCache(cache_file);
+        if (!xnnpack_applied) {
+            LOG(WARNING) << "XNNPACK rejected the LiteRT graph; running it on the builtin kernels";
+        }
+    }
+
     if (interpreter_->AllocateTensors() != kTfLiteOk) {
+        if (!weights_cached) {
+            ArtifactCache::discard(cache_file);
+        }
         throw ModelLoadException("Unable to allocate LiteRT tensors for: " + model_path);
     }
 
+    if (xnnpack_applied && weights_cached) {
+        LOG(INFO) << "Loaded XNNPACK packed weights from the artifact cache: " << weight_cache;
+    } else if (xnnpack_applied) {
+        if (ArtifactCache::publish(cache_file, weight_cache)) {
+            LOG(INFO) << "Stored XNNPACK packed weights in the artifact cache: " << weight_cache;
+        }
+    } else if (!cache_file.empty()) {
+        // An unfinished staging file, or a cached file XNNPACK refused.
+        ArtifactCache::discard(cache_file);
+    }
+
     refreshMetadata();
+    for (const auto& input : inference_metadata_.getInputs()) {
+        allocated_shapes_.push_back(input.shape);
+    }
 
     state_ = BackendState::Ready;
 }
 
 LiteRTInfer::~LiteRTInfer() = default;
 
-std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-LiteRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+bool LiteRTInfer::applyXnnpackWeightCache(const std::string& cache_file) {
+    TfLiteXNNPackDelegateOptions options = TfLiteXNNPackDelegateOptionsDefault();
+    options.weight_cache_file_path = cache_file.c_str();
+    xnnpack_delegate_ = {TfLiteXNNPackDelegateCreate(&options), TfLiteXNNPackDelegateDelete};
+    return xnnpack_delegate_ && interpreter_->ModifyGraphWithDelegate(xnnpack_delegate_.get()) == kTfLiteOk;
+}
+
+void LiteRTInfer::resize_inputs(const std::vector<TensorView>& input_tensors) {
+    const auto& metadata = inference_metadata_.getInputs();
+    std::vector<std::vector<int64_t>> shapes;
+    shapes.reserve(input_tensors.size());
+    for (size_t i = 0; i < input_tensors.size(); ++i) {
+        // ResizeInputTensor accepts any extents, so only the rank is fixed.
+        shapes.push_back(input_tensors[i].has_shape()
+                             ? resolve_input_shape(input_tensors[i], i,
+                                                   std::vector<int64_t>(metadata[i].shape.size(), -1),
+                                                   tensor_data_type_size(metadata[i].datatype))
+                             : metadata[i].shape);
+    }
+    if (shapes == allocated_shapes_) {
+        return;
+    }
+
+    const auto& input_indices = interpreter_->inputs();
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (shapes[i] == allocated_shapes_[i]) {
+            continue;
+        }
+        const std::vector<int> dims(shapes[i].begin(), shapes[i].end());
+        if (interpreter_->ResizeInputTensor(input_indices[i], dims) != kTfLiteOk) {
+            throw InferenceExecutionException("Unable to resize LiteRT input tensor at index " + std::to_string(i));
+        }
+    }
+    // Forget the allocation first: a failed AllocateTensors() leaves the
+    // interpreter unusable until the next successful one.
+    allocated_shapes_.assign(shapes.size(), std::vector<int64_t>());
+    if (interpreter_->AllocateTensors() != kTfLiteOk) {
+        throw InferenceExecutionException("Unable to allocate LiteRT tensors for the requested input shapes");
+    }
+    allocated_shapes_ = std::move(shapes);
+}
+
+void LiteRTInfer::bind_inputs_and_invoke(const std::vector<TensorView>& input_tensors) {
     validate_input(input_tensors);
+    resize_inputs(input_tensors);
 
     const auto& input_indices = interpreter_->inputs();
     for (size_t i = 0; i < input_tensors.size(); ++i) {
@@ -317,22 +430,24 @@ LiteRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_te
             throw InferenceExecutionException("LiteRT input tensor is null at index " + std::to_string(i));
         }
 
+        // NCHW -> NHWC keeps the byte count, so both layouts share this check.
+        if (input_tensors[i].size_bytes != input->bytes) {
+            throw InferenceExecutionException("LiteRT input tensor byte size mismatch at index " + std::to_string(i) +
+                                              ": expected " + std::to_string(input->bytes) + ", got " +
+                                              std::to_string(input_tensors[i].size_bytes));
+        }
+
         if (is_nhwc_model_input(input)) {
             const int batch = input->dims->data[0];
             const int height = input->dims->data[1];
             const int width = input->dims->data[2];
             const int channels = input->dims->data[3];
 
-            std::vector<uint8_t> nhwc_buffer(input->bytes);
-            transpose_nchw_to_nhwc(input_tensors[i], nhwc_buffer, batch, channels, height, width);
-            std::memcpy(input->data.raw, nhwc_buffer.data(), input->bytes);
+            // Transpose straight into the interpreter's input tensor.
+            transpose_nchw_to_nhwc(input_tensors[i].data, reinterpret_cast<uint8_t*>(input->data.raw), batch,
+                                   channels, height, width);
         } else {
-            if (input_tensors[i].size() != input->bytes) {
-                throw InferenceExecutionException("LiteRT input tensor byte size mismatch at index " +
-                                                  std::to_string(i) + ": expected " + std::to_string(input->bytes) +
-                                                  ", got " + std::to_string(input_tensors[i].size()));
-            }
-            std::memcpy(input->data.raw, input_tensors[i].data(), input->bytes);
+            std::memcpy(input->data.raw, input_tensors[i].data, input->bytes);
         }
     }
 
@@ -341,6 +456,16 @@ LiteRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_te
         throw InferenceExecutionException("LiteRT interpreter invocation failed");
     }
     end_timer();
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+LiteRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+LiteRTInfer::get_infer_results(const std::vector<TensorView>& input_tensors) {
+    bind_inputs_and_invoke(input_tensors);
 
     std::vector<std::vector<TensorElement>> outputs;
     std::vector<std::vector<int64_t>> shapes;
@@ -360,16 +485,16 @@ LiteRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_te
 
         switch (output->type) {
         case kTfLiteFloat32:
-            append_tensor_data(tensor_data, output->data.f, element_count);
+            tensor_converter().append_elements(tensor_data, output->data.f, element_count, ElementType::Float32);
             break;
         case kTfLiteUInt8:
-            append_tensor_data(tensor_data, output->data.uint8, element_count);
+            tensor_converter().append_elements(tensor_data, output->data.uint8, element_count, ElementType::UInt8);
             break;
         case kTfLiteInt32:
-            append_tensor_data(tensor_data, output->data.i32, element_count);
+            tensor_converter().append_elements(tensor_data, output->data.i32, element_count, ElementType::Int32);
             break;
         case kTfLiteInt64:
-            append_tensor_data(tensor_data, output->data.i64, element_count);
+            tensor_converter().append_elements(tensor_data, output->data.i64, element_count, ElementType::Int64);
             break;
         default:
             throw InferenceExecutionException("Unsupported LiteRT output tensor type: " +
@@ -383,6 +508,58 @@ LiteRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_te
     return std::make_tuple(outputs, shapes);
 }
 
+std::vector<RawOutputTensor>
+LiteRTInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> LiteRTInfer::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
+    bind_inputs_and_invoke(input_tensors);
+
+    const auto& output_indices = interpreter_->outputs();
+    std::vector<RawOutputTensor> raw_outputs;
+    raw_outputs.reserve(output_indices.size());
+
+    // Output tensors live in the interpreter arena and are overwritten by the
+    // next Invoke(), so each one is copied once as bytes.
+    for (int tensor_index : output_indices) {
+        const TfLiteTensor* output = interpreter_->tensor(tensor_index);
+        if (output == nullptr) {
+            throw InferenceExecutionException("LiteRT output tensor is null");
+        }
+
+        RawOutputTensor raw;
+        raw.dtype = raw_dtype_from_tflite(output->type);
+        raw.shape = shape_from_dims(output->dims);
+        const size_t byte_count = element_count_from_shape(raw.shape) * tensor_dtype_size(raw.dtype);
+        const auto* data = static_cast<const uint8_t*>(output->data.raw_const);
+        raw.bytes = TensorBuffer(data, data + byte_count);
+        raw_outputs.push_back(std::move(raw));
+    }
+
+    return raw_outputs;
+}
+
+void LiteRTInfer::infer_into(const std::vector<TensorView>& input_tensors, std::vector<OutputBuffer>& output_buffers) {
+    const auto& output_indices = interpreter_->outputs();
+    check_output_buffer_count(output_buffers, output_indices.size());
+
+    bind_inputs_and_invoke(input_tensors);
+
+    // Output tensors live in the interpreter arena; copy each one once into the
+    // caller's buffer instead of building intermediate vectors.
+    for (size_t i = 0; i < output_indices.size(); ++i) {
+        const TfLiteTensor* output = interpreter_->tensor(output_indices[i]);
+        if (output == nullptr) {
+            throw InferenceExecutionException("LiteRT output tensor is null");
+        }
+
+        const TensorDtype dtype = raw_dtype_from_tflite(output->type);
+        copy_into_output_buffer(output_buffers[i], i, dtype, output->data.raw_const, output->bytes);
+        output_buffers[i].shape.assign(output->dims->data, output->dims->data + output->dims->size);
+    }
+}
+
 std::vector<int> LiteRTInfer::makeInputDims(int tensor_index, const std::vector<int64_t>& requested_shape) const {
     const TfLiteTensor* tensor = interpreter_->tensor(tensor_index);
     if (tensor == nullptr || tensor->dims == nullptr) {
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "ArtifactCache.hpp"
+#include "BackendTuning.hpp"
 #include "InferenceInterface.hpp"
+#include "MappedModel.hpp"
 
 #include <memory>
 #include <string>
@@ -14,16 +17,46 @@
 class LiteRTInfer : public InferenceInterface {
   public:
     LiteRTInfer(const std::string& model_path, bool use_gpu = false, size_t batch_size = 1,
-                const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>());
+                const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>(),
+                const ArtifactCache& artifact_cache = ArtifactCache(), const MmapTuning& mmap = MmapTuning());
     ~LiteRTInfer() override;
 
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& input_tensors) override;
+    void infer_into(const std::vector<TensorView>& input_tensors, std::vector<OutputBuffer>& output_buffers) override;
 
   private:
+    // Flatbuffer mapping shared with other instances of the model; model_
+    // reads it in place, so it is declared first.
+    std::shared_ptr<const MappedModel> mapped_model_;
     std::unique_ptr<tflite::FlatBufferModel> model_;
+    // XNNPACK delegate with a file-backed weight cache, applied instead of
+    // the default delegate when the artifact cache is enabled. Declared
+    // before interpreter_ so it outlives it.
+    std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)> xnnpack_delegate_{nullptr, nullptr};
     std::unique_ptr<tflite::Interpreter> interpreter_;
+    // Input shapes the interpreter's tensors are currently allocated for.
+    std::vector<std::vector<int64_t>> allocated_shapes_;
 
+    // Applies xnnpack_delegate_ with its packed weights in `cache_file`:
+    // read when the file exists, written while the delegate prepares
+    // otherwise. False when XNNPACK rejected the graph.
+    bool applyXnnpackWeightCache(const std::string& cache_file);
+    // Resizes the inputs to this call's shapes, or back to the load-time
+    // ones for views without a shape. Tensors are reallocated only when
+    // these differ from the allocated shapes, so a run of same-shape calls
+    // allocates once. Only the latest allocation is kept: calls alternating
+    // between shapes re-run ResizeInputTensor() and AllocateTensors() (and
+    // XNNPACK's reshape) every time. Keeping one interpreter per shape would
+    // need its own delegate and tensor arena each; callers mixing a few
+    // fixed resolutions should put the backend behind ShapeBucketBackend,
+    // whose per-shape instances share the mapped model.
+    void resize_inputs(const std::vector<TensorView>& input_tensors);
+    void bind_inputs_and_invoke(const std::vector<TensorView>& input_tensors);
     std::vector<int> makeInputDims(int tensor_index, const std::vector<int64_t>& requested_shape) const;
     std::vector<int64_t> tensorShape(int tensor_index) const;
     void refreshMetadata();
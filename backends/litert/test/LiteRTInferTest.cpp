@@ -1,5 +1,7 @@
 #include "LiteRTInfer.hpp"
 
+#include "RawOutputConformance.hpp"
+
 #include <filesystem>
 #include <fstream>
 #include <gtest/gtest.h>
@@ -22,3 +24,26 @@ TEST(LiteRTInferTest, SkipsWhenNoModelIsAvailable) {
     ASSERT_FALSE(metadata.getInputs().empty());
     ASSERT_FALSE(metadata.getOutputs().empty());
 }
+
+TEST(LiteRTInferTest, RawMatchesVariant) {
+    std::ifstream model_path_file("model_path.txt");
+    std::string model_path;
+    if (model_path_file) {
+        std::getline(model_path_file, model_path);
+    }
+
+    if (model_path.empty() || !fs::exists(model_path)) {
+        GTEST_SKIP() << "No LiteRT model available";
+    }
+
+    LiteRTInfer infer(model_path, false);
+    std::vector<std::vector<uint8_t>> input_tensors;
+    for (const auto& input : infer.get_inference_metadata().getInputs()) {
+        size_t elements = 1;
+        for (const int64_t dim : input.shape) {
+            elements *= static_cast<size_t>(dim);
+        }
+        input_tensors.emplace_back(elements * tensor_data_type_size(input.datatype), 0);
+    }
+    EXPECT_TRUE(RawMatchesVariant(infer, input_tensors));
+}
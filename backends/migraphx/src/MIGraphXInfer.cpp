@@ -1,5 +1,7 @@
 #include "MIGraphXInfer.hpp"
 
+#include "ITensorConverter.hpp"
+
 #include <numeric>
 #include <stdexcept>
 
@@ -65,8 +67,7 @@ MIGraphXInfer::MIGraphXInfer(const std::string& model_path, bool use_gpu, size_t
     state_ = BackendState::Ready;
 }
 
-std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-MIGraphXInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+migraphx::arguments MIGraphXInfer::run_program(const std::vector<TensorView>& input_tensors) {
     validate_input(input_tensors);
 
     const auto& inputs = inference_metadata_.getInputs();
@@ -84,7 +85,7 @@ MIGraphXInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_
         migraphx::shape s{migraphx_shape_float_type, lens};
         // argument wraps existing buffer — no copy
         params.add(input_names_[i].c_str(),
-                   migraphx::argument(s, const_cast<void*>(static_cast<const void*>(input_tensors[i].data()))));
+                   migraphx::argument(s, const_cast<void*>(static_cast<const void*>(input_tensors[i].data))));
     }
 
     auto results = program_.eval(params);
@@ -92,6 +93,18 @@ MIGraphXInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_
     end_timer();
     ++total_inferences_;
 
+    return results;
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+MIGraphXInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+MIGraphXInfer::get_infer_results(const std::vector<TensorView>& input_tensors) {
+    auto results = run_program(input_tensors);
+
     std::vector<std::vector<TensorElement>> output_tensors;
     std::vector<std::vector<int64_t>> shapes;
 
@@ -100,12 +113,8 @@ MIGraphXInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_
         std::vector<int64_t> shape(lens.begin(), lens.end());
 
         std::size_t num_elements = res.get_shape().elements();
-        const float* data = reinterpret_cast<const float*>(res.data());
-
         std::vector<TensorElement> tensor_data;
-        tensor_data.reserve(num_elements);
-        for (std::size_t j = 0; j < num_elements; ++j)
-            tensor_data.emplace_back(data[j]);
+        tensor_converter().append_elements(tensor_data, res.data(), num_elements, ElementType::Float32);
 
         output_tensors.push_back(std::move(tensor_data));
         shapes.push_back(std::move(shape));
@@ -113,3 +122,27 @@ MIGraphXInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_
 
     return {std::move(output_tensors), std::move(shapes)};
 }
+
+std::vector<RawOutputTensor>
+MIGraphXInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> MIGraphXInfer::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
+    auto results = run_program(input_tensors);
+
+    std::vector<RawOutputTensor> raw_outputs;
+    for (const auto& res : results) {
+        auto lens = res.get_shape().lengths();
+
+        // Outputs are read as float32, exactly like the variant path.
+        RawOutputTensor raw;
+        raw.dtype = TensorDtype::FP32;
+        raw.shape.assign(lens.begin(), lens.end());
+        const auto* data = reinterpret_cast<const uint8_t*>(res.data());
+        raw.bytes = TensorBuffer(data, data + res.get_shape().elements() * sizeof(float));
+        raw_outputs.push_back(std::move(raw));
+    }
+
+    return raw_outputs;
+}
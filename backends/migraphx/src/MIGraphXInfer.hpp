@@ -12,8 +12,14 @@ class MIGraphXInfer : public InferenceInterface {
 
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& input_tensors) override;
 
   private:
+    migraphx::arguments run_program(const std::vector<TensorView>& input_tensors);
+
     migraphx::program program_;
     bool use_gpu_;
     std::vector<std::string> input_names_;
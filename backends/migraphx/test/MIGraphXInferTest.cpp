@@ -1,5 +1,7 @@
 #include "MIGraphXInfer.hpp"
 
+#include "RawOutputConformance.hpp"
+
 #include <filesystem>
 #include <fstream>
 #include <glog/logging.h>
@@ -104,6 +106,15 @@ TEST_F(MIGraphXInferTest, IntegrationTest) {
     }
 }
 
+// Raw path must stay byte-identical to the variant path - only runs with real model
+TEST_F(MIGraphXInferTest, RawMatchesVariant) {
+    if (!has_real_model)
+        GTEST_SKIP() << "No real model available";
+
+    const auto input_tensors = make_input_tensors();
+    EXPECT_TRUE(RawMatchesVariant(*real_infer, input_tensors));
+}
+
 TEST_F(MIGraphXInferTest, MockUnitTest) {
     if (has_real_model)
         GTEST_SKIP() << "Real model available; mock test skipped";
@@ -1,8 +1,15 @@
 #include "ORTInfer.hpp"
 
+#include "ConvertKernels.hpp"
+#include "ITensorConverter.hpp"
+#include "MappedModel.hpp"
+
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
@@ -204,17 +211,92 @@ void configure_explicit_providers(Ort::SessionOptions& session_options, const st
     }
 }
 
+// Files holding an ONNX model's external tensor data, resolved against the
+// model's directory. Found by scanning for the "location" entries of
+// TensorProto.external_data (key field, then the path as the value field)
+// rather than parsing the protobuf; a stray match in the weights names a file
+// that does not exist, which only skips the artifact cache. Throws
+// InferenceException when the model cannot be read.
+std::vector<std::string> external_data_files(const std::string& model_path) {
+    static const std::string marker("\x0a\x08location\x12", 11);
+    constexpr size_t max_location = 4096;
+    std::ifstream file(model_path, std::ios::binary);
+    if (!file) {
+        throw InferenceException("cannot open model file " + model_path);
+    }
+    std::vector<std::string> locations;
+    std::string window;
+    std::vector<char> chunk(1 << 20);
+    while (file) {
+        file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        window.append(chunk.data(), static_cast<size_t>(file.gcount()));
+        const bool more = static_cast<bool>(file);
+        // Bytes before `keep` are done with; a match cut off by the chunk end
+        // is read again with the next chunk.
+        size_t keep = window.size() < marker.size() ? 0 : window.size() - marker.size() + 1;
+        for (size_t pos = window.find(marker); pos != std::string::npos; pos = window.find(marker, pos + 1)) {
+            size_t cursor = pos + marker.size();
+            uint64_t length = 0;
+            bool complete = false;
+            for (int shift = 0; cursor < window.size() && shift < 14; shift += 7) {
+                const auto byte = static_cast<unsigned char>(window[cursor++]);
+                length |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    complete = true;
+                    break;
+                }
+            }
+            if (complete && length > 0 && length <= max_location && cursor + length <= window.size()) {
+                locations.push_back(window.substr(cursor, length));
+                keep = std::max(keep, cursor + length);
+                pos = cursor + length - 1;
+            } else if (more && window.size() - pos < marker.size() + 2 + max_location) {
+                keep = std::min(keep, pos);
+                break;
+            }
+        }
+        window.erase(0, std::min(keep, window.size()));
+    }
+    if (file.bad()) {
+        throw InferenceException("failed reading model file " + model_path);
+    }
+
+    std::sort(locations.begin(), locations.end());
+    locations.erase(std::unique(locations.begin(), locations.end()), locations.end());
+    const std::filesystem::path directory = std::filesystem::path(model_path).parent_path();
+    std::vector<std::string> files;
+    files.reserve(locations.size());
+    for (const std::string& location : locations) {
+        files.push_back((directory / location).string());
+    }
+    return files;
+}
+
 } // namespace
 
 ORTInfer::ORTInfer(const std::string& model_path, bool use_gpu, size_t batch_size,
-                   const std::vector<std::vector<int64_t>>& input_sizes)
+                   const std::vector<std::vector<int64_t>>& input_sizes, const OrtTuning& tuning,
+                   const ArtifactCache& artifact_cache, const MmapTuning& mmap)
     : InferenceInterface{model_path, use_gpu, batch_size, input_sizes} {
-    env_ = Ort::Env(ORT_LOGGING_LEVEL_WARNING, "Onnx Runtime Inference");
+    OrtTuning session_tuning;
+    MmapTuning mmap_tuning;
+    try {
+        session_tuning = tuning.with_env_defaults();
+        mmap_tuning = mmap.with_env_defaults();
+    } catch (const InferenceException& ex) {
+        state_ = BackendState::Failed;
+        throw ModelLoadException(std::string("ONNX Runtime tuning: ") + ex.what());
+    }
+    runtime_ = OrtRuntimeContext::acquire(session_tuning);
+
     Ort::SessionOptions session_options;
     const char* ep_env = std::getenv("NEURIPLO_ORT_EP");
+    // Providers the session ends up with, for the artifact cache key.
+    std::vector<std::string> providers_in_use{"cpu"};
 
     if (ep_env != nullptr && std::string(ep_env).size() > 0) {
-        configure_explicit_providers(session_options, parseExecutionProviderList(ep_env));
+        providers_in_use = parseExecutionProviderList(ep_env);
+        configure_explicit_providers(session_options, providers_in_use);
     } else if (use_gpu) {
         std::vector<std::string> providers = Ort::GetAvailableProviders();
         LOG(INFO) << "Available providers:";
@@ -229,6 +311,7 @@ ORTInfer::ORTInfer(const std::string& model_path, bool use_gpu, size_t batch_siz
                 LOG(INFO) << "Using CUDA GPU";
                 OrtCUDAProviderOptions cuda_options;
                 session_options.AppendExecutionProvider_CUDA(cuda_options);
+                providers_in_use = {"cuda"};
                 is_found = true;
                 break;
             }
@@ -240,6 +323,7 @@ ORTInfer::ORTInfer(const std::string& model_path, bool use_gpu, size_t batch_siz
                     LOG(WARNING) << "Using deprecated ONNX Runtime ROCm provider for legacy compatibility";
                     OrtROCMProviderOptions rocm_options;
                     session_options.AppendExecutionProvider_ROCM(rocm_options);
+                    providers_in_use = {"rocm"};
                     is_found = true;
                     break;
                 }
@@ -255,12 +339,26 @@ ORTInfer::ORTInfer(const std::string& model_path, bool use_gpu, size_t batch_siz
         session_options = Ort::SessionOptions();
     }
 
+    if (runtime_->join(session_options, session_tuning)) {
+        // Thread counts and spinning then describe the global pools, fixed
+        // when the Env was created.
+        session_tuning.intra_op_threads = 0;
+        session_tuning.inter_op_threads = 0;
+        session_tuning.allow_spinning = TuningToggle::Default;
+    }
+    applySessionTuning(session_options, session_tuning);
+
     try {
-        session_ = Ort::Session(env_, model_path.c_str(), session_options);
+        const std::string artifact =
+            optimizedModelArtifact(artifact_cache, model_path, providers_in_use, session_tuning.graph_optimization);
+        session_ = loadSession(model_path, artifact, session_options, session_tuning, mmap_tuning);
     } catch (const Ort::Exception& ex) {
         LOG(ERROR) << "Failed to load the ONNX model: " << ex.what();
         state_ = BackendState::Failed;
         throw ModelLoadException(std::string("ONNX model load failed: ") + ex.what());
+    } catch (const ModelLoadException&) {
+        state_ = BackendState::Failed;
+        throw;
     }
 
     Ort::AllocatorWithDefaultOptions allocator;
@@ -361,9 +459,110 @@ ORTInfer::ORTInfer(const std::string& model_path, bool use_gpu, size_t batch_siz
         inference_metadata_.addOutput(name, shapes, batch_size, outputTensorDataType(output_type));
     }
 
+    build_binding_plan();
     state_ = BackendState::Ready;
 }
 
+std::string ORTInfer::optimizedModelArtifact(const ArtifactCache& artifact_cache, const std::string& model_path,
+                                             const std::vector<std::string>& providers,
+                                             OrtTuning::GraphOptimization level) {
+    if (!artifact_cache.enabled() || level == OrtTuning::GraphOptimization::Disabled) {
+        return {};
+    }
+    // Compiling providers (TensorRT, OpenVINO, QNN, ...) leave nodes ORT
+    // cannot serialize; they keep their own engine caches.
+    std::string provider_key;
+    for (const auto& provider : providers) {
+        if (provider != "cpu" && provider != "cuda" && provider != "rocm") {
+            return {};
+        }
+        provider_key += provider + ",";
+    }
+
+    ArtifactKey key;
+    key.backend_id = "onnxruntime";
+    key.backend_version = Ort::GetVersionString();
+    key.model_path = model_path;
+    // CPU kernels picked during optimization (e.g. NCHWc layouts) depend on
+    // the host's vector extensions.
+    key.options = "providers=" + provider_key + ";level=" + std::to_string(static_cast<int>(level)) +
+                  ";simd=" + simd_level_name(detected_simd_level());
+    key.extension = ".ort.onnx";
+    // The optimized model embeds the initializers, so retrained external
+    // weights must give it a new key.
+    try {
+        key.data_paths = external_data_files(model_path);
+    } catch (const InferenceException& ex) {
+        LOG(WARNING) << "artifact cache skipped: " << ex.what();
+        return {};
+    }
+    return artifact_cache.artifact_path(key);
+}
+
+Ort::Session ORTInfer::openSession(const std::string& path, const Ort::SessionOptions& session_options,
+                                   const OrtTuning& tuning, const MmapTuning& mmap) {
+    const bool share = tuning.share_prepacked_weights != TuningToggle::Off;
+    if (share) {
+        prepacked_weights_ = runtime_->prepacked_weights(path);
+    } else {
+        prepacked_weights_.reset();
+    }
+    if (mmap.enabled != TuningToggle::On) {
+        return share ? Ort::Session(runtime_->env(), path.c_str(), session_options, *prepacked_weights_)
+                     : Ort::Session(runtime_->env(), path.c_str(), session_options);
+    }
+
+    // ORT copies the graph and initializers out of the bytes, so the mapping
+    // only has to outlive session creation.
+    const std::shared_ptr<const MappedModel> mapped = MappedModel::open(path, mmap);
+    Ort::SessionOptions mapped_options = session_options.Clone();
+    // External data files resolve next to the model, as when loading by path.
+    const std::string model_dir = std::filesystem::path(path).parent_path().string();
+    mapped_options.AddConfigEntry("session.model_external_initializers_file_folder_path", model_dir.c_str());
+    return share ? Ort::Session(runtime_->env(), mapped->data(), mapped->size(), mapped_options, *prepacked_weights_)
+                 : Ort::Session(runtime_->env(), mapped->data(), mapped->size(), mapped_options);
+}
+
+Ort::Session ORTInfer::loadSession(const std::string& model_path, const std::string& artifact,
+                                   const Ort::SessionOptions& session_options, const OrtTuning& tuning,
+                                   const MmapTuning& mmap) {
+    if (artifact.empty()) {
+        return openSession(model_path, session_options, tuning, mmap);
+    }
+
+    std::error_code error;
+    if (std::filesystem::exists(artifact, error)) {
+        // Already optimized: running the optimizers again would only cost
+        // start-up time.
+        Ort::SessionOptions cached_options = session_options.Clone();
+        cached_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_DISABLE_ALL);
+        try {
+            Ort::Session session = openSession(artifact, cached_options, tuning, mmap);
+            LOG(INFO) << "Loaded optimized ONNX model from the artifact cache: " << artifact;
+            return session;
+        } catch (const Ort::Exception& ex) {
+            LOG(WARNING) << "Discarding unusable cached ONNX model " << artifact << ": " << ex.what();
+            ArtifactCache::discard(artifact);
+        }
+    }
+
+    const std::string staging = ArtifactCache::staging_path(artifact);
+    Ort::SessionOptions caching_options = session_options.Clone();
+    caching_options.SetOptimizedModelFilePath(staging.c_str());
+    try {
+        Ort::Session session = openSession(model_path, caching_options, tuning, mmap);
+        if (ArtifactCache::publish(staging, artifact)) {
+            LOG(INFO) << "Stored optimized ONNX model in the artifact cache: " << artifact;
+        }
+        return session;
+    } catch (const Ort::Exception& ex) {
+        // E.g. models with external data ORT will not re-serialize.
+        ArtifactCache::discard(staging);
+        LOG(WARNING) << "Could not store the optimized ONNX model, loading without the artifact cache: " << ex.what();
+    }
+    return openSession(model_path, session_options, tuning, mmap);
+}
+
 std::vector<std::string> ORTInfer::parseExecutionProviderList(const std::string& provider_list) {
     std::vector<std::string> providers;
     std::stringstream stream(provider_list);
@@ -485,6 +684,62 @@ bool ORTInfer::isProviderBuildEnabled(const std::string& provider_alias) {
     return false;
 }
 
+void ORTInfer::applySessionTuning(Ort::SessionOptions& session_options, const OrtTuning& tuning) {
+    if (tuning.intra_op_threads > 0) {
+        session_options.SetIntraOpNumThreads(tuning.intra_op_threads);
+        LOG(INFO) << "ORT intra-op threads: " << tuning.intra_op_threads;
+    }
+    if (tuning.inter_op_threads > 0) {
+        session_options.SetInterOpNumThreads(tuning.inter_op_threads);
+        LOG(INFO) << "ORT inter-op threads: " << tuning.inter_op_threads;
+    }
+
+    switch (tuning.execution_mode) {
+    case OrtTuning::ExecutionMode::Default:
+        break;
+    case OrtTuning::ExecutionMode::Sequential:
+        session_options.SetExecutionMode(ExecutionMode::ORT_SEQUENTIAL);
+        break;
+    case OrtTuning::ExecutionMode::Parallel:
+        session_options.SetExecutionMode(ExecutionMode::ORT_PARALLEL);
+        break;
+    }
+
+    switch (tuning.graph_optimization) {
+    case OrtTuning::GraphOptimization::Default:
+        break;
+    case OrtTuning::GraphOptimization::Disabled:
+        session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_DISABLE_ALL);
+        break;
+    case OrtTuning::GraphOptimization::Basic:
+        session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_BASIC);
+        break;
+    case OrtTuning::GraphOptimization::Extended:
+        session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+        break;
+    case OrtTuning::GraphOptimization::All:
+        session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+        break;
+    }
+
+    if (tuning.allow_spinning != TuningToggle::Default) {
+        const char* spin = tuning.allow_spinning == TuningToggle::On ? "1" : "0";
+        session_options.AddConfigEntry("session.intra_op.allow_spinning", spin);
+        session_options.AddConfigEntry("session.inter_op.allow_spinning", spin);
+        LOG(INFO) << "ORT thread spinning: " << spin;
+    }
+    if (tuning.cpu_mem_arena == TuningToggle::On) {
+        session_options.EnableCpuMemArena();
+    } else if (tuning.cpu_mem_arena == TuningToggle::Off) {
+        session_options.DisableCpuMemArena();
+    }
+    if (tuning.mem_pattern == TuningToggle::On) {
+        session_options.EnableMemPattern();
+    } else if (tuning.mem_pattern == TuningToggle::Off) {
+        session_options.DisableMemPattern();
+    }
+}
+
 std::string ORTInfer::getDataTypeString(ONNXTensorElementDataType type) {
     switch (type) {
     case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
@@ -534,6 +789,22 @@ TensorDataType ORTInfer::outputTensorDataType(ONNXTensorElementDataType type) {
     }
 }
 
+TensorDtype ORTInfer::outputTensorDtype(ONNXTensorElementDataType type) {
+    switch (type) {
+    case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+        return TensorDtype::FP32;
+    case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+        return TensorDtype::INT32;
+    case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+        return TensorDtype::INT64;
+    case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+        return TensorDtype::UINT8;
+    default:
+        throw InferenceExecutionException("Unsupported output tensor type for ORT: " +
+                                          std::to_string(static_cast<int>(type)));
+    }
+}
+
 std::string ORTInfer::print_shape(const std::vector<std::int64_t>& v) {
     std::stringstream ss("");
     for (std::size_t i = 0; i < v.size() - 1; i++)
@@ -553,128 +824,251 @@ size_t ORTInfer::getSizeByDim(const std::vector<int64_t>& dims) {
     return size;
 }
 
-std::vector<Ort::Value> ORTInfer::run_session(const std::vector<std::vector<uint8_t>>& input_tensors) {
-
+void ORTInfer::build_binding_plan() {
     const auto& inputs = inference_metadata_.getInputs();
     const auto& outputs = inference_metadata_.getOutputs();
+    plan_.memory_info = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        InputPlan input;
+        input.name = inputs[i].name;
+        input.type = session_.GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetElementType();
+        input.shape = inputs[i].shape;
+        input.model_shape = session_.GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+        input.element_size = tensor_data_type_size(inputs[i].datatype);
+        size_t elements = 1;
+        for (int64_t dim : input.shape) {
+            elements *= static_cast<size_t>(dim < 0 ? 1 : dim);
+        }
+        input.byte_size = elements * input.element_size;
+        plan_.inputs.push_back(std::move(input));
+    }
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        OutputPlan output;
+        output.name = outputs[i].name;
+        output.type = session_.GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetElementType();
+        output.dtype = outputTensorDtype(output.type);
+        output.shape = outputs[i].shape;
+        // Classified by the shape the model declares: the metadata shape has
+        // its dynamic leading dim replaced by the batch size, which does not
+        // hold for data-dependent outputs such as detections ([-1, 7]).
+        const std::vector<int64_t> declared = session_.GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+        const bool is_static = std::none_of(declared.begin(), declared.end(), [](int64_t dim) { return dim < 0; });
+        output.byte_size = is_static ? output_byte_size(outputs[i]) : 0;
+        plan_.outputs.push_back(std::move(output));
+    }
+
+    // Name pointers are taken once the vectors stop growing.
+    for (const InputPlan& input : plan_.inputs) {
+        plan_.input_names.push_back(input.name.c_str());
+    }
+    Ort::AllocatorWithDefaultOptions allocator;
+    binding_ = Ort::IoBinding(session_);
+    caller_binding_ = Ort::IoBinding(session_);
+    caller_outputs_.assign(plan_.outputs.size(), BoundBuffer{});
+    for (OutputPlan& output : plan_.outputs) {
+        plan_.output_names.push_back(output.name.c_str());
+        if (output.byte_size == 0) {
+            // Bound to the device before every run, see run_session().
+            plan_.has_dynamic_outputs = true;
+            continue;
+        }
+        output.persistent = std::make_shared<Ort::Value>(
+            Ort::Value::CreateTensor(allocator, output.shape.data(), output.shape.size(), output.type));
+        binding_.BindOutput(output.name.c_str(), *output.persistent);
+    }
+}
 
-    // Create Ort tensors from input data
-    // We assume input_tensors[i] already contains the data in the correct layout (e.g. float/int bytes)
-    // Warning: We are casting raw bytes to float* if the model expects float.
-    // This assumes the input `vector<uint8_t>` is actually a byte view of the float buffer.
+void ORTInfer::check_input_count(const std::vector<TensorView>& input_tensors) const {
+    if (input_tensors.size() != plan_.inputs.size()) {
+        throw std::runtime_error("Input tensor count mismatch. Expected " + std::to_string(plan_.inputs.size()) +
+                                 ", got " + std::to_string(input_tensors.size()));
+    }
+}
 
-    std::vector<Ort::Value> in_ort_tensors;
-    Ort::MemoryInfo memory_info =
-        Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-    std::vector<int64_t> orig_target_sizes;
+Ort::Value ORTInfer::make_input_value(const TensorView& view, size_t index) {
+    const InputPlan& input = plan_.inputs[index];
+    if (view.has_shape()) {
+        const std::vector<int64_t> shape = resolve_input_shape(view, index, input.model_shape, input.element_size);
+        return Ort::Value::CreateTensor(plan_.memory_info, const_cast<uint8_t*>(view.data), view.size_bytes,
+                                        shape.data(), shape.size(), input.type);
+    }
+    if (view.size_bytes != input.byte_size) {
+        throw std::runtime_error("Input data size mismatch for tensor " + std::to_string(index) + ". Expected " +
+                                 std::to_string(input.byte_size) + " bytes, got " + std::to_string(view.size_bytes));
+    }
+    // Wraps the caller's bytes without copying; ORT only reads inputs, so
+    // casting away const is safe.
+    return Ort::Value::CreateTensor(plan_.memory_info, const_cast<uint8_t*>(view.data), input.byte_size,
+                                    input.shape.data(), input.shape.size(), input.type);
+}
 
-    // Process user-provided input tensors
-    size_t num_inputs = session_.GetInputCount();
-    if (input_tensors.size() != num_inputs) {
-        throw std::runtime_error("Input tensor count mismatch. Expected " + std::to_string(num_inputs) + ", got " +
-                                 std::to_string(input_tensors.size()));
+std::vector<Ort::Value> ORTInfer::make_input_values(const std::vector<TensorView>& input_tensors) {
+    check_input_count(input_tensors);
+    std::vector<Ort::Value> in_ort_tensors;
+    in_ort_tensors.reserve(plan_.inputs.size());
+    for (size_t i = 0; i < plan_.inputs.size(); ++i) {
+        in_ort_tensors.push_back(make_input_value(input_tensors[i], i));
     }
+    return in_ort_tensors;
+}
 
-    for (size_t i = 0; i < num_inputs; ++i) {
-        auto type_info = session_.GetInputTypeInfo(i);
-        auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
-        auto onnx_type = tensor_info.GetElementType();
-        const auto& input_shape = inputs[i].shape; // Use our stored shape which handles dynamic/overrides
-
-        // Calculate expected size for validation
-        size_t element_size = 1;
-        switch (onnx_type) {
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
-            element_size = 4;
-            break;
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
-            element_size = 1;
-            break;
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
-            element_size = 8;
-            break;
-        default:
-            LOG(ERROR) << "Unsupported input data type: " << onnx_type;
-            throw std::runtime_error("Unsupported input data type");
+bool ORTInfer::uses_plan_shapes(const std::vector<TensorView>& input_tensors) const {
+    for (size_t i = 0; i < input_tensors.size() && i < plan_.inputs.size(); ++i) {
+        const TensorView& view = input_tensors[i];
+        const std::vector<int64_t>& shape = plan_.inputs[i].shape;
+        if (view.has_shape() && !std::equal(view.shape, view.shape + view.ndim, shape.begin(), shape.end())) {
+            return false;
         }
+    }
+    return true;
+}
 
-        size_t expected_elements = 1;
-        for (int64_t dim : input_shape) {
-            if (dim < 0) {
-                LOG(WARNING) << "Input shape contains dynamic dimension: " << dim
-                             << ". Validation might be inaccurate.";
-            }
-            expected_elements *= (dim < 0 ? 1 : dim);
+std::vector<std::shared_ptr<Ort::Value>> ORTInfer::run_session(const std::vector<TensorView>& input_tensors) {
+    std::vector<Ort::Value> in_ort_tensors = make_input_values(input_tensors);
+
+    // Output shapes follow this call's input shapes, so the persistent
+    // tensors sized for the plan cannot be bound.
+    if (!uses_plan_shapes(input_tensors)) {
+        std::vector<Ort::Value> allocated =
+            session_.Run(Ort::RunOptions{nullptr}, plan_.input_names.data(), in_ort_tensors.data(),
+                         in_ort_tensors.size(), plan_.output_names.data(), plan_.output_names.size());
+        std::vector<std::shared_ptr<Ort::Value>> results;
+        results.reserve(allocated.size());
+        for (Ort::Value& output : allocated) {
+            results.push_back(std::make_shared<Ort::Value>(std::move(output)));
         }
+        return results;
+    }
 
-        size_t expected_bytes = expected_elements * element_size;
-        if (input_tensors[i].size() != expected_bytes) {
-            throw std::runtime_error("Input data size mismatch for tensor " + std::to_string(i) + ". Expected " +
-                                     std::to_string(expected_bytes) + " bytes, got " +
-                                     std::to_string(input_tensors[i].size()));
-        }
+    for (size_t i = 0; i < in_ort_tensors.size(); ++i) {
+        binding_.BindInput(plan_.input_names[i], in_ort_tensors[i]);
+    }
 
-        // Create tensor from raw bytes using the correct type
-        // We cast away constness as Ort::Value::CreateTensor expects mutable pointer
-        switch (onnx_type) {
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
-            in_ort_tensors.emplace_back(Ort::Value::CreateTensor<float>(
-                memory_info, reinterpret_cast<float*>(const_cast<uint8_t*>(input_tensors[i].data())), expected_elements,
-                input_shape.data(), input_shape.size()));
-            break;
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
-            in_ort_tensors.emplace_back(
-                Ort::Value::CreateTensor<uint8_t>(memory_info, const_cast<uint8_t*>(input_tensors[i].data()),
-                                                  expected_elements, input_shape.data(), input_shape.size()));
-            break;
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
-            in_ort_tensors.emplace_back(Ort::Value::CreateTensor<int8_t>(
-                memory_info, reinterpret_cast<int8_t*>(const_cast<uint8_t*>(input_tensors[i].data())),
-                expected_elements, input_shape.data(), input_shape.size()));
-            break;
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
-            in_ort_tensors.emplace_back(Ort::Value::CreateTensor<int32_t>(
-                memory_info, reinterpret_cast<int32_t*>(const_cast<uint8_t*>(input_tensors[i].data())),
-                expected_elements, input_shape.data(), input_shape.size()));
-            break;
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
-            in_ort_tensors.emplace_back(Ort::Value::CreateTensor<int64_t>(
-                memory_info, reinterpret_cast<int64_t*>(const_cast<uint8_t*>(input_tensors[i].data())),
-                expected_elements, input_shape.data(), input_shape.size()));
-            break;
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
-            in_ort_tensors.emplace_back(Ort::Value::CreateTensor<bool>(
-                memory_info, reinterpret_cast<bool*>(const_cast<uint8_t*>(input_tensors[i].data())), expected_elements,
-                input_shape.data(), input_shape.size()));
-            break;
-        default:
-            LOG(ERROR) << "Unsupported input data type for ORT: " << onnx_type;
-            state_ = BackendState::Failed;
-            throw InferenceExecutionException("Unsupported input data type for ORT: " +
-                                              std::to_string(static_cast<int>(onnx_type)));
+    for (OutputPlan& output : plan_.outputs) {
+        // After a run the binding holds the tensor ORT allocated for a
+        // dynamic output and would reuse it as a preallocated fetch, which
+        // breaks once a data-dependent dim changes. Bind the device again so
+        // ORT allocates to this call's shape.
+        if (!output.persistent) {
+            binding_.BindOutput(output.name.c_str(), plan_.memory_info);
+            continue;
+        }
+        // A raw result from an earlier call may still hold a persistent
+        // output; bind a fresh tensor for this call instead of overwriting it.
+        if (output.persistent.use_count() > 1) {
+            Ort::AllocatorWithDefaultOptions allocator;
+            output.persistent = std::make_shared<Ort::Value>(
+                Ort::Value::CreateTensor(allocator, output.shape.data(), output.shape.size(), output.type));
+            binding_.BindOutput(output.name.c_str(), *output.persistent);
         }
     }
+    // Orders the last holder's reads (released with its reference) before
+    // ORT writes into the reused tensors.
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    session_.Run(Ort::RunOptions{nullptr}, binding_);
+    // Do not keep referring to the caller's input buffers between calls.
+    binding_.ClearBoundInputs();
+
+    std::vector<Ort::Value> allocated;
+    if (plan_.has_dynamic_outputs) {
+        allocated = binding_.GetOutputValues();
+    }
+    std::vector<std::shared_ptr<Ort::Value>> results;
+    results.reserve(plan_.outputs.size());
+    for (size_t i = 0; i < plan_.outputs.size(); ++i) {
+        if (plan_.outputs[i].persistent) {
+            results.push_back(plan_.outputs[i].persistent);
+        } else {
+            results.push_back(std::make_shared<Ort::Value>(std::move(allocated[i])));
+        }
+    }
+    return results;
+}
 
-    // Run inference
-    std::vector<const char*> input_names_char(inputs.size());
-    std::transform(inputs.begin(), inputs.end(), input_names_char.begin(),
-                   [](const LayerInfo& layer) { return layer.name.c_str(); });
+#if ORT_API_VERSION >= 16
+// One RunAsync() call in flight. ORT reads the inputs and fills `outputs`
+// until the completion callback, so everything it points at lives here.
+struct ORTInfer::AsyncRun {
+    // Const: the completion runs on ORT's threads and only reads the backend.
+    const ORTInfer* backend;
+    std::shared_ptr<const AsyncInputs> inputs;
+    InferenceCallback done;
+    std::vector<Ort::Value> input_values;
+    std::vector<Ort::Value> outputs;
+};
+
+void ORTInfer::on_run_async_done(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status) {
+    (void)outputs;
+    (void)num_outputs;
+    std::unique_ptr<AsyncRun> run(static_cast<AsyncRun*>(user_data));
+    Ort::Status run_status(status);
+    if (!run_status.IsOK()) {
+        run->done(std::make_exception_ptr(InferenceExecutionException(run_status.GetErrorMessage())), {});
+        return;
+    }
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>> results;
+    try {
+        results = run->backend->variant_outputs(run->outputs);
+    } catch (...) {
+        run->done(std::current_exception(), {});
+        return;
+    }
+    run->done(nullptr, std::move(results));
+}
+#endif
 
-    std::vector<const char*> output_names_char(outputs.size());
-    std::transform(outputs.begin(), outputs.end(), output_names_char.begin(),
-                   [](const LayerInfo& layer) { return layer.name.c_str(); });
+// Session::Run is thread-safe, so RunAsync calls are not serialized: they
+// complete on ORT's intra-op threads, possibly out of order. Sessions that
+// cannot run asynchronously (no intra-op thread pool, ORT < 1.16) use the
+// default thread-pool path.
+void ORTInfer::start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) {
+#if ORT_API_VERSION >= 16
+    auto run = std::make_unique<AsyncRun>();
+    run->backend = this;
+    try {
+        run->input_values = make_input_values(inputs->views());
+    } catch (...) {
+        done(std::current_exception(), {});
+        return;
+    }
+    run->outputs.resize(plan_.output_names.size());
+    run->inputs = inputs;
+    run->done = done;
 
-    return session_.Run(Ort::RunOptions{nullptr}, input_names_char.data(), in_ort_tensors.data(), in_ort_tensors.size(),
-                        output_names_char.data(), outputs.size());
+    try {
+        // The outputs are allocated by ORT per run: concurrent runs cannot
+        // share binding_ or its persistent tensors.
+        session_.RunAsync(Ort::RunOptions{nullptr}, plan_.input_names.data(), run->input_values.data(),
+                          run->input_values.size(), plan_.output_names.data(), run->outputs.data(),
+                          run->outputs.size(), &ORTInfer::on_run_async_done, run.get());
+        run.release(); // owned by the callback from here on
+        return;
+    } catch (const Ort::Exception& e) {
+        LOG(WARNING) << "ONNX Runtime RunAsync unavailable, using the thread-pool path: " << e.what();
+    }
+#endif
+    InferenceInterface::start_async(std::move(inputs), std::move(done));
 }
 
 std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
 ORTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+ORTInfer::get_infer_results(const std::vector<TensorView>& input_tensors) {
+    std::vector<std::vector<TensorElement>> output_tensors;
+    std::vector<std::vector<int64_t>> shapes;
+    for (const std::shared_ptr<Ort::Value>& output_tensor : run_session(input_tensors)) {
+        append_variant_output(*output_tensor, output_tensors, shapes);
+    }
+    return std::make_tuple(output_tensors, shapes);
+}
 
-    std::vector<Ort::Value> output_ort_tensors = run_session(input_tensors);
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+ORTInfer::variant_outputs(const std::vector<Ort::Value>& output_ort_tensors) const {
 
     std::vector<std::vector<TensorElement>> output_tensors;
     std::vector<std::vector<int64_t>> shapes;
@@ -683,94 +1077,135 @@ ORTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tenso
     assert(output_ort_tensors.size() == inference_metadata_.getOutputs().size());
 
     for (const Ort::Value& output_tensor : output_ort_tensors) {
-        const auto& shape_ref = output_tensor.GetTensorTypeAndShapeInfo().GetShape();
-        std::vector<int64_t> shape(shape_ref.begin(), shape_ref.end());
+        append_variant_output(output_tensor, output_tensors, shapes);
+    }
 
-        size_t num_elements = 1;
-        for (int64_t dim : shape) {
-            num_elements *= dim;
-        }
+    return std::make_tuple(output_tensors, shapes);
+}
 
-        std::vector<TensorElement> tensor_data;
-        tensor_data.reserve(num_elements);
+void ORTInfer::append_variant_output(const Ort::Value& output_tensor,
+                                     std::vector<std::vector<TensorElement>>& output_tensors,
+                                     std::vector<std::vector<int64_t>>& shapes) const {
+    const auto& shape_ref = output_tensor.GetTensorTypeAndShapeInfo().GetShape();
+    std::vector<int64_t> shape(shape_ref.begin(), shape_ref.end());
 
-        // Retrieve tensor data
-        const int onnx_type = output_tensor.GetTensorTypeAndShapeInfo().GetElementType();
-        switch (onnx_type) {
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT: {
-            const float* output_data_float = output_tensor.GetTensorData<float>();
-            for (size_t i = 0; i < num_elements; ++i) {
-                tensor_data.emplace_back(output_data_float[i]);
-            }
-            break;
-        }
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64: {
-            const int64_t* output_data_int64 = output_tensor.GetTensorData<int64_t>();
-            for (size_t i = 0; i < num_elements; ++i) {
-                tensor_data.emplace_back(output_data_int64[i]);
-            }
-            break;
-        }
-        default:
-            LOG(ERROR) << "Unsupported tensor type: " << onnx_type;
-            state_ = BackendState::Failed;
-            throw InferenceExecutionException("Unsupported output tensor type for ORT: " + std::to_string(onnx_type));
-        }
+    size_t num_elements = 1;
+    for (int64_t dim : shape) {
+        num_elements *= dim;
+    }
+
+    std::vector<TensorElement> tensor_data;
+    tensor_data.reserve(num_elements);
 
-        output_tensors.emplace_back(std::move(tensor_data));
-        shapes.emplace_back(shape);
+    // Retrieve tensor data
+    const int onnx_type = output_tensor.GetTensorTypeAndShapeInfo().GetElementType();
+    switch (onnx_type) {
+    case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+        tensor_converter().append_elements(tensor_data, output_tensor.GetTensorData<float>(), num_elements,
+                                           ElementType::Float32);
+        break;
+    case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+        tensor_converter().append_elements(tensor_data, output_tensor.GetTensorData<int64_t>(), num_elements,
+                                           ElementType::Int64);
+        break;
+    default:
+        // Only reported to the caller: this also runs on ORT's threads when
+        // RunAsync completes, where the backend's state must not be touched.
+        LOG(ERROR) << "Unsupported tensor type: " << onnx_type;
+        throw InferenceExecutionException("Unsupported output tensor type for ORT: " + std::to_string(onnx_type));
     }
 
-    return std::make_tuple(output_tensors, shapes);
+    output_tensors.emplace_back(std::move(tensor_data));
+    shapes.emplace_back(std::move(shape));
 }
 
 std::vector<RawOutputTensor> ORTInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
 
-    std::vector<Ort::Value> output_ort_tensors = run_session(input_tensors);
+std::vector<RawOutputTensor> ORTInfer::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
+
+    std::vector<std::shared_ptr<Ort::Value>> output_ort_tensors = run_session(input_tensors);
 
     std::vector<RawOutputTensor> raw_outputs;
     raw_outputs.reserve(output_ort_tensors.size());
 
-    for (const Ort::Value& output_tensor : output_ort_tensors) {
-        const auto& shape_ref = output_tensor.GetTensorTypeAndShapeInfo().GetShape();
+    for (size_t i = 0; i < output_ort_tensors.size(); ++i) {
+        const OutputPlan& output = plan_.outputs[i];
+        std::shared_ptr<Ort::Value>& output_tensor = output_ort_tensors[i];
 
-        size_t num_elements = 1;
-        for (int64_t dim : shape_ref) {
-            num_elements *= dim;
+        RawOutputTensor raw;
+        raw.dtype = output.dtype;
+        if (output.persistent && output_tensor == output.persistent) {
+            raw.shape = output.shape;
+        } else {
+            const auto& shape_ref = output_tensor->GetTensorTypeAndShapeInfo().GetShape();
+            raw.shape.assign(shape_ref.begin(), shape_ref.end());
         }
 
-        RawOutputTensor raw;
-        raw.shape.assign(shape_ref.begin(), shape_ref.end());
-
-        // Copy the typed output buffer once, as bytes; no per-element boxing.
-        auto copy_bytes = [&](const void* data, size_t element_size, TensorDtype dtype) {
-            raw.dtype = dtype;
-            const auto* bytes = static_cast<const uint8_t*>(data);
-            raw.bytes.assign(bytes, bytes + num_elements * element_size);
-        };
-
-        const int onnx_type = output_tensor.GetTensorTypeAndShapeInfo().GetElementType();
-        switch (onnx_type) {
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
-            copy_bytes(output_tensor.GetTensorData<float>(), sizeof(float), TensorDtype::FP32);
-            break;
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
-            copy_bytes(output_tensor.GetTensorData<int32_t>(), sizeof(int32_t), TensorDtype::INT32);
-            break;
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
-            copy_bytes(output_tensor.GetTensorData<int64_t>(), sizeof(int64_t), TensorDtype::INT64);
-            break;
-        case ONNXTensorElementDataType::ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
-            copy_bytes(output_tensor.GetTensorData<uint8_t>(), sizeof(uint8_t), TensorDtype::UINT8);
-            break;
-        default:
-            LOG(ERROR) << "Unsupported tensor type: " << onnx_type;
-            state_ = BackendState::Failed;
-            throw InferenceExecutionException("Unsupported output tensor type for ORT: " + std::to_string(onnx_type));
+        size_t num_elements = 1;
+        for (int64_t dim : raw.shape) {
+            num_elements *= dim;
         }
 
+        // The buffer shares the Ort::Value instead of copying its bytes. A
+        // persistent output stays untouched while the buffer holds it: the
+        // next run binds a fresh tensor in its place.
+        const uint8_t* data = output_tensor->GetTensorData<uint8_t>();
+        raw.bytes =
+            TensorBuffer::adopt(data, num_elements * tensor_dtype_size(output.dtype), std::move(output_tensor));
         raw_outputs.push_back(std::move(raw));
     }
 
     return raw_outputs;
 }
+
+void ORTInfer::infer_into(const std::vector<TensorView>& input_tensors, std::vector<OutputBuffer>& output_buffers) {
+    check_output_buffer_count(output_buffers, plan_.outputs.size());
+
+    // IoBinding needs every output shape up front; models with dynamic output
+    // dims and calls with their own input shapes take the copying path.
+    if (plan_.has_dynamic_outputs || !uses_plan_shapes(input_tensors)) {
+        InferenceInterface::infer_into(input_tensors, output_buffers);
+        return;
+    }
+
+    check_input_count(input_tensors);
+
+    // Tensors wrap the caller's buffers, so ORT reads inputs and writes
+    // results in place. Inputs are bound on every call: binding copies them
+    // to the device on GPU providers, so a refilled buffer must be bound
+    // again. Outputs stay bound until the caller passes another buffer.
+    for (size_t i = 0; i < plan_.inputs.size(); ++i) {
+        caller_binding_.BindInput(plan_.input_names[i], make_input_value(input_tensors[i], i));
+    }
+    for (size_t i = 0; i < plan_.outputs.size(); ++i) {
+        const OutputPlan& output = plan_.outputs[i];
+        OutputBuffer& buffer = output_buffers[i];
+        if (buffer.data == nullptr || buffer.capacity_bytes < output.byte_size) {
+            throw InferenceExecutionException("Output buffer at index " + std::to_string(i) + " holds " +
+                                              std::to_string(buffer.capacity_bytes) + " bytes, output needs " +
+                                              std::to_string(output.byte_size));
+        }
+
+        BoundBuffer& bound = caller_outputs_[i];
+        if (bound.data != buffer.data || bound.bytes != buffer.capacity_bytes) {
+            caller_binding_.BindOutput(plan_.output_names[i],
+                                       Ort::Value::CreateTensor(plan_.memory_info, buffer.data, output.byte_size,
+                                                                output.shape.data(), output.shape.size(), output.type));
+            bound = BoundBuffer{buffer.data, buffer.capacity_bytes};
+        }
+        buffer.dtype = output.dtype;
+        buffer.size_bytes = output.byte_size;
+        buffer.shape.assign(output.shape.begin(), output.shape.end());
+    }
+
+    try {
+        session_.Run(Ort::RunOptions{nullptr}, caller_binding_);
+    } catch (...) {
+        caller_binding_.ClearBoundInputs();
+        throw;
+    }
+    // Do not keep referring to the caller's input buffers between calls.
+    caller_binding_.ClearBoundInputs();
+}
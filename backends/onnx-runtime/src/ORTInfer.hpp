@@ -1,9 +1,13 @@
 #pragma once
+#include "ArtifactCache.hpp"
+#include "BackendTuning.hpp"
 #include "InferenceInterface.hpp"
+#include "OrtRuntimeContext.hpp"
 
 #include <glog/logging.h>
 #include <onnxruntime_c_api.h>   // for CUDA execution provider (if using CUDA)
 #include <onnxruntime_cxx_api.h> // for ONNX Runtime C++ API
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -12,19 +16,114 @@ class ORTInfer : public InferenceInterface {
   public:
     std::string print_shape(const std::vector<std::int64_t>& v);
     ORTInfer(const std::string& model_path, bool use_gpu = false, size_t batch_size = 1,
-             const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>());
+             const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>(),
+             const OrtTuning& tuning = OrtTuning(), const ArtifactCache& artifact_cache = ArtifactCache(),
+             const MmapTuning& mmap = MmapTuning());
     size_t getSizeByDim(const std::vector<int64_t>& dims);
     static std::vector<std::string> parseExecutionProviderList(const std::string& provider_list);
     static std::string providerAliasToOrtName(const std::string& provider_alias);
     static bool isProviderBuildEnabled(const std::string& provider_alias);
+    // Applies the set fields of `tuning` (already merged with the environment)
+    // to the session options; unset fields leave ORT's defaults.
+    static void applySessionTuning(Ort::SessionOptions& session_options, const OrtTuning& tuning);
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& input_tensors) override;
     std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& input_tensors) override;
+    void infer_into(const std::vector<TensorView>& input_tensors, std::vector<OutputBuffer>& output_buffers) override;
+
+  protected:
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override;
 
   private:
-    Ort::Env env_;
+#if ORT_API_VERSION >= 16
+    struct AsyncRun;
+    static void ORT_API_CALL on_run_async_done(void* user_data, OrtValue** outputs, size_t num_outputs,
+                                               OrtStatusPtr status);
+#endif
+
+    // Everything run_session() needs about the session's inputs and outputs,
+    // looked up once after loading instead of on every call.
+    struct InputPlan {
+        std::string name;
+        ONNXTensorElementDataType type;
+        // Shape of calls that pass none: dynamic dims resolved from input_sizes.
+        std::vector<int64_t> shape;
+        // Shape the model declares, -1 for dynamic dims; per-call shapes must fit it.
+        std::vector<int64_t> model_shape;
+        size_t element_size;
+        size_t byte_size;
+    };
+    struct OutputPlan {
+        std::string name;
+        ONNXTensorElementDataType type;
+        TensorDtype dtype;
+        std::vector<int64_t> shape;
+        // 0 when the model declares dynamic dims, the batch dim included; ORT
+        // then allocates the output.
+        size_t byte_size;
+        // Preallocated output bound to binding_ for static shapes. Reused while
+        // no raw result from an earlier call still holds it.
+        std::shared_ptr<Ort::Value> persistent;
+    };
+    struct BindingPlan {
+        std::vector<InputPlan> inputs;
+        std::vector<OutputPlan> outputs;
+        std::vector<const char*> input_names;
+        std::vector<const char*> output_names;
+        Ort::MemoryInfo memory_info{nullptr};
+        bool has_dynamic_outputs = false;
+    };
+    // A caller buffer bound to caller_binding_.
+    struct BoundBuffer {
+        const void* data = nullptr;
+        size_t bytes = 0;
+    };
+
+    // Shared Env and this model's prepacked weights; declared before session_
+    // so they outlive it.
+    std::shared_ptr<OrtRuntimeContext> runtime_;
+    std::shared_ptr<Ort::PrepackedWeightsContainer> prepacked_weights_;
     Ort::Session session_{nullptr};
-    std::vector<Ort::Value> run_session(const std::vector<std::vector<uint8_t>>& input_tensors);
+    BindingPlan plan_;
+    // Declared after session_ so they are released first.
+    Ort::IoBinding binding_{nullptr};
+    // infer_into()'s binding to the caller's buffers, with the buffer last
+    // bound for each output.
+    Ort::IoBinding caller_binding_{nullptr};
+    std::vector<BoundBuffer> caller_outputs_;
+
+    // Artifact cache path of the optimized model for this configuration, or
+    // empty when it should not be cached.
+    static std::string optimizedModelArtifact(const ArtifactCache& artifact_cache, const std::string& model_path,
+                                              const std::vector<std::string>& providers,
+                                              OrtTuning::GraphOptimization level);
+    // Creates the session from the cached optimized model when there is one;
+    // otherwise from `model_path`, storing the optimized model for next time.
+    Ort::Session loadSession(const std::string& model_path, const std::string& artifact,
+                             const Ort::SessionOptions& session_options, const OrtTuning& tuning,
+                             const MmapTuning& mmap);
+    // From a mapping of `path` when mmap is On, otherwise from the path.
+    Ort::Session openSession(const std::string& path, const Ort::SessionOptions& session_options,
+                             const OrtTuning& tuning, const MmapTuning& mmap);
+
+    void build_binding_plan();
+    void check_input_count(const std::vector<TensorView>& input_tensors) const;
+    Ort::Value make_input_value(const TensorView& view, size_t index);
+    std::vector<Ort::Value> make_input_values(const std::vector<TensorView>& input_tensors);
+    // False when a view carries a shape other than the plan's, so the
+    // planned output shapes may not hold for this call.
+    bool uses_plan_shapes(const std::vector<TensorView>& input_tensors) const;
+    // Runs through binding_. Static outputs are the persistent tensors, shared
+    // rather than copied. Calls with their own input shapes get outputs
+    // allocated by ORT instead.
+    std::vector<std::shared_ptr<Ort::Value>> run_session(const std::vector<TensorView>& input_tensors);
+    void append_variant_output(const Ort::Value& output_tensor, std::vector<std::vector<TensorElement>>& output_tensors,
+                               std::vector<std::vector<int64_t>>& shapes) const;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    variant_outputs(const std::vector<Ort::Value>& output_ort_tensors) const;
     static std::string getDataTypeString(ONNXTensorElementDataType type);
     // Map an ONNX Runtime element type to the neuriplo TensorDataType carried in
     // InferenceMetadata so non-FP32 tensors survive the serving metadata
@@ -35,11 +134,5 @@ class ORTInfer : public InferenceInterface {
     // limited to the element kinds get_infer_results_raw() can emit.
     static TensorDataType inputTensorDataType(ONNXTensorElementDataType type);
     static TensorDataType outputTensorDataType(ONNXTensorElementDataType type);
-
-    template <typename T>
-    void processTensorData(std::vector<TensorElement>& tensor_data, const T* data, size_t num_elements) {
-        for (size_t i = 0; i < num_elements; ++i) {
-            tensor_data.emplace_back(data[i]);
-        }
-    }
+    static TensorDtype outputTensorDtype(ONNXTensorElementDataType type);
 };
@@ -0,0 +1,94 @@
+#include "OrtRuntimeContext.hpp"
+
+#include <filesystem>
+#include <glog/logging.h>
+#include <iterator>
+#include <system_error>
+
+namespace {
+
+// Key under which sessions of one model file find each other.
+std::string model_key(const std::string& model_path) {
+    std::error_code error;
+    const std::filesystem::path canonical = std::filesystem::weakly_canonical(model_path, error);
+    return error ? model_path : canonical.string();
+}
+
+} // namespace
+
+std::shared_ptr<OrtRuntimeContext> OrtRuntimeContext::acquire(const OrtTuning& tuning) {
+    static std::mutex mutex;
+    // Kept for the whole process: ORT expects one Env, created once.
+    static std::shared_ptr<OrtRuntimeContext> context;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!context) {
+        context.reset(new OrtRuntimeContext(tuning));
+    }
+    return context;
+}
+
+OrtRuntimeContext::OrtRuntimeContext(const OrtTuning& tuning)
+    : global_thread_pools_(tuning.global_thread_pools == TuningToggle::On),
+      shared_cpu_allocator_(tuning.shared_cpu_allocator == TuningToggle::On) {
+    if (global_thread_pools_) {
+        Ort::ThreadingOptions threading;
+        if (tuning.intra_op_threads > 0) {
+            threading.SetGlobalIntraOpNumThreads(tuning.intra_op_threads);
+        }
+        if (tuning.inter_op_threads > 0) {
+            threading.SetGlobalInterOpNumThreads(tuning.inter_op_threads);
+        }
+        if (tuning.allow_spinning != TuningToggle::Default) {
+            threading.SetGlobalSpinControl(tuning.allow_spinning == TuningToggle::On ? 1 : 0);
+        }
+        env_ = Ort::Env(threading, ORT_LOGGING_LEVEL_WARNING, "Onnx Runtime Inference");
+        LOG(INFO) << "ORT sessions share global thread pools (intra-op " << tuning.intra_op_threads << ", inter-op "
+                  << tuning.inter_op_threads << ", 0 = ORT default)";
+    } else {
+        env_ = Ort::Env(ORT_LOGGING_LEVEL_WARNING, "Onnx Runtime Inference");
+    }
+
+    if (shared_cpu_allocator_) {
+        // Same arena settings ORT uses per session (all -1/0 = defaults).
+        const Ort::MemoryInfo memory_info =
+            Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+        const Ort::ArenaCfg arena(0, -1, -1, -1);
+        env_.CreateAndRegisterAllocator(memory_info, arena);
+        LOG(INFO) << "ORT sessions share one CPU arena";
+    }
+}
+
+std::shared_ptr<Ort::PrepackedWeightsContainer> OrtRuntimeContext::prepacked_weights(const std::string& model_path) {
+    const std::string key = model_key(model_path);
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Drop containers whose sessions are all gone.
+    for (auto it = prepacked_.begin(); it != prepacked_.end();) {
+        it = it->second.expired() ? prepacked_.erase(it) : std::next(it);
+    }
+    std::weak_ptr<Ort::PrepackedWeightsContainer>& slot = prepacked_[key];
+    std::shared_ptr<Ort::PrepackedWeightsContainer> container = slot.lock();
+    if (!container) {
+        container = std::make_shared<Ort::PrepackedWeightsContainer>();
+        slot = container;
+    }
+    return container;
+}
+
+bool OrtRuntimeContext::join(Ort::SessionOptions& session_options, const OrtTuning& tuning) {
+    bool uses_global_pools = false;
+    if (global_thread_pools_ && tuning.global_thread_pools != TuningToggle::Off) {
+        session_options.DisablePerSessionThreads();
+        uses_global_pools = true;
+    } else if (tuning.global_thread_pools == TuningToggle::On) {
+        LOG(WARNING) << "ORT global thread pools were not enabled when the first session was created; "
+                        "this session keeps its own pools";
+    }
+
+    if (shared_cpu_allocator_ && tuning.shared_cpu_allocator != TuningToggle::Off) {
+        session_options.AddConfigEntry("session.use_env_allocators", "1");
+    } else if (tuning.shared_cpu_allocator == TuningToggle::On) {
+        LOG(WARNING) << "ORT shared CPU allocator was not enabled when the first session was created; "
+                        "this session allocates its own arena";
+    }
+    return uses_global_pools;
+}
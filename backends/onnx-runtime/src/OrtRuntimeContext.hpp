@@ -0,0 +1,45 @@
+#pragma once
+#include "BackendTuning.hpp"
+
+#include <memory>
+#include <mutex>
+#include <onnxruntime_cxx_api.h>
+#include <string>
+#include <unordered_map>
+
+// Process-wide ONNX Runtime state shared by every ORTInfer: one Ort::Env
+// (optionally owning global intra/inter-op thread pools and a shared CPU
+// arena) and one PrepackedWeightsContainer per model file, so N sessions of
+// the same model keep a single copy of their prepacked weights.
+//
+// ORTInfer holds the context and its model's container by shared_ptr, so both
+// outlive every session created from them.
+class OrtRuntimeContext {
+  public:
+    // The process's context. The first call creates the Env from `tuning`
+    // (merged with the environment); later calls share it as created.
+    static std::shared_ptr<OrtRuntimeContext> acquire(const OrtTuning& tuning);
+
+    OrtRuntimeContext(const OrtRuntimeContext&) = delete;
+    OrtRuntimeContext& operator=(const OrtRuntimeContext&) = delete;
+
+    Ort::Env& env() noexcept { return env_; }
+    bool has_global_thread_pools() const noexcept { return global_thread_pools_; }
+
+    // Container shared by the sessions of `model_path` that are alive.
+    std::shared_ptr<Ort::PrepackedWeightsContainer> prepacked_weights(const std::string& model_path);
+
+    // Points a session at the context's shared resources: the global thread
+    // pools (unless the tuning opts out) and the Env's CPU arena. Returns
+    // whether the session runs on the global pools.
+    bool join(Ort::SessionOptions& session_options, const OrtTuning& tuning);
+
+  private:
+    explicit OrtRuntimeContext(const OrtTuning& tuning);
+
+    std::mutex mutex_;
+    bool global_thread_pools_ = false;
+    bool shared_cpu_allocator_ = false;
+    Ort::Env env_{nullptr};
+    std::unordered_map<std::string, std::weak_ptr<Ort::PrepackedWeightsContainer>> prepacked_;
+};
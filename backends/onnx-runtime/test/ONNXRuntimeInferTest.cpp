@@ -1,5 +1,7 @@
 #include "ORTInfer.hpp"
+#include "RawOutputConformance.hpp"
 
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <glog/logging.h>
@@ -151,6 +153,127 @@ TEST_F(ONNXRuntimeInferTest, IntegrationTest) {
     ASSERT_FALSE(inference_metadata.getOutputs().empty());
 }
 
+// Raw path must stay byte-identical to the variant path - only runs with real model
+TEST_F(ONNXRuntimeInferTest, RawMatchesVariant) {
+    if (!has_real_model) {
+        GTEST_SKIP() << "Skipping integration test - no real model available";
+    }
+
+    cv::Mat input = cv::Mat::zeros(224, 224, CV_32FC3);
+    cv::Mat blob;
+    cv::dnn::blobFromImage(input, blob, 1.f / 255.f, cv::Size(224, 224), cv::Scalar(), true, false);
+
+    std::vector<uint8_t> input_data(blob.total() * blob.elemSize());
+    memcpy(input_data.data(), blob.data, input_data.size());
+    std::vector<std::vector<uint8_t>> input_tensors = {input_data};
+    EXPECT_TRUE(RawMatchesVariant(*real_infer, input_tensors));
+}
+
+// A second session of the same model joins the shared Env and prepacked
+// weights and must produce the same results.
+TEST_F(ONNXRuntimeInferTest, SecondSessionSharesWeightsAndMatches) {
+    if (!has_real_model) {
+        GTEST_SKIP() << "Skipping integration test - no real model available";
+    }
+
+    ORTInfer second(model_path, false);
+    const auto& input = real_infer->get_inference_metadata().getInputs()[0];
+    std::vector<std::vector<uint8_t>> zeros = {std::vector<uint8_t>(output_byte_size(input), 0)};
+    EXPECT_EQ(real_infer->get_infer_results_raw(zeros)[0].bytes, second.get_infer_results_raw(zeros)[0].bytes);
+}
+
+// The first session stores its optimized model in the artifact cache; the
+// next one loads it from there and must produce the same results.
+TEST_F(ONNXRuntimeInferTest, ArtifactCacheRoundTripMatches) {
+    if (!has_real_model) {
+        GTEST_SKIP() << "Skipping integration test - no real model available";
+    }
+
+    const fs::path cache_dir = fs::temp_directory_path() / "neuriplo-ort-artifact-cache-test";
+    fs::remove_all(cache_dir);
+    const ArtifactCache cache(cache_dir.string());
+
+    ORTInfer cold(model_path, false, 1, {}, OrtTuning(), cache);
+    size_t artifacts = 0;
+    for (const auto& entry : fs::recursive_directory_iterator(cache_dir)) {
+        artifacts += entry.is_regular_file() ? 1 : 0;
+    }
+    EXPECT_EQ(artifacts, 1u);
+
+    ORTInfer warm(model_path, false, 1, {}, OrtTuning(), cache);
+    const auto& input = real_infer->get_inference_metadata().getInputs()[0];
+    std::vector<std::vector<uint8_t>> zeros = {std::vector<uint8_t>(output_byte_size(input), 0)};
+    const std::vector<uint8_t> expected = real_infer->get_infer_results_raw(zeros)[0].bytes.to_vector();
+    EXPECT_EQ(cold.get_infer_results_raw(zeros)[0].bytes.to_vector(), expected);
+    EXPECT_EQ(warm.get_infer_results_raw(zeros)[0].bytes.to_vector(), expected);
+    fs::remove_all(cache_dir);
+}
+
+// Static outputs are preallocated and reused across calls; a raw result still
+// held by the caller must not be overwritten by the next call.
+TEST_F(ONNXRuntimeInferTest, RawOutputsSurviveLaterCalls) {
+    if (!has_real_model) {
+        GTEST_SKIP() << "Skipping integration test - no real model available";
+    }
+
+    const auto& input = real_infer->get_inference_metadata().getInputs()[0];
+    const size_t input_bytes = output_byte_size(input);
+    std::vector<std::vector<uint8_t>> zeros = {std::vector<uint8_t>(input_bytes, 0)};
+    std::vector<float> ramp(input_bytes / sizeof(float));
+    for (size_t i = 0; i < ramp.size(); ++i) {
+        ramp[i] = static_cast<float>(i % 255) / 255.f;
+    }
+    std::vector<std::vector<uint8_t>> ramp_tensors = {std::vector<uint8_t>(
+        reinterpret_cast<const uint8_t*>(ramp.data()), reinterpret_cast<const uint8_t*>(ramp.data()) + input_bytes)};
+
+    std::vector<RawOutputTensor> first = real_infer->get_infer_results_raw(zeros);
+    const std::vector<uint8_t> first_bytes = first[0].bytes.to_vector();
+    std::vector<RawOutputTensor> second = real_infer->get_infer_results_raw(ramp_tensors);
+    EXPECT_EQ(first[0].bytes.to_vector(), first_bytes);
+    EXPECT_NE(first[0].bytes.data(), second[0].bytes.data());
+
+    // Once released, later calls still produce the same results.
+    first.clear();
+    second.clear();
+    EXPECT_EQ(real_infer->get_infer_results_raw(zeros)[0].bytes.to_vector(), first_bytes);
+}
+
+// infer_into() keeps caller buffers bound between calls and must rebind them
+// when the caller switches to other buffers.
+TEST_F(ONNXRuntimeInferTest, InferIntoFollowsMovedBuffers) {
+    if (!has_real_model) {
+        GTEST_SKIP() << "Skipping integration test - no real model available";
+    }
+
+    const InferenceMetadata metadata = real_infer->get_inference_metadata();
+    const size_t input_bytes = output_byte_size(metadata.getInputs()[0]);
+    const size_t output_bytes = output_byte_size(metadata.getOutputs()[0]);
+    std::vector<float> ramp(input_bytes / sizeof(float));
+    for (size_t i = 0; i < ramp.size(); ++i) {
+        ramp[i] = static_cast<float>(i % 255) / 255.f;
+    }
+    std::vector<uint8_t> zeros(input_bytes, 0);
+    const std::vector<uint8_t> expected_zeros =
+        real_infer->get_infer_results_raw(std::vector<TensorView>{TensorView(zeros)})[0].bytes.to_vector();
+    const std::vector<uint8_t> expected_ramp =
+        real_infer->get_infer_results_raw(std::vector<TensorView>{TensorView(ramp.data(), input_bytes)})[0]
+            .bytes.to_vector();
+
+    std::vector<uint8_t> first(output_bytes);
+    std::vector<uint8_t> second(output_bytes);
+    std::vector<OutputBuffer> buffers = {OutputBuffer(first.data(), first.size())};
+    real_infer->infer_into({TensorView(zeros)}, buffers);
+    EXPECT_EQ(first, expected_zeros);
+    real_infer->infer_into({TensorView(ramp.data(), input_bytes)}, buffers);
+    EXPECT_EQ(first, expected_ramp);
+
+    buffers[0] = OutputBuffer(second.data(), second.size());
+    real_infer->infer_into({TensorView(zeros)}, buffers);
+    EXPECT_EQ(second, expected_zeros);
+    EXPECT_EQ(first, expected_ramp);
+    EXPECT_EQ(buffers[0].shape, metadata.getOutputs()[0].shape);
+}
+
 // Unit test - only runs with mock
 TEST_F(ONNXRuntimeInferTest, MockUnitTest) {
     if (has_real_model) {
@@ -209,6 +332,217 @@ TEST(ONNXRuntimeProviderSelectionTest, RejectsEmptyProviderList) {
     EXPECT_THROW((void)ORTInfer::parseExecutionProviderList(" , "), std::runtime_error);
 }
 
+// Just enough protobuf encoding to write small ONNX models from a test.
+namespace onnx_model {
+std::string varint(uint64_t value) {
+    std::string out;
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+    return out;
+}
+
+std::string int_field(uint32_t number, uint64_t value) {
+    return varint(number << 3) + varint(value);
+}
+
+std::string bytes_field(uint32_t number, const std::string& bytes) {
+    return varint((number << 3) | 2) + varint(bytes.size()) + bytes;
+}
+
+// ValueInfoProto of a tensor; negative dims become the symbolic dim "n".
+std::string tensor_value(const std::string& name, int element_type, const std::vector<int64_t>& dims) {
+    std::string shape;
+    for (int64_t dim : dims) {
+        shape += bytes_field(1, dim < 0 ? bytes_field(2, "n") : int_field(1, static_cast<uint64_t>(dim)));
+    }
+    const std::string tensor_type = int_field(1, static_cast<uint64_t>(element_type)) + bytes_field(2, shape);
+    return bytes_field(1, name) + bytes_field(2, bytes_field(1, tensor_type));
+}
+
+std::string node(const std::string& op_type, const std::string& input, const std::string& output) {
+    return bytes_field(1, input) + bytes_field(2, output) + bytes_field(4, op_type);
+}
+
+// float input [1,3,4,4] -> NonZero -> Transpose -> int64 output [-1,4]: one
+// row of coordinates per non-zero input element, like a detection output
+// whose row count depends on the data.
+std::string nonzero_coordinates_model() {
+    const std::string input = tensor_value("input", ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, {1, 3, 4, 4});
+    const std::string output = tensor_value("coordinates", ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, {-1, 4});
+    const std::string graph = bytes_field(1, node("NonZero", "input", "indices")) +
+                              bytes_field(1, node("Transpose", "indices", "coordinates")) +
+                              bytes_field(2, "nonzero") + bytes_field(11, input) + bytes_field(12, output);
+    return int_field(1, 7) + bytes_field(7, graph) + bytes_field(8, int_field(2, 13));
+}
+
+// float input [1,3,4,4] -> Neg -> float output [1,3,4,4], all dims static.
+std::string negate_model() {
+    const std::string input = tensor_value("input", ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, {1, 3, 4, 4});
+    const std::string output = tensor_value("negated", ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, {1, 3, 4, 4});
+    const std::string graph = bytes_field(1, node("Neg", "input", "negated")) + bytes_field(2, "negate") +
+                              bytes_field(11, input) + bytes_field(12, output);
+    return int_field(1, 7) + bytes_field(7, graph) + bytes_field(8, int_field(2, 13));
+}
+
+// float input [1,3,4,4] + bias -> float output [1,3,4,4], with the float [1]
+// bias initializer stored in the external data file `location`.
+std::string external_bias_model(const std::string& location) {
+    const std::string input = tensor_value("input", ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, {1, 3, 4, 4});
+    const std::string output = tensor_value("biased", ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, {1, 3, 4, 4});
+    const std::string bias = int_field(1, 1) + int_field(2, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) +
+                             bytes_field(8, "bias") +
+                             bytes_field(13, bytes_field(1, "location") + bytes_field(2, location)) + int_field(14, 1);
+    const std::string add =
+        bytes_field(1, "input") + bytes_field(1, "bias") + bytes_field(2, "biased") + bytes_field(4, "Add");
+    const std::string graph = bytes_field(1, add) + bytes_field(2, "bias") + bytes_field(5, bias) +
+                              bytes_field(11, input) + bytes_field(12, output);
+    return int_field(1, 7) + bytes_field(7, graph) + bytes_field(8, int_field(2, 13));
+}
+} // namespace onnx_model
+
+// The optimized model embeds the initializers, so retrained external weights
+// must not load the artifact cached for the old ones.
+TEST(ONNXRuntimeArtifactCacheTest, ExternalDataChangesTheArtifact) {
+    const fs::path dir = fs::temp_directory_path() / "neuriplo-ort-external-data";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const fs::path model = dir / "biased.onnx";
+    {
+        std::ofstream out(model, std::ios::binary);
+        out << onnx_model::external_bias_model("bias.bin");
+    }
+    const ArtifactCache cache((dir / "cache").string());
+
+    std::vector<float> input(3 * 4 * 4, 1.f);
+    const std::vector<TensorView> views = {TensorView(input.data(), input.size() * sizeof(float))};
+    int generation = 0;
+    for (float bias : {2.f, 5.f}) {
+        const fs::path weights = dir / "bias.bin";
+        {
+            std::ofstream out(weights, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(&bias), sizeof(bias));
+        }
+        // Same size as before; move the mtime so the memoized hash is not reused.
+        fs::last_write_time(weights, fs::last_write_time(weights) + std::chrono::seconds(++generation));
+
+        ORTInfer infer(model.string(), false, 1, {}, OrtTuning(), cache);
+        const std::vector<RawOutputTensor> outputs = infer.get_infer_results_raw(views);
+        ASSERT_EQ(outputs.size(), 1u);
+        float value = 0.f;
+        std::memcpy(&value, outputs[0].bytes.data(), sizeof(value));
+        EXPECT_EQ(value, 1.f + bias);
+    }
+
+    size_t artifacts = 0;
+    for (const auto& entry : fs::recursive_directory_iterator(dir / "cache")) {
+        artifacts += entry.is_regular_file() ? 1 : 0;
+    }
+    EXPECT_EQ(artifacts, 2u);
+    fs::remove_all(dir);
+}
+
+// A caller refilling the same input buffer every frame must get results for
+// the new contents, not for whatever the buffer held when first bound.
+TEST(ONNXRuntimeInferIntoTest, RefilledInputBufferIsReadAgain) {
+    const fs::path model = fs::temp_directory_path() / "neuriplo-ort-negate.onnx";
+    {
+        std::ofstream out(model, std::ios::binary);
+        out << onnx_model::negate_model();
+    }
+    ORTInfer infer(model.string(), false);
+
+    std::vector<float> input(3 * 4 * 4, 1.f);
+    std::vector<float> output(input.size());
+    const std::vector<TensorView> views = {TensorView(input.data(), input.size() * sizeof(float))};
+    std::vector<OutputBuffer> buffers = {OutputBuffer(output.data(), output.size() * sizeof(float))};
+    for (float value : {1.f, 2.f, 3.f}) {
+        std::fill(input.begin(), input.end(), value);
+        infer.infer_into(views, buffers);
+        EXPECT_EQ(buffers[0].shape, (std::vector<int64_t>{1, 3, 4, 4}));
+        EXPECT_EQ(output.front(), -value);
+        EXPECT_EQ(output.back(), -value);
+    }
+
+    fs::remove(model);
+}
+
+// Outputs whose leading dim depends on the data cannot be preallocated from
+// the metadata shape (which reports the batch size there); ORT must allocate
+// them on every call.
+TEST(ONNXRuntimeDynamicOutputTest, DataDependentLeadingDim) {
+    const fs::path model = fs::temp_directory_path() / "neuriplo-ort-nonzero.onnx";
+    {
+        std::ofstream out(model, std::ios::binary);
+        out << onnx_model::nonzero_coordinates_model();
+    }
+    ORTInfer infer(model.string(), false);
+
+    std::vector<float> input(3 * 4 * 4, 0.f);
+    input[1] = 1.f;
+    input[5] = 2.f;
+    input[40] = 3.f;
+    const std::vector<TensorView> views = {TensorView(input.data(), input.size() * sizeof(float))};
+
+    std::vector<RawOutputTensor> three = infer.get_infer_results_raw(views);
+    ASSERT_EQ(three.size(), 1u);
+    EXPECT_EQ(three[0].shape, (std::vector<int64_t>{3, 4}));
+    EXPECT_EQ(three[0].bytes.size(), 3u * 4u * sizeof(int64_t));
+
+    input[47] = 4.f;
+    input[20] = 5.f;
+    std::vector<RawOutputTensor> five = infer.get_infer_results_raw(views);
+    EXPECT_EQ(five[0].shape, (std::vector<int64_t>{5, 4}));
+    // The earlier result is left as it was.
+    EXPECT_EQ(three[0].shape, (std::vector<int64_t>{3, 4}));
+
+    std::vector<int64_t> storage(16 * 4);
+    std::vector<OutputBuffer> buffers = {OutputBuffer(storage.data(), storage.size() * sizeof(int64_t))};
+    infer.infer_into(views, buffers);
+    EXPECT_EQ(buffers[0].shape, (std::vector<int64_t>{5, 4}));
+    EXPECT_EQ(buffers[0].size_bytes, 5u * 4u * sizeof(int64_t));
+    // Row of input[40]: channel 2, row 2, column 0.
+    EXPECT_EQ(std::vector<int64_t>(storage.begin() + 12, storage.begin() + 16), (std::vector<int64_t>{0, 2, 2, 0}));
+
+    fs::remove(model);
+}
+
+// The data-dependent dim may grow and shrink from one raw call to the next;
+// every call must come back with its own row count and coordinates.
+TEST(ONNXRuntimeDynamicOutputTest, DataDependentDimChangesAcrossCalls) {
+    const fs::path model = fs::temp_directory_path() / "neuriplo-ort-nonzero-resize.onnx";
+    {
+        std::ofstream out(model, std::ios::binary);
+        out << onnx_model::nonzero_coordinates_model();
+    }
+    ORTInfer infer(model.string(), false);
+
+    std::vector<float> input(3 * 4 * 4);
+    const std::vector<TensorView> views = {TensorView(input.data(), input.size() * sizeof(float))};
+    for (size_t nonzeros : {2u, 6u, 1u, 4u, 0u, 3u}) {
+        std::fill(input.begin(), input.end(), 0.f);
+        for (size_t i = 0; i < nonzeros; ++i) {
+            input[i * 5] = 1.f;
+        }
+        const std::vector<RawOutputTensor> outputs = infer.get_infer_results_raw(views);
+        ASSERT_EQ(outputs.size(), 1u);
+        EXPECT_EQ(outputs[0].shape, (std::vector<int64_t>{static_cast<int64_t>(nonzeros), 4}));
+        ASSERT_EQ(outputs[0].bytes.size(), nonzeros * 4 * sizeof(int64_t));
+        if (nonzeros > 0) {
+            // The last nonzero sits at flat index (nonzeros - 1) * 5.
+            const int64_t flat = static_cast<int64_t>(nonzeros - 1) * 5;
+            std::vector<int64_t> last(4);
+            std::memcpy(last.data(), outputs[0].bytes.data() + (nonzeros - 1) * 4 * sizeof(int64_t),
+                        4 * sizeof(int64_t));
+            EXPECT_EQ(last, (std::vector<int64_t>{0, flat / 16, flat % 16 / 4, flat % 4}));
+        }
+    }
+
+    fs::remove(model);
+}
+
 // GPU test - only runs if has_real_model and GPU available
 TEST_F(ONNXRuntimeInferTest, GPUTest) {
     if (!has_real_model) {
@@ -1,6 +1,6 @@
 #include "OCVDNNInfer.hpp"
 
-#include <cstring>
+#include "ITensorConverter.hpp"
 
 OCVDNNInfer::OCVDNNInfer(const std::string& model_path, bool use_gpu, size_t batch_size,
                          const std::vector<std::vector<int64_t>>& input_sizes)
@@ -52,7 +52,7 @@ OCVDNNInfer::OCVDNNInfer(const std::string& model_path, bool use_gpu, size_t bat
     state_ = BackendState::Ready;
 }
 
-std::vector<cv::Mat> OCVDNNInfer::run_forward(const std::vector<std::vector<uint8_t>>& input_tensors) {
+std::vector<cv::Mat> OCVDNNInfer::run_forward(const std::vector<TensorView>& input_tensors) {
 
     // OpenCV DNN backend currently supports only single input models
     if (input_tensors.size() != 1) {
@@ -60,7 +60,7 @@ std::vector<cv::Mat> OCVDNNInfer::run_forward(const std::vector<std::vector<uint
                                  std::to_string(input_tensors.size()) + " inputs");
     }
 
-    const std::vector<uint8_t>& input_data = input_tensors[0];
+    const TensorView& input_data = input_tensors[0];
 
     // Reconstruct cv::Mat from raw bytes
     // We assume the input is already a preprocessed blob (NCHW or similar) matching the model input
@@ -74,19 +74,19 @@ std::vector<cv::Mat> OCVDNNInfer::run_forward(const std::vector<std::vector<uint
     size_t expected_elements = 1;
     for (auto s : shape_meta)
         expected_elements *= s;
-    if (input_data.size() != expected_elements * sizeof(float)) {
+    if (input_data.size_bytes != expected_elements * sizeof(float)) {
         // Fallback or warning?
         // OpenCV DNN usually works with Float32
         // If size mismatches, it might be uint8 image?
         // If we strictly follow "get_infer_results takes processed tensors", it should be float.
         // But if user passes an image, we can't easily handle blobFromImage without parameters (mean, scale).
         // We assume it's the blob.
-        if (input_data.size() == expected_elements) {
+        if (input_data.size_bytes == expected_elements) {
             // Maybe it's uint8?
         }
     }
 
-    cv::Mat blob(mat_size.size(), mat_size.data(), CV_32F, const_cast<uint8_t*>(input_data.data()));
+    cv::Mat blob(mat_size.size(), mat_size.data(), CV_32F, const_cast<uint8_t*>(input_data.data));
 
     std::vector<cv::Mat> outs;
     net_.setInput(blob);
@@ -96,6 +96,11 @@ std::vector<cv::Mat> OCVDNNInfer::run_forward(const std::vector<std::vector<uint
 
 std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
 OCVDNNInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+OCVDNNInfer::get_infer_results(const std::vector<TensorView>& input_tensors) {
 
     const std::vector<cv::Mat> outs = run_forward(input_tensors);
 
@@ -118,10 +123,7 @@ OCVDNNInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_te
         tensor_data.reserve(output.total());
 
         if (output.type() == CV_32F) {
-            const float* data = output.ptr<float>();
-            for (int j = 0; j < output.total(); ++j) {
-                tensor_data.push_back(data[j]);
-            }
+            tensor_converter().append_elements(tensor_data, output.ptr<float>(), output.total(), ElementType::Float32);
         } else if (output.type() == CV_64F) {
             const double* data = output.ptr<double>();
             for (int j = 0; j < output.total(); ++j) {
@@ -139,6 +141,10 @@ OCVDNNInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_te
 
 std::vector<RawOutputTensor>
 OCVDNNInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> OCVDNNInfer::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
 
     const std::vector<cv::Mat> outs = run_forward(input_tensors);
 
@@ -146,7 +152,8 @@ OCVDNNInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& inpu
     raw_outputs.reserve(outs.size());
 
     for (const auto& output : outs) {
-        // forward() allocates fresh, continuous Mats; clone defensively if not.
+        // forward() copies results into fresh, continuous Mats (not the net's
+        // internal blobs), so they are safe to adopt; clone defensively if not.
         const cv::Mat contiguous = output.isContinuous() ? output : output.clone();
 
         RawOutputTensor raw;
@@ -157,16 +164,18 @@ OCVDNNInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& inpu
 
         raw.dtype = TensorDtype::FP32;
         const size_t num_elements = contiguous.total();
-        raw.bytes.resize(num_elements * sizeof(float));
-        auto* typed = reinterpret_cast<float*>(raw.bytes.data());
 
         if (contiguous.type() == CV_32F) {
-            std::memcpy(raw.bytes.data(), contiguous.ptr<float>(), raw.bytes.size());
+            // The Mat shares its refcounted data with the buffer; no copy.
+            raw.bytes = TensorBuffer::adopt(contiguous.ptr<float>(), num_elements * sizeof(float), contiguous);
         } else if (contiguous.type() == CV_64F) {
+            std::vector<uint8_t> bytes(num_elements * sizeof(float));
+            auto* typed = reinterpret_cast<float*>(bytes.data());
             const double* data = contiguous.ptr<double>();
             for (size_t j = 0; j < num_elements; ++j) {
                 typed[j] = static_cast<float>(data[j]);
             }
+            raw.bytes = std::move(bytes);
         } else {
             throw std::runtime_error("Unsupported data type in OCVDNNInfer::get_infer_results_raw");
         }
@@ -176,3 +185,39 @@ OCVDNNInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& inpu
 
     return raw_outputs;
 }
+
+void OCVDNNInfer::infer_into(const std::vector<TensorView>& input_tensors, std::vector<OutputBuffer>& output_buffers) {
+
+    const std::vector<cv::Mat> outs = run_forward(input_tensors);
+    check_output_buffer_count(output_buffers, outs.size());
+
+    for (size_t i = 0; i < outs.size(); ++i) {
+        const cv::Mat contiguous = outs[i].isContinuous() ? outs[i] : outs[i].clone();
+        OutputBuffer& buffer = output_buffers[i];
+
+        if (contiguous.type() == CV_32F) {
+            copy_into_output_buffer(buffer, i, TensorDtype::FP32, contiguous.ptr<float>(),
+                                    contiguous.total() * sizeof(float));
+        } else if (contiguous.type() == CV_64F) {
+            // Narrow to float directly in the caller's buffer, matching the raw path.
+            const size_t num_elements = contiguous.total();
+            const size_t required_bytes = num_elements * sizeof(float);
+            if (buffer.data == nullptr || buffer.capacity_bytes < required_bytes) {
+                throw InferenceExecutionException("Output buffer at index " + std::to_string(i) + " holds " +
+                                                  std::to_string(buffer.capacity_bytes) + " bytes, output needs " +
+                                                  std::to_string(required_bytes));
+            }
+            const double* data = contiguous.ptr<double>();
+            auto* typed = reinterpret_cast<float*>(buffer.data);
+            for (size_t j = 0; j < num_elements; ++j) {
+                typed[j] = static_cast<float>(data[j]);
+            }
+            buffer.dtype = TensorDtype::FP32;
+            buffer.size_bytes = required_bytes;
+        } else {
+            throw std::runtime_error("Unsupported data type in OCVDNNInfer::infer_into");
+        }
+
+        buffer.shape.assign(contiguous.size.p, contiguous.size.p + contiguous.dims);
+    }
+}
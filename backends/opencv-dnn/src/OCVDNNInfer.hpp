@@ -9,7 +9,7 @@ class OCVDNNInfer : public InferenceInterface {
     std::string outLayerType_;
     std::vector<std::string> outNames_;
 
-    std::vector<cv::Mat> run_forward(const std::vector<std::vector<uint8_t>>& input_tensors);
+    std::vector<cv::Mat> run_forward(const std::vector<TensorView>& input_tensors);
 
   public:
     OCVDNNInfer(const std::string& model_path, bool use_gpu = false, size_t batch_size = 1,
@@ -17,7 +17,11 @@ class OCVDNNInfer : public InferenceInterface {
 
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& input_tensors) override;
     std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& input_tensors) override;
+    void infer_into(const std::vector<TensorView>& input_tensors, std::vector<OutputBuffer>& output_buffers) override;
 
     bool isCudaBuildEnabled() {
         std::string buildInfo = cv::getBuildInformation();
@@ -1,5 +1,8 @@
 #include "OVInfer.hpp"
 
+#include "ITensorConverter.hpp"
+#include "openvino/core/version.hpp"
+
 #include <filesystem>
 #include <numeric>
 #include <sstream>
@@ -64,7 +67,7 @@ TensorDataType OVInfer::outputTensorDataType(ov::element::Type type) {
 }
 
 OVInfer::OVInfer(const std::string& model_path, bool use_gpu, size_t batch_size,
-                 const std::vector<std::vector<int64_t>>& input_sizes)
+                 const std::vector<std::vector<int64_t>>& input_sizes, const ArtifactCache& artifact_cache)
     : InferenceInterface{model_path, use_gpu, batch_size, input_sizes} {
     std::filesystem::path fs_path(model_path);
 
@@ -98,6 +101,11 @@ OVInfer::OVInfer(const std::string& model_path, bool use_gpu, size_t batch_size,
             auto input = model_->input(i);
             std::string name = input.get_any_name();
             ov::PartialShape partial_shape = input.get_partial_shape();
+            std::vector<int64_t> declared;
+            for (size_t j = 0; j < partial_shape.size(); ++j) {
+                declared.push_back(partial_shape[j].is_dynamic() ? -1 : partial_shape[j].get_length());
+            }
+            declared_input_shapes_.push_back(std::move(declared));
 
             // Non-batch dynamic dims require explicit input_sizes; batch-only
             // dynamic models (common after ovc) can compile with batch_size alone.
@@ -161,6 +169,16 @@ OVInfer::OVInfer(const std::string& model_path, bool use_gpu, size_t batch_size,
         std::string device = use_gpu ? "GPU" : "CPU";
         LOG(INFO) << "Using device: " << device;
 
+        // OpenVINO keys its compiled blobs on the model, device and compile
+        // properties itself; a directory per runtime build keeps blobs of
+        // other OpenVINO versions out of its way.
+        const std::string cache_dir =
+            artifact_cache.backend_directory("openvino", ov::get_openvino_version().buildNumber);
+        if (!cache_dir.empty()) {
+            core_.set_property(ov::cache_dir(cache_dir));
+            LOG(INFO) << "OpenVINO compiled model cache: " << cache_dir;
+        }
+
         try {
             compiled_model_ = core_.compile_model(model_, device);
         } catch (const ov::Exception& e) {
@@ -172,6 +190,7 @@ OVInfer::OVInfer(const std::string& model_path, bool use_gpu, size_t batch_size,
                 throw; // Re-throw if it's not a GPU fallback case
             }
         }
+        device_ = device;
         infer_request_ = compiled_model_.create_infer_request();
 
         // --- Process inputs after compilation ---
@@ -226,7 +245,57 @@ OVInfer::OVInfer(const std::string& model_path, bool use_gpu, size_t batch_size,
     }
 }
 
-void OVInfer::bind_inputs_and_infer(const std::vector<std::vector<uint8_t>>& input_tensors) {
+OVInfer::OVInfer(OVInfer& source, ReplicaTag)
+    : InferenceInterface{source.model_path_, source.gpu_available_, source.batch_size_}, model_(source.model_),
+      compiled_model_(source.compiled_model_), device_(source.device_),
+      declared_input_shapes_(source.declared_input_shapes_) {
+    inference_metadata_ = source.inference_metadata_;
+    infer_request_ = compiled_model_.create_infer_request();
+    state_ = source.state_;
+}
+
+std::unique_ptr<InferenceInterface> OVInfer::make_replica() {
+    return std::unique_ptr<InferenceInterface>(new OVInfer(*this, ReplicaTag{}));
+}
+
+bool OVInfer::uses_compiled_shapes(const std::vector<TensorView>& input_tensors) const {
+    for (size_t i = 0; i < input_tensors.size() && i < compiled_model_.inputs().size(); ++i) {
+        if (!input_tensors[i].has_shape()) {
+            continue;
+        }
+        const ov::Shape& compiled = compiled_model_.input(i).get_shape();
+        if (input_tensors[i].shape_vector() != std::vector<int64_t>(compiled.begin(), compiled.end())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ov::InferRequest& OVInfer::request_for(const std::vector<TensorView>& input_tensors) {
+    if (uses_compiled_shapes(input_tensors)) {
+        return infer_request_;
+    }
+    if (!dynamic_request_) {
+        // model_ was reshaped to the load-time shapes; a clone reshaped back
+        // to the declared ones accepts every shape the model does.
+        std::shared_ptr<ov::Model> dynamic = model_->clone();
+        std::map<ov::Output<ov::Node>, ov::PartialShape> declared;
+        for (size_t i = 0; i < dynamic->inputs().size(); ++i) {
+            std::vector<ov::Dimension> dims;
+            for (const int64_t dim : declared_input_shapes_[i]) {
+                dims.emplace_back(dim < 0 ? ov::Dimension::dynamic() : ov::Dimension(dim));
+            }
+            declared[dynamic->input(i)] = ov::PartialShape(dims);
+        }
+        dynamic->reshape(declared);
+        LOG(INFO) << "Compiling " << model_path_ << " with dynamic input shapes for per-call shapes";
+        dynamic_model_ = core_.compile_model(dynamic, device_);
+        dynamic_request_ = dynamic_model_.create_infer_request();
+    }
+    return dynamic_request_;
+}
+
+void OVInfer::bind_inputs(const std::vector<TensorView>& input_tensors, ov::InferRequest& request) {
     const size_t num_inputs = model_->inputs().size();
     if (input_tensors.size() != num_inputs) {
         throw std::runtime_error("Input tensor count mismatch. Expected " + std::to_string(num_inputs) + ", got " +
@@ -235,18 +304,37 @@ void OVInfer::bind_inputs_and_infer(const std::vector<std::vector<uint8_t>>& inp
 
     for (size_t i = 0; i < num_inputs; ++i) {
         auto input_port = compiled_model_.input(i);
-        ov::Tensor input_tensor(input_port.get_element_type(), input_port.get_shape(),
-                                const_cast<uint8_t*>(input_tensors[i].data()));
-        infer_request_.set_input_tensor(i, input_tensor);
+        const ov::element::Type type = input_port.get_element_type();
+        ov::Shape shape = input_port.get_shape();
+        if (input_tensors[i].has_shape()) {
+            const std::vector<int64_t> dims =
+                resolve_input_shape(input_tensors[i], i, declared_input_shapes_[i], type.size());
+            shape.assign(dims.begin(), dims.end());
+        }
+        ov::Tensor input_tensor(type, shape, const_cast<uint8_t*>(input_tensors[i].data));
+        request.set_input_tensor(i, input_tensor);
     }
+}
 
-    infer_request_.infer();
+ov::InferRequest& OVInfer::bind_inputs_and_infer(const std::vector<TensorView>& input_tensors) {
+    ov::InferRequest& request = request_for(input_tensors);
+    bind_inputs(input_tensors, request);
+    request.infer();
+    return request;
 }
 
 std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
 OVInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
-    bind_inputs_and_infer(input_tensors);
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+OVInfer::get_infer_results(const std::vector<TensorView>& input_tensors) {
+    return variant_outputs(bind_inputs_and_infer(input_tensors));
+}
 
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+OVInfer::variant_outputs(ov::InferRequest& request) const {
     std::vector<std::vector<TensorElement>> outputs;
     std::vector<std::vector<int64_t>> shapes;
     const size_t num_outputs = model_->outputs().size();
@@ -254,7 +342,7 @@ OVInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensor
     shapes.reserve(num_outputs);
 
     for (size_t i = 0; i < num_outputs; ++i) {
-        auto output_tensor = infer_request_.get_output_tensor(i);
+        auto output_tensor = request.get_output_tensor(i);
         const ov::element::Type output_type = output_tensor.get_element_type();
         const std::size_t output_size = output_tensor.get_size();
 
@@ -263,37 +351,24 @@ OVInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensor
         output.reserve(output_size);
 
         switch (output_type) {
-        case ov::element::f32: {
-            const float* output_buffer = output_tensor.data<const float>();
-            for (std::size_t j = 0; j < output_size; ++j) {
-                output.push_back(output_buffer[j]);
-            }
+        case ov::element::f32:
+            tensor_converter().append_elements(output, output_tensor.data<const float>(), output_size,
+                                               ElementType::Float32);
             break;
-        }
-        case ov::element::i32: {
-            const int32_t* output_buffer = output_tensor.data<const int32_t>();
-            for (std::size_t j = 0; j < output_size; ++j) {
-                output.push_back(output_buffer[j]);
-            }
+        case ov::element::i32:
+            tensor_converter().append_elements(output, output_tensor.data<const int32_t>(), output_size,
+                                               ElementType::Int32);
             break;
-        }
-        case ov::element::i64: {
-            const int64_t* output_buffer = output_tensor.data<const int64_t>();
-            for (std::size_t j = 0; j < output_size; ++j) {
-                output.push_back(output_buffer[j]);
-            }
+        case ov::element::i64:
+            tensor_converter().append_elements(output, output_tensor.data<const int64_t>(), output_size,
+                                               ElementType::Int64);
             break;
-        }
-        case ov::element::u8: {
-            const uint8_t* output_buffer = output_tensor.data<const uint8_t>();
-            for (std::size_t j = 0; j < output_size; ++j) {
-                output.push_back(output_buffer[j]);
-            }
+        case ov::element::u8:
+            tensor_converter().append_elements(output, output_tensor.data<const uint8_t>(), output_size,
+                                               ElementType::UInt8);
             break;
-        }
         default:
             LOG(ERROR) << "Unsupported output tensor type: " << output_type.get_type_name();
-            state_ = BackendState::Failed;
             throw InferenceExecutionException("Unsupported output tensor type for OpenVINO: " +
                                               output_type.get_type_name());
         }
@@ -305,14 +380,114 @@ OVInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensor
     return std::make_tuple(outputs, shapes);
 }
 
+// infer_request_ runs one inference at a time, so asynchronous calls queue
+// here and each completion callback starts the next one.
+void OVInfer::start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) {
+    // Calls with their own input shapes run on the dynamic request, off
+    // this queue.
+    if (!uses_compiled_shapes(inputs->views())) {
+        InferenceInterface::start_async(std::move(inputs), std::move(done));
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        async_pending_.push_back(AsyncCall{std::move(inputs), std::move(done)});
+        if (async_running_) {
+            return;
+        }
+        async_running_ = true;
+    }
+    start_next_async();
+}
+
+void OVInfer::start_next_async() {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(async_mutex_);
+            if (async_pending_.empty()) {
+                async_running_ = false;
+                return;
+            }
+            async_current_ = std::move(async_pending_.front());
+            async_pending_.pop_front();
+        }
+        try {
+            if (!async_callback_set_) {
+                infer_request_.set_callback([this](std::exception_ptr error) { finish_async(error); });
+                async_callback_set_ = true;
+            }
+            bind_inputs(async_current_.inputs->views(), infer_request_);
+            infer_request_.start_async();
+            return;
+        } catch (...) {
+            AsyncCall failed = std::move(async_current_);
+            failed.done(std::current_exception(), {});
+        }
+    }
+}
+
+void OVInfer::finish_async(std::exception_ptr error) {
+    AsyncCall call = std::move(async_current_);
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>> results;
+    if (!error) {
+        try {
+            results = variant_outputs(infer_request_);
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+    // The outputs are copied out, so the request can take the next call
+    // before this one's callback runs.
+    start_next_async();
+    call.done(error, std::move(results));
+}
+
 std::vector<RawOutputTensor> OVInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
-    bind_inputs_and_infer(input_tensors);
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> OVInfer::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
+    bool static_outputs = true;
+    for (const auto& port : compiled_model_.outputs()) {
+        static_outputs = static_outputs && port.get_partial_shape().is_static();
+    }
+
+    // Static outputs: infer into fresh per-call tensors and hand them to the
+    // caller. The request's own output tensors are reused by the next infer(),
+    // so only the dynamic-shape path below copies out of them.
+    if (static_outputs && uses_compiled_shapes(input_tensors)) {
+        bind_inputs(input_tensors, infer_request_);
+        const size_t num_outputs = compiled_model_.outputs().size();
+        std::vector<ov::Tensor> fresh_outputs;
+        fresh_outputs.reserve(num_outputs);
+        for (size_t i = 0; i < num_outputs; ++i) {
+            const auto port = compiled_model_.output(i);
+            rawDtype(port.get_element_type()); // reject unsupported types before inferring
+            fresh_outputs.emplace_back(port.get_element_type(), port.get_shape());
+        }
+        infer_with_outputs(fresh_outputs);
+
+        std::vector<RawOutputTensor> raw_outputs;
+        raw_outputs.reserve(num_outputs);
+        for (ov::Tensor& tensor : fresh_outputs) {
+            RawOutputTensor raw;
+            raw.dtype = rawDtype(tensor.get_element_type());
+            raw.shape.assign(tensor.get_shape().begin(), tensor.get_shape().end());
+            const void* data = tensor.data();
+            const size_t size_bytes = tensor.get_byte_size();
+            raw.bytes = TensorBuffer::adopt(data, size_bytes, std::move(tensor));
+            raw_outputs.push_back(std::move(raw));
+        }
+        return raw_outputs;
+    }
+
+    ov::InferRequest& request = bind_inputs_and_infer(input_tensors);
 
     std::vector<RawOutputTensor> raw_outputs;
     raw_outputs.reserve(model_->outputs().size());
 
     for (size_t i = 0; i < model_->outputs().size(); ++i) {
-        auto output_tensor = infer_request_.get_output_tensor(i);
+        auto output_tensor = request.get_output_tensor(i);
         const ov::element::Type output_type = output_tensor.get_element_type();
         const std::size_t output_size = output_tensor.get_size();
 
@@ -340,7 +515,6 @@ std::vector<RawOutputTensor> OVInfer::get_infer_results_raw(const std::vector<st
             break;
         default:
             LOG(ERROR) << "Unsupported output tensor type: " << output_type.get_type_name();
-            state_ = BackendState::Failed;
             throw InferenceExecutionException("Unsupported output tensor type for OpenVINO: " +
                                               output_type.get_type_name());
         }
@@ -350,3 +524,84 @@ std::vector<RawOutputTensor> OVInfer::get_infer_results_raw(const std::vector<st
 
     return raw_outputs;
 }
+
+void OVInfer::infer_into(const std::vector<TensorView>& input_tensors, std::vector<OutputBuffer>& output_buffers) {
+    const size_t num_outputs = compiled_model_.outputs().size();
+    check_output_buffer_count(output_buffers, num_outputs);
+
+    // Caller memory can only back outputs whose shape is known before infer().
+    bool static_outputs = uses_compiled_shapes(input_tensors);
+    for (const auto& port : compiled_model_.outputs()) {
+        static_outputs = static_outputs && port.get_partial_shape().is_static();
+    }
+    if (!static_outputs) {
+        InferenceInterface::infer_into(input_tensors, output_buffers);
+        return;
+    }
+
+    bind_inputs(input_tensors, infer_request_);
+
+    for (size_t i = 0; i < num_outputs; ++i) {
+        const auto port = compiled_model_.output(i);
+        const ov::element::Type output_type = port.get_element_type();
+        OutputBuffer& buffer = output_buffers[i];
+        buffer.dtype = rawDtype(output_type);
+
+        const ov::Shape& shape = port.get_shape();
+        const size_t required_bytes = ov::shape_size(shape) * output_type.size();
+        if (buffer.data == nullptr || buffer.capacity_bytes < required_bytes) {
+            throw InferenceExecutionException("Output buffer at index " + std::to_string(i) + " holds " +
+                                              std::to_string(buffer.capacity_bytes) + " bytes, output needs " +
+                                              std::to_string(required_bytes));
+        }
+        buffer.size_bytes = required_bytes;
+        buffer.shape.assign(shape.begin(), shape.end());
+    }
+
+    std::vector<ov::Tensor> caller_outputs;
+    caller_outputs.reserve(num_outputs);
+    for (size_t i = 0; i < num_outputs; ++i) {
+        const auto port = compiled_model_.output(i);
+        caller_outputs.emplace_back(port.get_element_type(), port.get_shape(), output_buffers[i].data);
+    }
+    infer_with_outputs(caller_outputs);
+}
+
+void OVInfer::infer_with_outputs(const std::vector<ov::Tensor>& outputs) {
+    // set_output_tensor() sticks to the infer request, so remember the
+    // plugin-allocated tensors and restore them afterwards; later calls must
+    // not write into memory now owned by the caller.
+    std::vector<ov::Tensor> default_outputs;
+    default_outputs.reserve(outputs.size());
+    auto restore_outputs = [&]() {
+        for (size_t i = 0; i < default_outputs.size(); ++i) {
+            infer_request_.set_output_tensor(i, default_outputs[i]);
+        }
+    };
+    try {
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            default_outputs.push_back(infer_request_.get_output_tensor(i));
+            infer_request_.set_output_tensor(i, outputs[i]);
+        }
+        infer_request_.infer();
+    } catch (...) {
+        restore_outputs();
+        throw;
+    }
+    restore_outputs();
+}
+
+TensorDtype OVInfer::rawDtype(ov::element::Type type) {
+    switch (type) {
+    case ov::element::f32:
+        return TensorDtype::FP32;
+    case ov::element::i32:
+        return TensorDtype::INT32;
+    case ov::element::i64:
+        return TensorDtype::INT64;
+    case ov::element::u8:
+        return TensorDtype::UINT8;
+    default:
+        throw InferenceExecutionException("Unsupported output tensor type for OpenVINO: " + type.get_type_name());
+    }
+}
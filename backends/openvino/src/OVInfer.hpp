@@ -1,26 +1,66 @@
 #pragma once
+#include "ArtifactCache.hpp"
 #include "InferenceInterface.hpp"
 #include "openvino/core/shape.hpp"
 #include "openvino/core/type/element_type.hpp"
 #include "openvino/runtime/core.hpp"
 
+#include <deque>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <vector>
 
 // Adapter: exposes the OpenVINO runtime through the common InferenceInterface contract.
 class OVInfer : public InferenceInterface {
   public:
     OVInfer(const std::string& model_path, bool use_gpu = false, size_t batch_size = 1,
-            const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>());
+            const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>(),
+            const ArtifactCache& artifact_cache = ArtifactCache());
 
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& input_tensors) override;
     std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& input_tensors) override;
+    void infer_into(const std::vector<TensorView>& input_tensors, std::vector<OutputBuffer>& output_buffers) override;
+
+  protected:
+    // Replicas are further infer requests on the same compiled model.
+    std::unique_ptr<InferenceInterface> make_replica() override;
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override;
 
   private:
+    struct ReplicaTag {};
+    OVInfer(OVInfer& source, ReplicaTag);
+
     // Helper function to print ov::Shape and ov::PartialShape
     template <typename ShapeType> std::string print_shape(const ShapeType& shape);
 
-    void bind_inputs_and_infer(const std::vector<std::vector<uint8_t>>& input_tensors);
+    // True when no view carries a shape other than the compiled one.
+    bool uses_compiled_shapes(const std::vector<TensorView>& input_tensors) const;
+    // infer_request_, or for calls with their own input shapes a request on
+    // the model compiled with its declared (dynamic) shapes, built on first use.
+    ov::InferRequest& request_for(const std::vector<TensorView>& input_tensors);
+    void bind_inputs(const std::vector<TensorView>& input_tensors, ov::InferRequest& request);
+    ov::InferRequest& bind_inputs_and_infer(const std::vector<TensorView>& input_tensors);
+    // Runs infer() with the given output tensors bound, then restores the
+    // request's own outputs.
+    void infer_with_outputs(const std::vector<ov::Tensor>& outputs);
+    static TensorDtype rawDtype(ov::element::Type type);
+    // Copies the request's outputs out. Const: finish_async() calls it on
+    // OpenVINO's callback thread, so a failure only throws.
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    variant_outputs(ov::InferRequest& request) const;
+
+    // Native asynchronous calls (start_async on infer_request_).
+    struct AsyncCall {
+        std::shared_ptr<const AsyncInputs> inputs;
+        InferenceCallback done;
+    };
+    void start_next_async();
+    void finish_async(std::exception_ptr error);
 
     static TensorDataType inputTensorDataType(ov::element::Type type);
     static TensorDataType outputTensorDataType(ov::element::Type type);
@@ -30,4 +70,16 @@ class OVInfer : public InferenceInterface {
     ov::InferRequest infer_request_;
     std::shared_ptr<ov::Model> model_;
     ov::CompiledModel compiled_model_;
+    std::string device_;
+
+    // Input shapes as the model file declares them, -1 for dynamic dims.
+    std::vector<std::vector<int64_t>> declared_input_shapes_;
+    ov::CompiledModel dynamic_model_;
+    ov::InferRequest dynamic_request_;
+
+    std::mutex async_mutex_;
+    std::deque<AsyncCall> async_pending_;
+    bool async_running_ = false;
+    AsyncCall async_current_;
+    bool async_callback_set_ = false;
 };
@@ -1,4 +1,5 @@
 #include "OVInfer.hpp"
+#include "RawOutputConformance.hpp"
 
 #include <cstdlib>
 #include <filesystem>
@@ -132,6 +133,21 @@ TEST_F(OpenVINOInferTest, InferenceResults) {
                             [](const TensorElement& element) { return std::holds_alternative<float>(element); }));
 }
 
+// Raw path must stay byte-identical to the variant path
+TEST_F(OpenVINOInferTest, RawMatchesVariant) {
+    OVInfer infer(model_path, false);
+
+    cv::Mat input = cv::Mat::zeros(224, 224, CV_8UC3);
+    cv::Mat blob;
+    cv::dnn::blobFromImage(input, blob, 1.f / 255.f, cv::Size(224, 224), cv::Scalar(), true, false);
+
+    std::vector<uint8_t> input_data(blob.total() * blob.elemSize());
+    memcpy(input_data.data(), blob.data, input_data.size());
+    std::vector<std::vector<uint8_t>> input_tensors = {input_data};
+
+    EXPECT_TRUE(RawMatchesVariant(infer, input_tensors));
+}
+
 // Test metadata retrieval
 TEST_F(OpenVINOInferTest, InferenceMetadataRetrieval) {
     OVInfer infer(model_path, false);
@@ -0,0 +1,169 @@
+#include "ArtifactCache.hpp"
+
+#include "ContentHash.hpp"
+#include "InferenceInterface.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// Keeps a version or id usable as a single path component.
+std::string path_component(const std::string& text) {
+    std::string component = text.empty() ? "unknown" : text;
+    for (char& c : component) {
+        const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '.' ||
+                          c == '-' || c == '_';
+        if (!safe) {
+            c = '_';
+        }
+    }
+    return component;
+}
+
+std::string hex64(uint64_t value) {
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+    return text;
+}
+
+struct HashedModel {
+    uintmax_t size = 0;
+    fs::file_time_type modified;
+    uint64_t hash = 0;
+};
+
+uint64_t hash_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw InferenceException("cannot open model file for hashing: " + path);
+    }
+    ContentHasher hasher;
+    std::vector<char> chunk(1 << 20);
+    while (file) {
+        file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        hasher.update(chunk.data(), static_cast<size_t>(file.gcount()));
+    }
+    if (file.bad()) {
+        throw InferenceException("failed reading model file for hashing: " + path);
+    }
+    return hasher.digest();
+}
+
+} // namespace
+
+ArtifactCache::ArtifactCache(std::string directory) : root_(std::move(directory)) {
+    if (root_.empty()) {
+        const char* env = std::getenv("NEURIPLO_ARTIFACT_CACHE_DIR");
+        if (env != nullptr) {
+            root_ = env;
+        }
+    }
+}
+
+std::string ArtifactCache::backend_directory(const std::string& backend_id, const std::string& backend_version) const {
+    if (!enabled()) {
+        return {};
+    }
+    const fs::path directory = fs::path(root_) / (path_component(backend_id) + "-" + path_component(backend_version));
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (error) {
+        LOG(WARNING) << "artifact cache disabled: cannot create " << directory.string() << ": " << error.message();
+        return {};
+    }
+    return directory.string();
+}
+
+std::string ArtifactCache::artifact_path(const ArtifactKey& key) const {
+    if (!enabled()) {
+        return {};
+    }
+    uint64_t model = 0;
+    std::vector<uint64_t> data;
+    try {
+        model = model_hash(key.model_path);
+        for (const std::string& path : key.data_paths) {
+            data.push_back(model_hash(path));
+        }
+    } catch (const InferenceException& ex) {
+        LOG(WARNING) << "artifact cache skipped: " << ex.what();
+        return {};
+    }
+    const std::string directory = backend_directory(key.backend_id, key.backend_version);
+    if (directory.empty()) {
+        return {};
+    }
+
+    ContentHasher hasher(model);
+    for (const uint64_t file : data) {
+        hasher.update(&file, sizeof(file));
+    }
+    hasher.update_field(key.backend_id);
+    hasher.update_field(key.backend_version);
+    hasher.update_field(key.options);
+    hasher.update_field(key.extension);
+    return (fs::path(directory) / (hex64(hasher.digest()) + key.extension)).string();
+}
+
+std::string ArtifactCache::staging_path(const std::string& artifact) {
+    static std::atomic<uint64_t> counter{0};
+    static const uint64_t process_tag = [] {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ device() ^
+               static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    }();
+    return artifact + ".tmp-" + hex64(process_tag) + "-" + std::to_string(counter.fetch_add(1));
+}
+
+bool ArtifactCache::publish(const std::string& staging, const std::string& artifact) noexcept {
+    std::error_code error;
+    fs::rename(staging, artifact, error);
+    if (error) {
+        LOG(WARNING) << "artifact cache: cannot publish " << artifact << ": " << error.message();
+        discard(staging);
+        return false;
+    }
+    return true;
+}
+
+void ArtifactCache::discard(const std::string& path) noexcept {
+    std::error_code error;
+    fs::remove(path, error);
+}
+
+uint64_t ArtifactCache::model_hash(const std::string& model_path) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, HashedModel> hashed;
+
+    std::error_code error;
+    const uintmax_t size = fs::file_size(model_path, error);
+    const fs::file_time_type modified = error ? fs::file_time_type() : fs::last_write_time(model_path, error);
+    if (error) {
+        throw InferenceException("cannot stat model file " + model_path + ": " + error.message());
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = hashed.find(model_path);
+        if (it != hashed.end() && it->second.size == size && it->second.modified == modified) {
+            return it->second.hash;
+        }
+    }
+    // Hashed outside the lock: concurrent loads of different models do not
+    // wait on each other, and a duplicate hash of the same file is harmless.
+    const uint64_t hash = hash_file(model_path);
+    std::lock_guard<std::mutex> lock(mutex);
+    hashed[model_path] = HashedModel{size, modified, hash};
+    return hash;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What a cached artifact depends on. Two keys address the same artifact only
+// if the model content and every field here match.
+struct ArtifactKey {
+    // Backend id, e.g. "onnxruntime".
+    std::string backend_id;
+    // Version of the runtime library that produced the artifact.
+    std::string backend_version;
+    std::string model_path;
+    // Everything else the artifact depends on (providers, optimization
+    // level, host SIMD level, ...), in any stable textual form.
+    std::string options;
+    // File extension of the artifact, including the dot.
+    std::string extension;
+    // Other files the model's content lives in (e.g. ONNX external data),
+    // hashed along with the model file.
+    std::vector<std::string> data_paths = {};
+};
+
+// Content-addressed on-disk cache of compiled or optimized model artifacts
+// (ORT optimized models, OpenVINO compiled blobs, XNNPACK packed weights),
+// so later process starts skip the expensive load-time work.
+//
+// Layout: <root>/<backend_id>-<backend_version>/<hash><extension>, where the
+// hash covers the content of the model file and its data files, and the
+// key's options. Artifacts are
+// written to a staging file next to their final path and renamed into place,
+// so concurrent processes never see a partial artifact; the last writer wins
+// with identical content.
+//
+// The cache is best effort: every failure logs a warning and reports "no
+// artifact", and the backend loads the model the slow way.
+class ArtifactCache {
+  public:
+    // Rooted at `directory`, or at NEURIPLO_ARTIFACT_CACHE_DIR when empty.
+    // Disabled when both are empty.
+    explicit ArtifactCache(std::string directory = {});
+
+    bool enabled() const noexcept { return !root_.empty(); }
+    const std::string& root() const noexcept { return root_; }
+
+    // Directory for one backend build, created on demand, for runtimes that
+    // manage their own cache files (OpenVINO cache_dir). Empty when disabled
+    // or it cannot be created.
+    std::string backend_directory(const std::string& backend_id, const std::string& backend_version) const;
+
+    // Where the artifact for `key` lives; it may not exist yet. Empty when
+    // disabled or the model file or one of its data files cannot be read.
+    std::string artifact_path(const ArtifactKey& key) const;
+
+    // Unique path next to `artifact` for a backend to write into first.
+    static std::string staging_path(const std::string& artifact);
+    // Moves a finished staging file into place. On failure removes it and
+    // returns false.
+    static bool publish(const std::string& staging, const std::string& artifact) noexcept;
+    // Removes a file that turned out to be unusable, e.g. a cached artifact
+    // the runtime rejected.
+    static void discard(const std::string& path) noexcept;
+
+    // Content hash of a model file, memoized per path, size and mtime.
+    // Throws InferenceException when the file cannot be read.
+    static uint64_t model_hash(const std::string& model_path);
+
+  private:
+    std::string root_;
+};
@@ -0,0 +1,148 @@
+#include "AsyncInference.hpp"
+
+#include <algorithm>
+#include <utility>
+
+AsyncThreadPool::AsyncThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max<size_t>(2, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this] { work(); });
+    }
+}
+
+AsyncThreadPool::~AsyncThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void AsyncThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+}
+
+AsyncThreadPool& AsyncThreadPool::shared() {
+    static AsyncThreadPool pool;
+    return pool;
+}
+
+void AsyncThreadPool::work() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            // Queued tasks still run on shutdown so no caller waits forever.
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        try {
+            task();
+        } catch (...) {
+        }
+    }
+}
+
+SerialExecutor::SerialExecutor() : pool_(nullptr), state_(std::make_shared<State>()) {}
+
+SerialExecutor::SerialExecutor(AsyncThreadPool& pool) : pool_(&pool), state_(std::make_shared<State>()) {}
+
+void SerialExecutor::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->tasks.push_back(std::move(task));
+        if (state_->running) {
+            return;
+        }
+        state_->running = true;
+    }
+    // The drain task holds the state, not the executor.
+    AsyncThreadPool& pool = pool_ != nullptr ? *pool_ : AsyncThreadPool::shared();
+    pool.submit([state = state_] { drain(state); });
+}
+
+void SerialExecutor::drain(const std::shared_ptr<State>& state) {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->tasks.empty()) {
+                state->running = false;
+                return;
+            }
+            task = std::move(state->tasks.front());
+            state->tasks.pop_front();
+        }
+        try {
+            task();
+        } catch (...) {
+        }
+    }
+}
+
+void CompletionQueue::post(std::function<void()> completion) {
+    // Notify under the lock: the drained completion may be the last thing
+    // keeping the queue alive.
+    std::lock_guard<std::mutex> lock(mutex_);
+    completions_.push_back(std::move(completion));
+    ready_.notify_one();
+}
+
+bool CompletionQueue::run_one() {
+    std::function<void()> completion;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return shutdown_ || !completions_.empty(); });
+        if (!pop_locked(completion)) {
+            return false;
+        }
+    }
+    completion();
+    return true;
+}
+
+size_t CompletionQueue::poll() {
+    size_t ran = 0;
+    for (;;) {
+        std::function<void()> completion;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!pop_locked(completion)) {
+                return ran;
+            }
+        }
+        completion();
+        ++ran;
+    }
+}
+
+void CompletionQueue::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    ready_.notify_all();
+}
+
+bool CompletionQueue::pop_locked(std::function<void()>& completion) {
+    if (completions_.empty()) {
+        return false;
+    }
+    completion = std::move(completions_.front());
+    completions_.pop_front();
+    return true;
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "TensorView.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Building blocks for InferenceInterface::infer_async().
+//
+// Backends without native asynchronous execution run their synchronous
+// inference on AsyncThreadPool::shared(), one call at a time per instance
+// (SerialExecutor), since a single backend instance is not safe to call
+// concurrently. Callback completions can be handed to a CompletionQueue so
+// they run on a thread the application chooses instead of an inference
+// thread.
+
+// Inputs of an asynchronous call. Owning tensors are moved in and kept alive
+// until the call completes; views must stay valid until then.
+class AsyncInputs {
+  public:
+    AsyncInputs(std::vector<std::vector<uint8_t>> tensors)
+        : owned_(std::move(tensors)), views_(make_tensor_views(owned_)) {}
+    AsyncInputs(std::vector<TensorView> views) : views_(std::move(views)) {}
+
+    // Moving the outer vector keeps every tensor's storage in place, so the
+    // views stay valid; a copy would leave them pointing at the source.
+    AsyncInputs(AsyncInputs&&) noexcept = default;
+    AsyncInputs& operator=(AsyncInputs&&) noexcept = default;
+    AsyncInputs(const AsyncInputs&) = delete;
+    AsyncInputs& operator=(const AsyncInputs&) = delete;
+
+    const std::vector<TensorView>& views() const noexcept { return views_; }
+
+  private:
+    std::vector<std::vector<uint8_t>> owned_;
+    std::vector<TensorView> views_;
+};
+
+// Fixed-size pool of worker threads running submitted tasks in FIFO order.
+// Tasks report their own errors; an exception escaping a task is dropped.
+class AsyncThreadPool {
+  public:
+    // threads == 0 uses std::thread::hardware_concurrency() (at least 2).
+    explicit AsyncThreadPool(size_t threads = 0);
+    ~AsyncThreadPool();
+
+    AsyncThreadPool(const AsyncThreadPool&) = delete;
+    AsyncThreadPool& operator=(const AsyncThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    size_t size() const noexcept { return workers_.size(); }
+
+    // Process-wide pool behind the default infer_async() implementation.
+    static AsyncThreadPool& shared();
+
+  private:
+    void work();
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+// Runs posted tasks one at a time, in order, on a thread pool. Tasks from
+// different executors run in parallel.
+class SerialExecutor {
+  public:
+    // The default executor runs on AsyncThreadPool::shared(), which is only
+    // started by the first post().
+    SerialExecutor();
+    explicit SerialExecutor(AsyncThreadPool& pool);
+
+    void post(std::function<void()> task);
+
+  private:
+    struct State {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        bool running = false;
+    };
+
+    static void drain(const std::shared_ptr<State>& state);
+
+    AsyncThreadPool* pool_;
+    std::shared_ptr<State> state_;
+};
+
+// Completions posted by asynchronous calls, run by whichever application
+// thread drains the queue.
+class CompletionQueue {
+  public:
+    void post(std::function<void()> completion);
+
+    // Runs the next completion, waiting for one if none is queued. Returns
+    // false once the queue is shut down and empty.
+    bool run_one();
+
+    // Runs every queued completion without waiting; returns how many ran.
+    size_t poll();
+
+    // Wakes blocked run_one() callers; completions already queued still run.
+    void shutdown();
+
+  private:
+    // Takes the next completion; the caller holds mutex_.
+    bool pop_locked(std::function<void()>& completion);
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::function<void()>> completions_;
+    bool shutdown_ = false;
+};
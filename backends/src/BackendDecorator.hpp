@@ -9,6 +9,15 @@
 // Wraps an existing backend and forwards every virtual method to it. Subclasses
 // (e.g. ProfilingBackend) override only the methods they augment, relying on the
 // default pass-through behavior for everything else.
+//
+// Asynchronous calls are forwarded too, so the wrapped backend's native
+// asynchronous execution is kept. Subclasses that observe results wrap the
+// completion (see forward_async()); subclasses that change results override
+// start_async() with InferenceInterface::start_async(), which runs their own
+// get_infer_results() instead.
+//
+// A replica of a decorated backend is a replica of the wrapped backend,
+// wrapped again by rewrap(), so decorated pools still share weights.
 class BackendDecorator : public InferenceInterface {
 
   public:
@@ -21,15 +30,30 @@ class BackendDecorator : public InferenceInterface {
         inner_ = std::move(inner);
     }
 
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        return inner_->get_infer_results(inputs);
+    }
+
+    // Owning inputs are adapted to views and dispatched through this, so
+    // subclasses augment the view overload only and both entry points see it.
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
-        return inner_->get_infer_results(input_tensors);
+        return this->get_infer_results(make_tensor_views(input_tensors));
     }
 
-    // get_infer_results_raw is deliberately NOT forwarded to inner_: the base
-    // default routes through this->get_infer_results(), so subclasses that
-    // augment the variant path (caching, quantization, ...) keep their
-    // behavior on the raw path too.
+    // The view overload of get_infer_results_raw and infer_into are
+    // deliberately NOT forwarded to inner_: the base defaults route through
+    // this->get_infer_results(), so a subclass that augments only the variant
+    // path keeps its behavior on the raw and caller-buffer paths too.
+    // Subclasses that handle raw outputs natively override the view overload
+    // and call forward_raw(); infer_into then follows their raw path.
+    using InferenceInterface::get_infer_results_raw;
+
+    std::vector<RawOutputTensor>
+    get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        return this->get_infer_results_raw(make_tensor_views(input_tensors));
+    }
 
     InferenceMetadata get_inference_metadata() override { return inner_->get_inference_metadata(); }
 
@@ -49,5 +73,37 @@ class BackendDecorator : public InferenceInterface {
     InferenceInterface* inner() const noexcept { return inner_.get(); }
 
   protected:
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override {
+        forward_async(std::move(inputs), std::move(done));
+    }
+
+    // Raw inference on the wrapped backend, without variant conversion.
+    std::vector<RawOutputTensor> forward_raw(const std::vector<TensorView>& inputs) {
+        return inner_->get_infer_results_raw(inputs);
+    }
+
+    // Wraps `inner`, a replica of the wrapped backend, the way this decorator
+    // wraps inner_. The default returns nullptr, so decorators that do not
+    // implement it have no replicas.
+    virtual std::unique_ptr<InferenceInterface> rewrap(std::unique_ptr<InferenceInterface> inner) {
+        (void)inner;
+        return nullptr;
+    }
+
+    std::unique_ptr<InferenceInterface> make_replica() override {
+        std::unique_ptr<InferenceInterface> inner = inner_->create_replica();
+        return inner ? rewrap(std::move(inner)) : nullptr;
+    }
+
+    // Asynchronous inference on the wrapped backend; `done` runs on whichever
+    // thread completes it.
+    void forward_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) {
+        // The views point into `inputs`, which the completion keeps alive.
+        inner_->infer_async(AsyncInputs(inputs->views()),
+                            [inputs, done = std::move(done)](std::exception_ptr error, auto results) {
+                                done(std::move(error), std::move(results));
+                            });
+    }
+
     std::unique_ptr<InferenceInterface> inner_;
 };
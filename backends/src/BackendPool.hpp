@@ -0,0 +1,253 @@
+#pragma once
+#include "InferenceInterface.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Pool of interchangeable backend instances presented as one InferenceInterface.
+//
+// Backends are not safe to call concurrently (they own one session, infer
+// request or context each), so serving many threads from one instance means
+// serializing them. BackendPool owns N instances of the same model and gives
+// every call exclusive use of one of them for its duration: up to N calls run
+// in parallel, and further callers block until an instance is returned.
+//
+// Idle instances sit on a lock-free free-list (a Treiber stack of indices with
+// an ABA tag), so acquiring and returning an instance is a single CAS while
+// any is idle. Only callers that find the pool exhausted touch the mutex and
+// condition variable, and returns only signal when someone is waiting.
+//
+// setup_backend_pool() builds the instances from EngineOptions, sharing
+// weights through InferenceInterface::create_replica() where the framework
+// supports it. Results are exactly those of the instance that served the call.
+class BackendPool : public InferenceInterface {
+  public:
+    // Takes ownership of the instances; they must all serve the same model.
+    // Metadata and utility queries report the first instance.
+    explicit BackendPool(std::vector<std::unique_ptr<InferenceInterface>> instances)
+        : InferenceInterface(first_instance(instances).get_model_path(), first_instance(instances).is_gpu_available(),
+                             first_instance(instances).get_batch_size(), std::vector<std::vector<int64_t>>()),
+          instances_(std::move(instances)), next_(new std::atomic<uint32_t>[instances_.size()]) {
+        if (instances_.size() >= kEmpty) {
+            throw InferenceException("BackendPool holds at most " + std::to_string(kEmpty - 1) + " instances");
+        }
+        for (uint32_t i = 0; i < instances_.size(); ++i) {
+            next_[i].store(i + 1 < instances_.size() ? i + 1 : kEmpty, std::memory_order_relaxed);
+        }
+        head_.store(0, std::memory_order_release);
+    }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        Lease lease(*this);
+        auto result = lease->get_infer_results(input_tensors);
+        lease.record();
+        return result;
+    }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        Lease lease(*this);
+        auto result = lease->get_infer_results(inputs);
+        lease.record();
+        return result;
+    }
+
+    std::vector<RawOutputTensor>
+    get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        Lease lease(*this);
+        auto result = lease->get_infer_results_raw(input_tensors);
+        lease.record();
+        return result;
+    }
+
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override {
+        Lease lease(*this);
+        auto result = lease->get_infer_results_raw(inputs);
+        lease.record();
+        return result;
+    }
+
+    void infer_into(const std::vector<TensorView>& inputs, std::vector<OutputBuffer>& outputs) override {
+        Lease lease(*this);
+        lease->infer_into(inputs, outputs);
+        lease.record();
+    }
+
+    // Cached at the first query: instances are busy on other threads later on.
+    InferenceMetadata get_inference_metadata() override {
+        std::call_once(metadata_once_, [this] {
+            Lease lease(*this);
+            inference_metadata_ = lease->get_inference_metadata();
+        });
+        return inference_metadata_;
+    }
+
+    BackendState state() const noexcept override { return instances_.front()->state(); }
+
+    // Loads every instance; call before the pool is shared between threads.
+    void load() override {
+        for (const auto& instance : instances_) {
+            instance->load();
+        }
+    }
+
+    bool is_gpu_available() const noexcept override { return instances_.front()->is_gpu_available(); }
+    size_t get_batch_size() const noexcept override { return instances_.front()->get_batch_size(); }
+    std::string get_model_path() const noexcept override { return instances_.front()->get_model_path(); }
+
+    // Latency of the most recently completed call and completed calls across
+    // the pool.
+    double get_last_inference_time_ms() const noexcept override {
+        return last_inference_time_ms_atomic_.load(std::memory_order_relaxed);
+    }
+    size_t get_total_inferences() const noexcept override {
+        return total_inferences_atomic_.load(std::memory_order_relaxed);
+    }
+
+    // Waits until every instance is idle, then clears them all.
+    void clear_cache() noexcept override {
+        std::lock_guard<std::mutex> lock(clear_mutex_);
+        std::vector<uint32_t> held;
+        held.reserve(instances_.size());
+        while (held.size() < instances_.size()) {
+            held.push_back(acquire());
+        }
+        for (const auto& instance : instances_) {
+            instance->clear_cache();
+        }
+        for (const uint32_t index : held) {
+            release(index);
+        }
+    }
+
+    size_t get_memory_usage_mb() const noexcept override {
+        size_t total = 0;
+        for (const auto& instance : instances_) {
+            total += instance->get_memory_usage_mb();
+        }
+        return total;
+    }
+
+    size_t size() const noexcept { return instances_.size(); }
+    InferenceInterface* instance(size_t index) const noexcept { return instances_.at(index).get(); }
+
+  protected:
+    // Asynchronous calls take an instance on a pool thread; unlike a single
+    // backend, up to size() of them run at once.
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override {
+        AsyncThreadPool::shared().submit(
+            [this, inputs = std::move(inputs), done = std::move(done)] { run_async_inference(*inputs, done); });
+    }
+
+  private:
+    // Free-list terminator; also bounds the pool size.
+    static constexpr uint32_t kEmpty = UINT32_MAX;
+
+    // Exclusive use of one instance for the lifetime of the lease.
+    class Lease {
+      public:
+        explicit Lease(BackendPool& pool) : pool_(pool), index_(pool.acquire()) {}
+        ~Lease() { pool_.release(index_); }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        InferenceInterface* operator->() const noexcept { return pool_.instances_[index_].get(); }
+
+        // Records a completed call in the pool's statistics.
+        void record() noexcept {
+            pool_.last_inference_time_ms_atomic_.store((*this)->get_last_inference_time_ms(),
+                                                       std::memory_order_relaxed);
+            pool_.total_inferences_atomic_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+      private:
+        BackendPool& pool_;
+        uint32_t index_;
+    };
+
+    static const InferenceInterface& first_instance(const std::vector<std::unique_ptr<InferenceInterface>>& instances) {
+        if (instances.empty()) {
+            throw InferenceException("BackendPool requires at least one backend instance");
+        }
+        for (const auto& instance : instances) {
+            if (!instance) {
+                throw InferenceException("BackendPool requires non-null backend instances");
+            }
+        }
+        return *instances.front();
+    }
+
+    static uint64_t pack(uint64_t tag, uint32_t index) noexcept { return (tag << 32) | index; }
+
+    // Pops an idle instance index; false when every instance is busy.
+    bool try_pop(uint32_t& index) noexcept {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        for (;;) {
+            const auto top = static_cast<uint32_t>(head);
+            if (top == kEmpty) {
+                return false;
+            }
+            // next_[top] may be rewritten if another thread pops and pushes
+            // top in the meantime; the tag makes the CAS below fail then.
+            const uint32_t next = next_[top].load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, pack((head >> 32) + 1, next), std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+                index = top;
+                return true;
+            }
+        }
+    }
+
+    void push(uint32_t index) noexcept {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        do {
+            next_[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, pack((head >> 32) + 1, index), std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    uint32_t acquire() {
+        uint32_t index = 0;
+        if (try_pop(index)) {
+            return index;
+        }
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in release(): either the retry below sees the
+        // returned instance, or the returning thread sees this waiter.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!try_pop(index)) {
+            available_.wait(lock);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    void release(uint32_t index) noexcept {
+        push(index);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            available_.notify_one();
+        }
+    }
+
+    std::vector<std::unique_ptr<InferenceInterface>> instances_;
+    std::unique_ptr<std::atomic<uint32_t>[]> next_;
+    std::atomic<uint64_t> head_{pack(0, kEmpty)};
+
+    std::mutex wait_mutex_;
+    std::condition_variable available_;
+    std::atomic<size_t> waiters_{0};
+
+    std::mutex clear_mutex_;
+    std::once_flag metadata_once_;
+    std::atomic<double> last_inference_time_ms_atomic_{0.0};
+    std::atomic<size_t> total_inferences_atomic_{0};
+};
@@ -0,0 +1,176 @@
+#pragma once
+#include "InferenceInterface.hpp"
+
+#include <cstdlib>
+#include <string>
+
+// Framework tuning carried from EngineOptions to the backend factories.
+// Every field defaults to "unset", which keeps the framework's own default;
+// backends ignore blocks that are not theirs.
+
+// Tri-state switch: Default leaves the framework setting alone.
+enum class TuningToggle { Default, On, Off };
+
+// ONNX Runtime session settings. NEURIPLO_ORT_* environment variables fill in
+// fields left unset here (see with_env_defaults()).
+struct OrtTuning {
+    enum class ExecutionMode { Default, Sequential, Parallel };
+    enum class GraphOptimization { Default, Disabled, Basic, Extended, All };
+
+    // 0 keeps ORT's default (one intra-op thread per physical core). Set it
+    // when several sessions share a machine, e.g. in a BackendPool.
+    int intra_op_threads = 0;
+    int inter_op_threads = 0;
+    ExecutionMode execution_mode = ExecutionMode::Default;
+    GraphOptimization graph_optimization = GraphOptimization::Default;
+    // Whether idle intra/inter-op threads spin before sleeping. Off trades
+    // some latency for much less CPU burned between calls.
+    TuningToggle allow_spinning = TuningToggle::Default;
+    TuningToggle cpu_mem_arena = TuningToggle::Default;
+    TuningToggle mem_pattern = TuningToggle::Default;
+
+    // Process-wide settings, fixed by the first ORT backend created in the
+    // process (later backends cannot change them).
+    //
+    // On: every session runs on one intra-op and one inter-op pool owned by
+    // the shared Ort::Env, sized by the thread fields above, instead of a
+    // pool per session. Sessions join existing global pools unless Off.
+    TuningToggle global_thread_pools = TuningToggle::Default;
+    // On: sessions allocate CPU memory from one arena registered on the Env.
+    TuningToggle shared_cpu_allocator = TuningToggle::Default;
+
+    // Sessions loaded from the same model file share prepacked weights
+    // (one copy of the repacked GEMM buffers). Default and On share; Off
+    // keeps a private copy.
+    TuningToggle share_prepacked_weights = TuningToggle::Default;
+
+    // Copy with unset fields taken from NEURIPLO_ORT_INTRA_OP_THREADS,
+    // NEURIPLO_ORT_INTER_OP_THREADS, NEURIPLO_ORT_EXECUTION_MODE
+    // (sequential|parallel), NEURIPLO_ORT_GRAPH_OPTIMIZATION
+    // (disabled|basic|extended|all), and the 0|1 switches
+    // NEURIPLO_ORT_ALLOW_SPINNING, NEURIPLO_ORT_CPU_MEM_ARENA,
+    // NEURIPLO_ORT_MEM_PATTERN, NEURIPLO_ORT_GLOBAL_THREAD_POOLS,
+    // NEURIPLO_ORT_SHARED_CPU_ALLOCATOR and NEURIPLO_ORT_SHARE_PREPACKED_WEIGHTS.
+    // Throws InferenceException on a malformed value.
+    OrtTuning with_env_defaults() const;
+};
+
+// Memory-mapped model loading (see MappedModel).
+struct MmapTuning {
+    // Default maps model files for the backends that gain from it (TensorRT,
+    // LiteRT, ExecuTorch); On also maps them for ONNX Runtime; Off leaves
+    // reading to each framework.
+    TuningToggle enabled = TuningToggle::Default;
+    // On: fault every page in at load (MAP_POPULATE, MADV_WILLNEED) rather
+    // than on first touch.
+    TuningToggle prefault = TuningToggle::Default;
+    // On: lock mapped pages in RAM (mlock). Needs RLIMIT_MEMLOCK headroom; a
+    // failed lock only logs a warning.
+    TuningToggle lock = TuningToggle::Default;
+
+    // Copy with unset fields taken from the 0|1 switches NEURIPLO_MMAP,
+    // NEURIPLO_MMAP_PREFAULT and NEURIPLO_MMAP_LOCK. Throws
+    // InferenceException on a malformed value.
+    MmapTuning with_env_defaults() const;
+};
+
+struct BackendTuning {
+    OrtTuning ort;
+    MmapTuning mmap;
+    // Root of the on-disk artifact cache (see ArtifactCache) shared by all
+    // backends; empty falls back to NEURIPLO_ARTIFACT_CACHE_DIR.
+    std::string artifact_cache_dir;
+};
+
+namespace backend_tuning_detail {
+
+inline const char* env_value(const char* name) {
+    const char* value = std::getenv(name);
+    return value != nullptr && value[0] != '\0' ? value : nullptr;
+}
+
+[[noreturn]] inline void bad_env_value(const char* name, const std::string& value, const char* expected) {
+    throw InferenceException(std::string(name) + "='" + value + "' is not valid; expected " + expected);
+}
+
+inline void env_threads(const char* name, int& field) {
+    const char* value = env_value(name);
+    if (field != 0 || value == nullptr) {
+        return;
+    }
+    char* end = nullptr;
+    const long threads = std::strtol(value, &end, 10);
+    if (*end != '\0' || threads < 0 || threads > 4096) {
+        bad_env_value(name, value, "a thread count");
+    }
+    field = static_cast<int>(threads);
+}
+
+inline void env_toggle(const char* name, TuningToggle& field) {
+    const char* value = env_value(name);
+    if (field != TuningToggle::Default || value == nullptr) {
+        return;
+    }
+    const std::string text = value;
+    if (text == "1" || text == "true") {
+        field = TuningToggle::On;
+    } else if (text == "0" || text == "false") {
+        field = TuningToggle::Off;
+    } else {
+        bad_env_value(name, text, "0 or 1");
+    }
+}
+
+} // namespace backend_tuning_detail
+
+inline OrtTuning OrtTuning::with_env_defaults() const {
+    using namespace backend_tuning_detail;
+    OrtTuning tuning = *this;
+    env_threads("NEURIPLO_ORT_INTRA_OP_THREADS", tuning.intra_op_threads);
+    env_threads("NEURIPLO_ORT_INTER_OP_THREADS", tuning.inter_op_threads);
+
+    const char* mode = env_value("NEURIPLO_ORT_EXECUTION_MODE");
+    if (tuning.execution_mode == ExecutionMode::Default && mode != nullptr) {
+        const std::string text = mode;
+        if (text == "sequential") {
+            tuning.execution_mode = ExecutionMode::Sequential;
+        } else if (text == "parallel") {
+            tuning.execution_mode = ExecutionMode::Parallel;
+        } else {
+            bad_env_value("NEURIPLO_ORT_EXECUTION_MODE", text, "sequential or parallel");
+        }
+    }
+
+    const char* level = env_value("NEURIPLO_ORT_GRAPH_OPTIMIZATION");
+    if (tuning.graph_optimization == GraphOptimization::Default && level != nullptr) {
+        const std::string text = level;
+        if (text == "disabled") {
+            tuning.graph_optimization = GraphOptimization::Disabled;
+        } else if (text == "basic") {
+            tuning.graph_optimization = GraphOptimization::Basic;
+        } else if (text == "extended") {
+            tuning.graph_optimization = GraphOptimization::Extended;
+        } else if (text == "all") {
+            tuning.graph_optimization = GraphOptimization::All;
+        } else {
+            bad_env_value("NEURIPLO_ORT_GRAPH_OPTIMIZATION", text, "disabled, basic, extended or all");
+        }
+    }
+
+    env_toggle("NEURIPLO_ORT_ALLOW_SPINNING", tuning.allow_spinning);
+    env_toggle("NEURIPLO_ORT_CPU_MEM_ARENA", tuning.cpu_mem_arena);
+    env_toggle("NEURIPLO_ORT_MEM_PATTERN", tuning.mem_pattern);
+    env_toggle("NEURIPLO_ORT_GLOBAL_THREAD_POOLS", tuning.global_thread_pools);
+    env_toggle("NEURIPLO_ORT_SHARED_CPU_ALLOCATOR", tuning.shared_cpu_allocator);
+    env_toggle("NEURIPLO_ORT_SHARE_PREPACKED_WEIGHTS", tuning.share_prepacked_weights);
+    return tuning;
+}
+
+inline MmapTuning MmapTuning::with_env_defaults() const {
+    using namespace backend_tuning_detail;
+    MmapTuning tuning = *this;
+    env_toggle("NEURIPLO_MMAP", tuning.enabled);
+    env_toggle("NEURIPLO_MMAP_PREFAULT", tuning.prefault);
+    env_toggle("NEURIPLO_MMAP_LOCK", tuning.lock);
+    return tuning;
+}
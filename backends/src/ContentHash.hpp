@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Fast non-cryptographic 64-bit hash of byte content, for cache keys.
+//
+// Consumes eight bytes per step (a multiply-rotate-multiply mix per word,
+// MurmurHash-style) and finishes with a 64-bit avalanche over the state and
+// total length. Streaming is equivalent to hashing the concatenation, so
+// feeding a file in chunks gives the same value as hashing it at once.
+// Not collision-resistant against adversarial input; callers that key on it
+// also compare something cheap (size, shape) where a collision would matter.
+class ContentHasher {
+  public:
+    explicit ContentHasher(uint64_t seed = 0) noexcept : state_(seed ^ kSeedMix) {}
+
+    void update(const void* data, size_t size) noexcept {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        length_ += size;
+        if (pending_size_ > 0) {
+            const size_t take = size < 8 - pending_size_ ? size : 8 - pending_size_;
+            std::memcpy(pending_ + pending_size_, bytes, take);
+            pending_size_ += take;
+            bytes += take;
+            size -= take;
+            if (pending_size_ < 8) {
+                return;
+            }
+            mix_word(load_word(pending_));
+            pending_size_ = 0;
+        }
+        for (; size >= 8; bytes += 8, size -= 8) {
+            mix_word(load_word(bytes));
+        }
+        std::memcpy(pending_, bytes, size);
+        pending_size_ = size;
+    }
+
+    void update(const std::string& text) noexcept { update(text.data(), text.size()); }
+
+    // Adds a length prefix, so ("ab", "c") and ("a", "bc") hash differently.
+    void update_field(const std::string& text) noexcept {
+        const uint64_t size = text.size();
+        update(&size, sizeof(size));
+        update(text);
+    }
+
+    // Hash of everything fed so far; more data may follow.
+    uint64_t digest() const noexcept {
+        uint64_t state = state_;
+        if (pending_size_ > 0) {
+            unsigned char tail[8] = {0};
+            std::memcpy(tail, pending_, pending_size_);
+            state ^= scramble(load_word(tail));
+        }
+        return avalanche(state ^ length_);
+    }
+
+  private:
+    static constexpr uint64_t kSeedMix = 0x9e3779b97f4a7c15ULL;
+    static constexpr uint64_t kMul1 = 0x87c37b91114253d5ULL;
+    static constexpr uint64_t kMul2 = 0x4cf5ad432745937fULL;
+
+    static uint64_t load_word(const unsigned char* bytes) noexcept {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        return word;
+    }
+
+    static uint64_t rotl(uint64_t value, int bits) noexcept { return (value << bits) | (value >> (64 - bits)); }
+
+    static uint64_t scramble(uint64_t word) noexcept { return rotl(word * kMul1, 31) * kMul2; }
+
+    static uint64_t avalanche(uint64_t value) noexcept {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+    void mix_word(uint64_t word) noexcept {
+        state_ ^= scramble(word);
+        state_ = rotl(state_, 27) * 5 + 0x52dce729;
+    }
+
+    uint64_t state_;
+    uint64_t length_ = 0;
+    unsigned char pending_[8] = {0};
+    size_t pending_size_ = 0;
+};
+
+// One-shot hash of a buffer.
+inline uint64_t content_hash(const void* data, size_t size, uint64_t seed = 0) noexcept {
+    ContentHasher hasher(seed);
+    hasher.update(data, size);
+    return hasher.digest();
+}
+
+// 128-bit result of content_hash128().
+struct ContentHash128 {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const ContentHash128& other) const noexcept { return low == other.low && high == other.high; }
+    bool operator!=(const ContentHash128& other) const noexcept { return !(*this == other); }
+};
+
+namespace content_hash_detail {
+
+constexpr uint64_t kPrime1 = 0x9e3779b185ebca87ULL;
+constexpr uint64_t kPrime2 = 0xc2b2ae3d27d4eb4fULL;
+constexpr uint64_t kPrime3 = 0x165667b19e3779f9ULL;
+constexpr uint64_t kPrime4 = 0x85ebca77c2b2ae63ULL;
+constexpr uint64_t kPrime5 = 0x27d4eb2f165667c5ULL;
+
+inline uint64_t load(const unsigned char* bytes) noexcept {
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+inline uint64_t rotl(uint64_t value, int bits) noexcept { return (value << bits) | (value >> (64 - bits)); }
+
+inline uint64_t mix_lane(uint64_t acc, uint64_t word) noexcept { return rotl(acc + word * kPrime2, 31) * kPrime1; }
+
+inline uint64_t merge(uint64_t acc, uint64_t lane) noexcept { return (acc ^ mix_lane(0, lane)) * kPrime1 + kPrime4; }
+
+inline uint64_t avalanche(uint64_t value) noexcept {
+    value ^= value >> 33;
+    value *= kPrime2;
+    value ^= value >> 29;
+    value *= kPrime3;
+    value ^= value >> 32;
+    return value;
+}
+
+} // namespace content_hash_detail
+
+// One-shot 128-bit hash for large buffers such as inference inputs.
+//
+// Four independent lanes take 32 bytes per step (xxHash-style), so their
+// multiplies pipeline instead of forming ContentHasher's single dependency
+// chain; from a few kilobytes up it runs several times faster. The two
+// halves mix the lanes differently, which makes a 128-bit value usable as a
+// fingerprint for non-adversarial content. Values may change between
+// releases, so do not persist them; ContentHasher is the stable one.
+inline ContentHash128 content_hash128(const void* data, size_t size, uint64_t seed = 0) noexcept {
+    using namespace content_hash_detail;
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    const size_t length = size;
+
+    uint64_t low = seed + kPrime5;
+    uint64_t high = seed ^ kPrime3;
+    if (size >= 32) {
+        uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+        for (; size >= 32; bytes += 32, size -= 32) {
+            lanes[0] = mix_lane(lanes[0], load(bytes));
+            lanes[1] = mix_lane(lanes[1], load(bytes + 8));
+            lanes[2] = mix_lane(lanes[2], load(bytes + 16));
+            lanes[3] = mix_lane(lanes[3], load(bytes + 24));
+        }
+        low = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+        high = rotl(lanes[0], 41) ^ rotl(lanes[1], 29) ^ rotl(lanes[2], 17) ^ rotl(lanes[3], 5);
+        for (const uint64_t lane : lanes) {
+            low = merge(low, lane);
+            high = merge(high, rotl(lane, 23));
+        }
+    }
+
+    for (; size >= 8; bytes += 8, size -= 8) {
+        const uint64_t word = load(bytes);
+        low = rotl(low ^ mix_lane(0, word), 27) * kPrime1 + kPrime4;
+        high = rotl(high ^ mix_lane(kPrime3, word), 31) * kPrime2 + kPrime5;
+    }
+    if (size > 0) {
+        unsigned char tail[8] = {0};
+        std::memcpy(tail, bytes, size);
+        const uint64_t word = load(tail);
+        low = rotl(low ^ mix_lane(0, word), 27) * kPrime1 + kPrime4;
+        high = rotl(high ^ mix_lane(kPrime3, word), 31) * kPrime2 + kPrime5;
+    }
+
+    ContentHash128 hash;
+    hash.low = avalanche(low + length);
+    hash.high = avalanche(high ^ (length * kPrime1) ^ hash.low);
+    return hash;
+}
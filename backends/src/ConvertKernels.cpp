@@ -0,0 +1,663 @@
+#include "ConvertKernels.hpp"
+
+#include "InferenceInterface.hpp"
+
+#include <cstring>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NEURIPLO_CONVERT_X86 1
+#include <immintrin.h>
+#define NEURIPLO_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#define NEURIPLO_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#elif defined(__aarch64__)
+#define NEURIPLO_CONVERT_NEON 1
+#include <arm_neon.h>
+#endif
+
+float fp16_to_fp32(uint16_t half) noexcept {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1Fu;
+    uint32_t mantissa = half & 0x3FFu;
+
+    uint32_t bits;
+    if (exponent == 0x1Fu) {
+        // Inf stays Inf; NaN keeps its payload and becomes quiet, as F16C/NEON do.
+        bits = sign | 0x7F800000u | (mantissa << 13) | (mantissa != 0 ? 0x400000u : 0u);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        // Subnormal half: renormalize, every one is a normal float.
+        uint32_t float_exponent = 113;
+        while ((mantissa & 0x400u) == 0) {
+            mantissa <<= 1;
+            --float_exponent;
+        }
+        bits = sign | (float_exponent << 23) | ((mantissa & 0x3FFu) << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint16_t fp32_to_fp16(float value) noexcept {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t magnitude = bits & 0x7FFFFFFFu;
+
+    if (magnitude > 0x7F800000u) {
+        return static_cast<uint16_t>(sign | 0x7E00u | ((magnitude >> 13) & 0x3FFu));
+    }
+    if (magnitude >= 0x477FF000u) {
+        // At or above 65520 (halfway past the largest half), including Inf.
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (magnitude >= 0x38800000u) {
+        // Normal half: rebias the exponent and round the dropped 13 bits to
+        // nearest even. A carry out of the mantissa bumps the exponent.
+        const uint32_t rounded = magnitude + 0xFFFu + ((magnitude >> 13) & 1u);
+        return static_cast<uint16_t>(sign | ((rounded - 0x38000000u) >> 13));
+    }
+    if (magnitude <= 0x33000000u) {
+        // At most 2^-25, half the smallest subnormal: ties to even give zero.
+        return sign;
+    }
+
+    // Subnormal half: value / 2^-24 rounded to nearest even.
+    const uint32_t exponent = magnitude >> 23;
+    const uint32_t mantissa = (magnitude & 0x7FFFFFu) | 0x800000u;
+    const uint32_t shift = 126u - exponent;
+    uint32_t quotient = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+    const uint32_t halfway = 1u << (shift - 1u);
+    if (remainder > halfway || (remainder == halfway && (quotient & 1u) != 0)) {
+        ++quotient;
+    }
+    return static_cast<uint16_t>(sign | quotient);
+}
+
+namespace {
+
+using Kernel = void (*)(const void* src, void* dst, size_t count);
+
+// One entry per non-trivial conversion. Same-type copies are a plain memcpy
+// and do not go through the table.
+struct Kernels {
+    Kernel normalize_bool;
+    Kernel f16_to_f32;
+    Kernel f32_to_f16;
+    Kernel i8_to_i32;
+    Kernel u8_to_i32;
+    Kernel i8_to_f32;
+    Kernel u8_to_f32;
+    Kernel i32_to_i64;
+    Kernel i64_to_i32;
+};
+
+// Scalar reference kernels. They also finish the tails of the SIMD kernels,
+// which is what keeps every level bit-identical. Elements are read and written
+// through memcpy so unaligned buffers are fine.
+
+template <typename Src, typename Dst> void convert_scalar(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; ++i) {
+        Src value;
+        std::memcpy(&value, in + i * sizeof(Src), sizeof(Src));
+        const auto converted = static_cast<Dst>(value);
+        std::memcpy(out + i * sizeof(Dst), &converted, sizeof(Dst));
+    }
+}
+
+void normalize_bool_scalar(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = in[i] != 0 ? 1 : 0;
+    }
+}
+
+void f16_to_f32_scalar(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t half;
+        std::memcpy(&half, in + i * 2, sizeof(half));
+        const float value = fp16_to_fp32(half);
+        std::memcpy(out + i * 4, &value, sizeof(value));
+    }
+}
+
+void f32_to_f16_scalar(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    for (size_t i = 0; i < count; ++i) {
+        float value;
+        std::memcpy(&value, in + i * 4, sizeof(value));
+        const uint16_t half = fp32_to_fp16(value);
+        std::memcpy(out + i * 2, &half, sizeof(half));
+    }
+}
+
+constexpr Kernels kScalarKernels{
+    normalize_bool_scalar,
+    f16_to_f32_scalar,
+    f32_to_f16_scalar,
+    convert_scalar<int8_t, int32_t>,
+    convert_scalar<uint8_t, int32_t>,
+    convert_scalar<int8_t, float>,
+    convert_scalar<uint8_t, float>,
+    convert_scalar<int32_t, int64_t>,
+    convert_scalar<int64_t, int32_t>,
+};
+
+#if defined(NEURIPLO_CONVERT_X86)
+
+// AVX2 + F16C (x86-64-v3). Intrinsics cannot be shared through lambdas or
+// templates without losing the target attribute, so each loop is spelled out.
+
+NEURIPLO_TARGET_AVX2 void normalize_bool_avx2(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    const __m256i one = _mm256_set1_epi8(1);
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_min_epu8(bytes, one));
+    }
+    normalize_bool_scalar(in + i, out + i, count - i);
+}
+
+NEURIPLO_TARGET_AVX2 void f16_to_f32_avx2(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + i * 4), _mm256_cvtph_ps(half));
+    }
+    f16_to_f32_scalar(in + i * 2, out + i * 4, count - i);
+}
+
+NEURIPLO_TARGET_AVX2 void f32_to_f16_avx2(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 value = _mm256_loadu_ps(reinterpret_cast<const float*>(in + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2),
+                         _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    }
+    f32_to_f16_scalar(in + i * 4, out + i * 2, count - i);
+}
+
+NEURIPLO_TARGET_AVX2 void i8_to_i32_avx2(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), _mm256_cvtepi8_epi32(bytes));
+    }
+    convert_scalar<int8_t, int32_t>(in + i, out + i * 4, count - i);
+}
+
+NEURIPLO_TARGET_AVX2 void u8_to_i32_avx2(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), _mm256_cvtepu8_epi32(bytes));
+    }
+    convert_scalar<uint8_t, int32_t>(in + i, out + i * 4, count - i);
+}
+
+NEURIPLO_TARGET_AVX2 void i8_to_f32_avx2(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + i * 4), _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(bytes)));
+    }
+    convert_scalar<int8_t, float>(in + i, out + i * 4, count - i);
+}
+
+NEURIPLO_TARGET_AVX2 void u8_to_f32_avx2(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i));
+        _mm256_storeu_ps(reinterpret_cast<float*>(out + i * 4), _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes)));
+    }
+    convert_scalar<uint8_t, float>(in + i, out + i * 4, count - i);
+}
+
+NEURIPLO_TARGET_AVX2 void i32_to_i64_avx2(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 8), _mm256_cvtepi32_epi64(value));
+    }
+    convert_scalar<int32_t, int64_t>(in + i * 4, out + i * 8, count - i);
+}
+
+NEURIPLO_TARGET_AVX2 void i64_to_i32_avx2(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    // Gathers the low dword of each qword into the low 128 bits.
+    const __m256i low_dwords = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 8));
+        const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 8 + 32));
+        const __m256i packed = _mm256_permute2x128_si256(_mm256_permutevar8x32_epi32(first, low_dwords),
+                                                         _mm256_permutevar8x32_epi32(second, low_dwords), 0x20);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), packed);
+    }
+    convert_scalar<int64_t, int32_t>(in + i * 8, out + i * 4, count - i);
+}
+
+constexpr Kernels kAvx2Kernels{
+    normalize_bool_avx2, f16_to_f32_avx2, f32_to_f16_avx2, i8_to_i32_avx2,  u8_to_i32_avx2,
+    i8_to_f32_avx2,      u8_to_f32_avx2,  i32_to_i64_avx2, i64_to_i32_avx2,
+};
+
+// AVX-512 F + BW (Skylake-SP and later). GCC 12's AVX-512 intrinsics seed
+// their pass-through operand with _mm*_undefined_*(), which trips a spurious
+// -Wmaybe-uninitialized once inlined.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+NEURIPLO_TARGET_AVX512 void normalize_bool_avx512(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    const __m512i one = _mm512_set1_epi8(1);
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        const __m512i bytes = _mm512_loadu_si512(in + i);
+        _mm512_storeu_si512(out + i, _mm512_min_epu8(bytes, one));
+    }
+    normalize_bool_scalar(in + i, out + i, count - i);
+}
+
+NEURIPLO_TARGET_AVX512 void f16_to_f32_avx512(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i half = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 2));
+        _mm512_storeu_ps(out + i * 4, _mm512_cvtph_ps(half));
+    }
+    f16_to_f32_scalar(in + i * 2, out + i * 4, count - i);
+}
+
+NEURIPLO_TARGET_AVX512 void f32_to_f16_avx512(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512 value = _mm512_loadu_ps(in + i * 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2),
+                            _mm512_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    }
+    f32_to_f16_scalar(in + i * 4, out + i * 2, count - i);
+}
+
+NEURIPLO_TARGET_AVX512 void i8_to_i32_avx512(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm512_storeu_si512(out + i * 4, _mm512_cvtepi8_epi32(bytes));
+    }
+    convert_scalar<int8_t, int32_t>(in + i, out + i * 4, count - i);
+}
+
+NEURIPLO_TARGET_AVX512 void u8_to_i32_avx512(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm512_storeu_si512(out + i * 4, _mm512_cvtepu8_epi32(bytes));
+    }
+    convert_scalar<uint8_t, int32_t>(in + i, out + i * 4, count - i);
+}
+
+NEURIPLO_TARGET_AVX512 void i8_to_f32_avx512(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm512_storeu_ps(out + i * 4, _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(bytes)));
+    }
+    convert_scalar<int8_t, float>(in + i, out + i * 4, count - i);
+}
+
+NEURIPLO_TARGET_AVX512 void u8_to_f32_avx512(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm512_storeu_ps(out + i * 4, _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(bytes)));
+    }
+    convert_scalar<uint8_t, float>(in + i, out + i * 4, count - i);
+}
+
+NEURIPLO_TARGET_AVX512 void i32_to_i64_avx512(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 4));
+        _mm512_storeu_si512(out + i * 8, _mm512_cvtepi32_epi64(value));
+    }
+    convert_scalar<int32_t, int64_t>(in + i * 4, out + i * 8, count - i);
+}
+
+NEURIPLO_TARGET_AVX512 void i64_to_i32_avx512(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512i value = _mm512_loadu_si512(in + i * 8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), _mm512_cvtepi64_epi32(value));
+    }
+    convert_scalar<int64_t, int32_t>(in + i * 8, out + i * 4, count - i);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+constexpr Kernels kAvx512Kernels{
+    normalize_bool_avx512, f16_to_f32_avx512, f32_to_f16_avx512, i8_to_i32_avx512,  u8_to_i32_avx512,
+    i8_to_f32_avx512,      u8_to_f32_avx512,  i32_to_i64_avx512, i64_to_i32_avx512,
+};
+
+#elif defined(NEURIPLO_CONVERT_NEON)
+
+// AArch64 Advanced SIMD, always present. fp16 conversions follow FPCR, whose
+// default rounding mode is round-to-nearest-even.
+
+void normalize_bool_neon(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    const uint8x16_t one = vdupq_n_u8(1);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        vst1q_u8(out + i, vminq_u8(vld1q_u8(in + i), one));
+    }
+    normalize_bool_scalar(in + i, out + i, count - i);
+}
+
+void f16_to_f32_neon(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint16x8_t half = vld1q_u16(reinterpret_cast<const uint16_t*>(in + i * 2));
+        auto* floats = reinterpret_cast<float*>(out + i * 4);
+        vst1q_f32(floats, vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(half))));
+        vst1q_f32(floats + 4, vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(half))));
+    }
+    f16_to_f32_scalar(in + i * 2, out + i * 4, count - i);
+}
+
+void f32_to_f16_neon(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto* floats = reinterpret_cast<const float*>(in + i * 4);
+        const uint16x4_t low = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(floats)));
+        const uint16x4_t high = vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(floats + 4)));
+        vst1q_u16(reinterpret_cast<uint16_t*>(out + i * 2), vcombine_u16(low, high));
+    }
+    f32_to_f16_scalar(in + i * 4, out + i * 2, count - i);
+}
+
+void i8_to_i32_neon(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t wide = vmovl_s8(vld1_s8(reinterpret_cast<const int8_t*>(in + i)));
+        auto* ints = reinterpret_cast<int32_t*>(out + i * 4);
+        vst1q_s32(ints, vmovl_s16(vget_low_s16(wide)));
+        vst1q_s32(ints + 4, vmovl_s16(vget_high_s16(wide)));
+    }
+    convert_scalar<int8_t, int32_t>(in + i, out + i * 4, count - i);
+}
+
+void u8_to_i32_neon(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint16x8_t wide = vmovl_u8(vld1_u8(in + i));
+        auto* ints = reinterpret_cast<int32_t*>(out + i * 4);
+        vst1q_s32(ints, vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(wide))));
+        vst1q_s32(ints + 4, vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(wide))));
+    }
+    convert_scalar<uint8_t, int32_t>(in + i, out + i * 4, count - i);
+}
+
+void i8_to_f32_neon(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t wide = vmovl_s8(vld1_s8(reinterpret_cast<const int8_t*>(in + i)));
+        auto* floats = reinterpret_cast<float*>(out + i * 4);
+        vst1q_f32(floats, vcvtq_f32_s32(vmovl_s16(vget_low_s16(wide))));
+        vst1q_f32(floats + 4, vcvtq_f32_s32(vmovl_s16(vget_high_s16(wide))));
+    }
+    convert_scalar<int8_t, float>(in + i, out + i * 4, count - i);
+}
+
+void u8_to_f32_neon(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint16x8_t wide = vmovl_u8(vld1_u8(in + i));
+        auto* floats = reinterpret_cast<float*>(out + i * 4);
+        vst1q_f32(floats, vcvtq_f32_u32(vmovl_u16(vget_low_u16(wide))));
+        vst1q_f32(floats + 4, vcvtq_f32_u32(vmovl_u16(vget_high_u16(wide))));
+    }
+    convert_scalar<uint8_t, float>(in + i, out + i * 4, count - i);
+}
+
+void i32_to_i64_neon(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const int32x4_t value = vld1q_s32(reinterpret_cast<const int32_t*>(in + i * 4));
+        auto* longs = reinterpret_cast<int64_t*>(out + i * 8);
+        vst1q_s64(longs, vmovl_s32(vget_low_s32(value)));
+        vst1q_s64(longs + 2, vmovl_s32(vget_high_s32(value)));
+    }
+    convert_scalar<int32_t, int64_t>(in + i * 4, out + i * 8, count - i);
+}
+
+void i64_to_i32_neon(const void* src, void* dst, size_t count) {
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const auto* longs = reinterpret_cast<const int64_t*>(in + i * 8);
+        const int32x4_t packed = vcombine_s32(vmovn_s64(vld1q_s64(longs)), vmovn_s64(vld1q_s64(longs + 2)));
+        vst1q_s32(reinterpret_cast<int32_t*>(out + i * 4), packed);
+    }
+    convert_scalar<int64_t, int32_t>(in + i * 8, out + i * 4, count - i);
+}
+
+constexpr Kernels kNeonKernels{
+    normalize_bool_neon, f16_to_f32_neon, f32_to_f16_neon, i8_to_i32_neon,  u8_to_i32_neon,
+    i8_to_f32_neon,      u8_to_f32_neon,  i32_to_i64_neon, i64_to_i32_neon,
+};
+
+#endif
+
+SimdLevel detect_simd_level() noexcept {
+#if defined(NEURIPLO_CONVERT_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c")) {
+        return SimdLevel::AVX2;
+    }
+    return SimdLevel::Scalar;
+#elif defined(NEURIPLO_CONVERT_NEON)
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Highest level <= requested that this CPU runs.
+SimdLevel effective_level(SimdLevel requested) noexcept {
+    const SimdLevel detected = detected_simd_level();
+    switch (requested) {
+    case SimdLevel::Scalar:
+        return SimdLevel::Scalar;
+    case SimdLevel::NEON:
+        return detected == SimdLevel::NEON ? SimdLevel::NEON : SimdLevel::Scalar;
+    case SimdLevel::AVX2:
+        return detected == SimdLevel::AVX2 || detected == SimdLevel::AVX512 ? SimdLevel::AVX2 : SimdLevel::Scalar;
+    case SimdLevel::AVX512:
+        return detected == SimdLevel::AVX512 || detected == SimdLevel::AVX2 ? detected : SimdLevel::Scalar;
+    }
+    return SimdLevel::Scalar;
+}
+
+const Kernels& kernels_for(SimdLevel level) noexcept {
+    switch (level) {
+#if defined(NEURIPLO_CONVERT_X86)
+    case SimdLevel::AVX2:
+        return kAvx2Kernels;
+    case SimdLevel::AVX512:
+        return kAvx512Kernels;
+#elif defined(NEURIPLO_CONVERT_NEON)
+    case SimdLevel::NEON:
+        return kNeonKernels;
+#endif
+    default:
+        return kScalarKernels;
+    }
+}
+
+// Table slot for src -> dst, or nullptr when there is no kernel. Same-type
+// pairs other than Bool are handled by memcpy before this is consulted.
+Kernel Kernels::*conversion_slot(ElementType src_type, ElementType dst_type) noexcept {
+    if (dst_type == ElementType::Bool) {
+        const bool byte_source =
+            src_type == ElementType::Bool || src_type == ElementType::UInt8 || src_type == ElementType::Int8;
+        return byte_source ? &Kernels::normalize_bool : nullptr;
+    }
+    switch (src_type) {
+    case ElementType::Bool:
+        return dst_type == ElementType::UInt8 ? &Kernels::normalize_bool : nullptr;
+    case ElementType::Float16:
+        return dst_type == ElementType::Float32 ? &Kernels::f16_to_f32 : nullptr;
+    case ElementType::Float32:
+        return dst_type == ElementType::Float16 ? &Kernels::f32_to_f16 : nullptr;
+    case ElementType::Int8:
+        return dst_type == ElementType::Int32     ? &Kernels::i8_to_i32
+               : dst_type == ElementType::Float32 ? &Kernels::i8_to_f32
+                                                  : nullptr;
+    case ElementType::UInt8:
+        return dst_type == ElementType::Int32     ? &Kernels::u8_to_i32
+               : dst_type == ElementType::Float32 ? &Kernels::u8_to_f32
+                                                  : nullptr;
+    case ElementType::Int32:
+        return dst_type == ElementType::Int64 ? &Kernels::i32_to_i64 : nullptr;
+    case ElementType::Int64:
+        return dst_type == ElementType::Int32 ? &Kernels::i64_to_i32 : nullptr;
+    }
+    return nullptr;
+}
+
+const char* element_type_name(ElementType type) noexcept {
+    switch (type) {
+    case ElementType::Float32:
+        return "float32";
+    case ElementType::Float16:
+        return "float16";
+    case ElementType::Int32:
+        return "int32";
+    case ElementType::Int64:
+        return "int64";
+    case ElementType::UInt8:
+        return "uint8";
+    case ElementType::Int8:
+        return "int8";
+    case ElementType::Bool:
+        return "bool";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+SimdLevel detected_simd_level() noexcept {
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+const char* simd_level_name(SimdLevel level) noexcept {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return "scalar";
+    case SimdLevel::NEON:
+        return "neon";
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+bool is_supported_conversion(ElementType src_type, ElementType dst_type) noexcept {
+    return (src_type == dst_type && src_type != ElementType::Bool) || conversion_slot(src_type, dst_type) != nullptr;
+}
+
+void convert_elements(const void* src, ElementType src_type, void* dst, ElementType dst_type, size_t count) {
+    convert_elements(src, src_type, dst, dst_type, count, detected_simd_level());
+}
+
+void convert_elements(const void* src, ElementType src_type, void* dst, ElementType dst_type, size_t count,
+                      SimdLevel level) {
+    if (src_type == dst_type && src_type != ElementType::Bool) {
+        if (count != 0) {
+            std::memcpy(dst, src, count * element_type_size(src_type));
+        }
+        return;
+    }
+    Kernel Kernels::*slot = conversion_slot(src_type, dst_type);
+    if (slot == nullptr) {
+        throw InferenceException(std::string("unsupported element conversion ") + element_type_name(src_type) +
+                                 " -> " + element_type_name(dst_type));
+    }
+    if (count != 0) {
+        (kernels_for(effective_level(level)).*slot)(src, dst, count);
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "TensorDtype.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Bulk element conversion between contiguous host buffers.
+//
+// These are the kernels behind ITensorConverter: every widen (fp16 -> fp32,
+// int8/uint8 -> int32/fp32, int32 -> int64), narrow (fp32 -> fp16 with
+// round-to-nearest-even, int64 -> int32 with two's-complement truncation) and
+// same-type copy a backend needs to move framework output into neuriplo
+// buffers. Each conversion has a scalar reference implementation plus AVX2,
+// AVX-512 and NEON versions; the widest level the CPU supports is picked once
+// at first use, and every level produces bit-identical results.
+//
+// ElementType is the storage format of a buffer. It is wider than
+// TensorDataType because fp16 appears in framework outputs (TensorRT, ORT,
+// OpenVINO) but is never exposed in neuriplo metadata.
+enum class ElementType : uint8_t { Float32, Float16, Int32, Int64, UInt8, Int8, Bool };
+
+constexpr size_t element_type_size(ElementType type) noexcept {
+    switch (type) {
+    case ElementType::Float32:
+    case ElementType::Int32:
+        return 4;
+    case ElementType::Int64:
+        return 8;
+    case ElementType::Float16:
+        return 2;
+    case ElementType::UInt8:
+    case ElementType::Int8:
+    case ElementType::Bool:
+        return 1;
+    }
+    return 0;
+}
+
+// Storage format of a typed raw output buffer.
+constexpr ElementType to_element_type(TensorDtype dtype) noexcept {
+    switch (dtype) {
+    case TensorDtype::FP32:
+        return ElementType::Float32;
+    case TensorDtype::INT32:
+        return ElementType::Int32;
+    case TensorDtype::INT64:
+        return ElementType::Int64;
+    case TensorDtype::UINT8:
+        return ElementType::UInt8;
+    }
+    return ElementType::Float32;
+}
+
+enum class SimdLevel : uint8_t { Scalar, NEON, AVX2, AVX512 };
+
+// Widest level this CPU runs; detected once.
+SimdLevel detected_simd_level() noexcept;
+const char* simd_level_name(SimdLevel level) noexcept;
+
+// True when convert_elements() has a kernel for src -> dst.
+bool is_supported_conversion(ElementType src_type, ElementType dst_type) noexcept;
+
+// Converts `count` elements from src to dst using the detected SIMD level.
+// Buffers need no particular alignment and must not overlap. Bool outputs are
+// normalized to 0/1. Throws InferenceException for unsupported pairs.
+void convert_elements(const void* src, ElementType src_type, void* dst, ElementType dst_type, size_t count);
+
+// Same, pinned to `level` (clamped to what the CPU supports). For tests and
+// benchmarks that compare levels against the scalar reference.
+void convert_elements(const void* src, ElementType src_type, void* dst, ElementType dst_type, size_t count,
+                      SimdLevel level);
+
+// Scalar IEEE 754 binary16 <-> binary32 conversions used by the reference
+// kernels; fp32 -> fp16 rounds to nearest even.
+float fp16_to_fp32(uint16_t half) noexcept;
+uint16_t fp32_to_fp16(float value) noexcept;
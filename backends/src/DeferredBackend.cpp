@@ -0,0 +1,169 @@
+#include "DeferredBackend.hpp"
+
+#include <cstdlib>
+#include <glog/logging.h>
+#include <utility>
+
+namespace {
+
+constexpr size_t kDefaultLoaderThreads = 4;
+
+size_t loader_threads() {
+    const char* value = std::getenv("NEURIPLO_LOADER_THREADS");
+    if (value == nullptr || value[0] == '\0') {
+        return kDefaultLoaderThreads;
+    }
+    char* end = nullptr;
+    const unsigned long threads = std::strtoul(value, &end, 10);
+    if (*end != '\0' || threads == 0) {
+        LOG(WARNING) << "Ignoring NEURIPLO_LOADER_THREADS='" << value << "': expected a positive thread count";
+        return kDefaultLoaderThreads;
+    }
+    return threads;
+}
+
+} // namespace
+
+DeferredBackend::DeferredBackend(const std::string& model_path, bool use_gpu, size_t batch_size, Loader loader,
+                                 AsyncThreadPool& pool)
+    : InferenceInterface(model_path, use_gpu, batch_size, std::vector<std::vector<int64_t>>()),
+      shared_(std::make_shared<Shared>()) {
+    if (!loader) {
+        throw InferenceException("DeferredBackend requires a loader");
+    }
+    state_ = BackendState::Loading;
+    shared_->future = shared_->promise.get_future().share();
+    pool.submit([shared = shared_, loader = std::move(loader)] { run_loader(shared, loader); });
+}
+
+DeferredBackend::~DeferredBackend() = default;
+
+void DeferredBackend::run_loader(const std::shared_ptr<Shared>& shared, const Loader& loader) {
+    std::unique_ptr<InferenceInterface> backend;
+    std::string error;
+    try {
+        backend = loader();
+        if (!backend) {
+            error = "model failed to load";
+        } else if (backend->state() != BackendState::Ready) {
+            error = std::string("backend is ") + to_string(backend->state()) + " after loading";
+            backend.reset();
+        }
+    } catch (const std::exception& e) {
+        error = e.what();
+        backend.reset();
+    }
+
+    const BackendState final_state = backend ? BackendState::Ready : BackendState::Failed;
+    std::vector<ReadyCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->backend = std::move(backend);
+        shared->error = std::move(error);
+        shared->state.store(final_state, std::memory_order_release);
+        callbacks.swap(shared->callbacks);
+    }
+    if (final_state == BackendState::Failed) {
+        LOG(ERROR) << "DeferredBackend: " << shared->error;
+    }
+    shared->finished.notify_all();
+    shared->promise.set_value(final_state);
+    for (const ReadyCallback& callback : callbacks) {
+        callback(final_state);
+    }
+}
+
+BackendState DeferredBackend::state() const noexcept { return shared_->state.load(std::memory_order_acquire); }
+
+BackendState DeferredBackend::wait() const {
+    std::unique_lock<std::mutex> lock(shared_->mutex);
+    shared_->finished.wait(lock, [this] { return state() != BackendState::Loading; });
+    return state();
+}
+
+std::shared_future<BackendState> DeferredBackend::ready() const { return shared_->future; }
+
+void DeferredBackend::on_ready(ReadyCallback callback) {
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        if (state() == BackendState::Loading) {
+            shared_->callbacks.push_back(std::move(callback));
+            return;
+        }
+    }
+    callback(state());
+}
+
+std::string DeferredBackend::error() const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->error;
+}
+
+InferenceInterface* DeferredBackend::inner() const noexcept {
+    return state() == BackendState::Ready ? shared_->backend.get() : nullptr;
+}
+
+InferenceInterface& DeferredBackend::loaded() const {
+    if (wait() == BackendState::Failed) {
+        throw InferenceExecutionException("model " + model_path_ + " failed to load: " + error());
+    }
+    return *shared_->backend;
+}
+
+bool DeferredBackend::is_gpu_available() const noexcept {
+    const InferenceInterface* backend = inner();
+    return backend != nullptr ? backend->is_gpu_available() : gpu_available_;
+}
+
+size_t DeferredBackend::get_batch_size() const noexcept {
+    const InferenceInterface* backend = inner();
+    return backend != nullptr ? backend->get_batch_size() : batch_size_;
+}
+
+std::string DeferredBackend::get_model_path() const noexcept {
+    const InferenceInterface* backend = inner();
+    return backend != nullptr ? backend->get_model_path() : model_path_;
+}
+
+double DeferredBackend::get_last_inference_time_ms() const noexcept {
+    const InferenceInterface* backend = inner();
+    return backend != nullptr ? backend->get_last_inference_time_ms() : 0.0;
+}
+
+size_t DeferredBackend::get_total_inferences() const noexcept {
+    const InferenceInterface* backend = inner();
+    return backend != nullptr ? backend->get_total_inferences() : 0;
+}
+
+void DeferredBackend::clear_cache() noexcept {
+    if (InferenceInterface* backend = inner()) {
+        backend->clear_cache();
+    }
+}
+
+size_t DeferredBackend::get_memory_usage_mb() const noexcept {
+    const InferenceInterface* backend = inner();
+    return backend != nullptr ? backend->get_memory_usage_mb() : 0;
+}
+
+void DeferredBackend::start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) {
+    on_ready([shared = shared_, model_path = model_path_, inputs = std::move(inputs),
+              done = std::move(done)](BackendState final_state) {
+        if (final_state == BackendState::Failed) {
+            done(std::make_exception_ptr(
+                     InferenceExecutionException("model " + model_path + " failed to load: " + shared->error)),
+                 {});
+            return;
+        }
+        // The views point into `inputs`, which the completion keeps alive.
+        shared->backend->infer_async(AsyncInputs(inputs->views()),
+                                     [inputs, done](std::exception_ptr error, auto results) {
+                                         done(std::move(error), std::move(results));
+                                     });
+    });
+}
+
+AsyncThreadPool& DeferredBackend::loader_pool() {
+    static AsyncThreadPool pool(loader_threads());
+    return pool;
+}
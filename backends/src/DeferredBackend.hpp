@@ -0,0 +1,124 @@
+#pragma once
+#include "AsyncInference.hpp"
+#include "InferenceInterface.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// InferenceInterface that is returned before its model has loaded.
+//
+// The constructor queues the loader on a thread pool and returns at once in
+// the Loading state, so a process starting many models loads them in
+// parallel instead of one after another. When the loader finishes the state
+// becomes Ready (or Failed if it threw or returned nullptr) and the ready()
+// future and on_ready() callbacks fire.
+//
+// Calls made while Loading wait for the load to finish, then run on the
+// loaded backend or throw InferenceExecutionException if it failed; load()
+// only waits. ModelRunner can reject such calls instead (see
+// ModelRunner::LoadingPolicy). setup_inference_engine() returns one when
+// EngineOptions::load_in_background is set.
+class DeferredBackend : public InferenceInterface {
+  public:
+    using Loader = std::function<std::unique_ptr<InferenceInterface>()>;
+    using ReadyCallback = std::function<void(BackendState)>;
+
+    // model_path, use_gpu and batch_size answer the utility queries until
+    // the backend has loaded.
+    DeferredBackend(const std::string& model_path, bool use_gpu, size_t batch_size, Loader loader,
+                    AsyncThreadPool& pool = loader_pool());
+    ~DeferredBackend() override;
+
+    DeferredBackend(const DeferredBackend&) = delete;
+    DeferredBackend& operator=(const DeferredBackend&) = delete;
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        return loaded().get_infer_results(input_tensors);
+    }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        return loaded().get_infer_results(inputs);
+    }
+
+    std::vector<RawOutputTensor>
+    get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        return loaded().get_infer_results_raw(input_tensors);
+    }
+
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override {
+        return loaded().get_infer_results_raw(inputs);
+    }
+
+    void infer_into(const std::vector<TensorView>& inputs, std::vector<OutputBuffer>& outputs) override {
+        loaded().infer_into(inputs, outputs);
+    }
+
+    InferenceMetadata get_inference_metadata() override { return loaded().get_inference_metadata(); }
+
+    BackendState state() const noexcept override;
+    // Waits for the background load; never loads on the calling thread.
+    void load() override { wait(); }
+
+    bool is_gpu_available() const noexcept override;
+    size_t get_batch_size() const noexcept override;
+    std::string get_model_path() const noexcept override;
+    double get_last_inference_time_ms() const noexcept override;
+    size_t get_total_inferences() const noexcept override;
+    void clear_cache() noexcept override;
+    size_t get_memory_usage_mb() const noexcept override;
+
+    // Blocks until the load has finished; returns Ready or Failed.
+    BackendState wait() const;
+
+    // Becomes ready with Ready or Failed when the load finishes.
+    std::shared_future<BackendState> ready() const;
+
+    // Runs `callback` with the final state once the load finishes: on the
+    // loader thread, or right away on this thread if it already has.
+    void on_ready(ReadyCallback callback);
+
+    // Why the load failed; empty unless state() is Failed.
+    std::string error() const;
+
+    // The loaded backend, or nullptr until state() is Ready.
+    InferenceInterface* inner() const noexcept;
+
+    // Pool that setup_inference_engine() loads on: NEURIPLO_LOADER_THREADS
+    // threads, 4 by default.
+    static AsyncThreadPool& loader_pool();
+
+  protected:
+    // Asynchronous calls made while Loading start once the load finishes,
+    // without blocking the caller.
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override;
+
+  private:
+    // Shared with the load task, so destroying the DeferredBackend while it
+    // loads is safe (the loaded backend is then discarded).
+    struct Shared {
+        mutable std::mutex mutex;
+        mutable std::condition_variable finished;
+        std::atomic<BackendState> state{BackendState::Loading};
+        // Written once before state leaves Loading, read-only afterwards.
+        std::unique_ptr<InferenceInterface> backend;
+        std::string error;
+        std::promise<BackendState> promise;
+        std::shared_future<BackendState> future;
+        std::vector<ReadyCallback> callbacks;
+    };
+
+    static void run_loader(const std::shared_ptr<Shared>& shared, const Loader& loader);
+
+    // The loaded backend, after waiting for the load; throws if it failed.
+    InferenceInterface& loaded() const;
+
+    std::shared_ptr<Shared> shared_;
+};
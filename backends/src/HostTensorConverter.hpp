@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ConvertKernels.hpp"
 #include "ITensorConverter.hpp"
 
 #include <cstddef>
@@ -13,15 +14,17 @@
 // lifts them into neuriplo's TensorElement variant (and vice versa for raw
 // input bytes). It is the converter counterpart to HostAllocator: a concrete,
 // dependency-free default that Abstract Factory implementations can hand out so
-// create_converter() never returns null.
+// create_converter() never returns null, and the converter every backend uses
+// unless its factory provides another one.
 //
-// NOTE: this converter is NOT wired into any backend's inference path. Backends
-// continue to do their own (unchanged) tensor conversion inline. This type only
-// exists so the factory family is complete and independently testable.
+// Typed conversions run the SIMD kernels from ConvertKernels.hpp. Building
+// TensorElement values is still one variant per element, but the type switch
+// is hoisted out of the loop and types the variant cannot hold are converted
+// in blocks by the kernels first.
 //
 // The TensorElement variant only carries {float, int32_t, int64_t, uint8_t}, so
-// the two narrower request types are widened to the nearest representable
-// alternative: Int8 -> int32_t and Bool -> uint8_t.
+// the narrower types are widened to the nearest representable alternative:
+// Float16 -> float, Int8 -> int32_t and Bool -> uint8_t.
 class HostTensorConverter : public ITensorConverter {
   public:
     std::vector<TensorElement> to_typed(const std::vector<uint8_t>& raw_bytes, TensorDataType type) const override {
@@ -35,9 +38,48 @@ class HostTensorConverter : public ITensorConverter {
         return decode(data, num_elements, type);
     }
 
+    void convert(const void* src, ElementType src_type, void* dst, ElementType dst_type,
+                 std::size_t count) const override {
+        convert_elements(src, src_type, dst, dst_type, count);
+    }
+
+    void append_elements(std::vector<TensorElement>& out, const void* data, std::size_t num_elements,
+                         ElementType type) const override {
+        if (data == nullptr || num_elements == 0) {
+            return;
+        }
+        out.reserve(out.size() + num_elements);
+        switch (type) {
+        case ElementType::Float32:
+            append_as<float>(out, data, num_elements);
+            break;
+        case ElementType::Int32:
+            append_as<int32_t>(out, data, num_elements);
+            break;
+        case ElementType::Int64:
+            append_as<int64_t>(out, data, num_elements);
+            break;
+        case ElementType::UInt8:
+            append_as<uint8_t>(out, data, num_elements);
+            break;
+        case ElementType::Float16:
+            append_converted<float>(out, data, num_elements, type, ElementType::Float32);
+            break;
+        case ElementType::Int8:
+            append_converted<int32_t>(out, data, num_elements, type, ElementType::Int32);
+            break;
+        case ElementType::Bool:
+            append_converted<uint8_t>(out, data, num_elements, type, ElementType::Bool);
+            break;
+        }
+    }
+
     const char* name() const noexcept override { return "HostTensorConverter"; }
 
   private:
+    // Elements per kernel call when widening into a stack buffer.
+    static constexpr std::size_t kBlockElements = 256;
+
     static std::size_t element_size(TensorDataType type) noexcept {
         switch (type) {
         case TensorDataType::Float32:
@@ -56,52 +98,53 @@ class HostTensorConverter : public ITensorConverter {
         return 0;
     }
 
-    // Copies `count` elements of `type` out of `data` into TensorElement values.
-    // Uses memcpy to avoid unaligned-access UB on the raw byte buffer.
-    static std::vector<TensorElement> decode(const void* data, std::size_t count, TensorDataType type) {
-        std::vector<TensorElement> out;
-        if (data == nullptr || count == 0) {
-            return out;
+    static ElementType element_type(TensorDataType type) noexcept {
+        switch (type) {
+        case TensorDataType::Float32:
+            return ElementType::Float32;
+        case TensorDataType::Int32:
+            return ElementType::Int32;
+        case TensorDataType::Int64:
+            return ElementType::Int64;
+        case TensorDataType::UInt8:
+            return ElementType::UInt8;
+        case TensorDataType::Int8:
+            return ElementType::Int8;
+        case TensorDataType::Bool:
+            return ElementType::Bool;
         }
-        out.reserve(count);
-        const auto* bytes = static_cast<const uint8_t*>(data);
+        return ElementType::Float32;
+    }
 
+    // Copies `count` elements of T out of `data`. Uses memcpy to avoid
+    // unaligned-access UB on the raw byte buffer.
+    template <typename T>
+    static void append_as(std::vector<TensorElement>& out, const void* data, std::size_t count) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
         for (std::size_t i = 0; i < count; ++i) {
-            switch (type) {
-            case TensorDataType::Float32: {
-                float v;
-                std::memcpy(&v, bytes + i * sizeof(float), sizeof(float));
-                out.emplace_back(v);
-                break;
-            }
-            case TensorDataType::Int32: {
-                int32_t v;
-                std::memcpy(&v, bytes + i * sizeof(int32_t), sizeof(int32_t));
-                out.emplace_back(v);
-                break;
-            }
-            case TensorDataType::Int64: {
-                int64_t v;
-                std::memcpy(&v, bytes + i * sizeof(int64_t), sizeof(int64_t));
-                out.emplace_back(v);
-                break;
-            }
-            case TensorDataType::UInt8: {
-                out.emplace_back(static_cast<uint8_t>(bytes[i]));
-                break;
-            }
-            case TensorDataType::Int8: {
-                int8_t v;
-                std::memcpy(&v, bytes + i * sizeof(int8_t), sizeof(int8_t));
-                out.emplace_back(static_cast<int32_t>(v));
-                break;
-            }
-            case TensorDataType::Bool: {
-                out.emplace_back(static_cast<uint8_t>(bytes[i] != 0 ? 1 : 0));
-                break;
-            }
-            }
+            T value;
+            std::memcpy(&value, bytes + i * sizeof(T), sizeof(T));
+            out.emplace_back(value);
         }
+    }
+
+    // Converts `count` elements to Wide in stack-sized blocks, then appends them.
+    template <typename Wide>
+    static void append_converted(std::vector<TensorElement>& out, const void* data, std::size_t count,
+                                 ElementType src_type, ElementType wide_type) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        const std::size_t src_size = element_type_size(src_type);
+        Wide block[kBlockElements];
+        for (std::size_t done = 0; done < count; done += kBlockElements) {
+            const std::size_t n = count - done < kBlockElements ? count - done : kBlockElements;
+            convert_elements(bytes + done * src_size, src_type, block, wide_type, n);
+            out.insert(out.end(), block, block + n);
+        }
+    }
+
+    std::vector<TensorElement> decode(const void* data, std::size_t count, TensorDataType type) const {
+        std::vector<TensorElement> out;
+        append_elements(out, data, count, element_type(type));
         return out;
     }
 };
@@ -0,0 +1,216 @@
+#pragma once
+#include "InferenceInterface.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <glog/logging.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// InferenceInterface whose model can be replaced while it serves traffic.
+//
+// Calls run on the current instance, which readers take with an atomic load
+// of a shared_ptr (RCU-style): a swap never blocks them. swap() loads the
+// candidate through load()/state(), warms it up, then publishes it with one
+// atomic exchange. Calls that already started finish on the old instance,
+// which is destroyed on the swapping thread once the last of them returns.
+// A candidate that fails to load or warm up is discarded and the current
+// instance keeps serving.
+//
+// Like a plain backend, one instance is not safe to call concurrently; swap
+// in BackendPools for concurrent serving. swap_model() and
+// setup_hot_swap_backend() build instances from EngineOptions.
+class HotSwapBackend : public InferenceInterface {
+  public:
+    using Loader = std::function<std::unique_ptr<InferenceInterface>()>;
+    // Runs representative inferences on a loaded candidate before it is
+    // published; throwing rejects the candidate.
+    using Warmup = std::function<void(InferenceInterface&)>;
+
+    explicit HotSwapBackend(std::unique_ptr<InferenceInterface> initial, Warmup warmup = nullptr)
+        : InferenceInterface(checked(initial).get_model_path(), checked(initial).is_gpu_available(),
+                             checked(initial).get_batch_size(), std::vector<std::vector<int64_t>>()),
+          current_(std::move(initial)), warmup_(std::move(warmup)) {}
+
+    // Waits for a pending swap_async().
+    ~HotSwapBackend() override {
+        std::lock_guard<std::mutex> lock(swapper_mutex_);
+        if (swapper_.joinable()) {
+            swapper_.join();
+        }
+    }
+
+    HotSwapBackend(const HotSwapBackend&) = delete;
+    HotSwapBackend& operator=(const HotSwapBackend&) = delete;
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        const auto instance = current();
+        auto result = instance->get_infer_results(input_tensors);
+        record(*instance);
+        return result;
+    }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        const auto instance = current();
+        auto result = instance->get_infer_results(inputs);
+        record(*instance);
+        return result;
+    }
+
+    std::vector<RawOutputTensor>
+    get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        const auto instance = current();
+        auto result = instance->get_infer_results_raw(input_tensors);
+        record(*instance);
+        return result;
+    }
+
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override {
+        const auto instance = current();
+        auto result = instance->get_infer_results_raw(inputs);
+        record(*instance);
+        return result;
+    }
+
+    void infer_into(const std::vector<TensorView>& inputs, std::vector<OutputBuffer>& outputs) override {
+        const auto instance = current();
+        instance->infer_into(inputs, outputs);
+        record(*instance);
+    }
+
+    // Metadata of the current instance, which a swap may change.
+    InferenceMetadata get_inference_metadata() override { return current()->get_inference_metadata(); }
+
+    BackendState state() const noexcept override { return current()->state(); }
+    void load() override { current()->load(); }
+
+    bool is_gpu_available() const noexcept override { return current()->is_gpu_available(); }
+    size_t get_batch_size() const noexcept override { return current()->get_batch_size(); }
+    std::string get_model_path() const noexcept override { return current()->get_model_path(); }
+
+    // Latency of the most recently completed call and completed calls across
+    // every instance this backend has served with.
+    double get_last_inference_time_ms() const noexcept override {
+        return last_inference_time_ms_atomic_.load(std::memory_order_relaxed);
+    }
+    size_t get_total_inferences() const noexcept override {
+        return total_inferences_atomic_.load(std::memory_order_relaxed);
+    }
+
+    void clear_cache() noexcept override { current()->clear_cache(); }
+    size_t get_memory_usage_mb() const noexcept override { return current()->get_memory_usage_mb(); }
+
+    // Loads, warms up and publishes `candidate`, then waits for the calls
+    // still running on the replaced instance and destroys it. Returns false,
+    // leaving the current instance in place, when the candidate is null or
+    // does not become Ready or fails its warmup. Concurrent swaps are
+    // serialized.
+    bool swap(std::unique_ptr<InferenceInterface> candidate) {
+        std::lock_guard<std::mutex> lock(swap_mutex_);
+        if (!prepare(candidate)) {
+            return false;
+        }
+        std::shared_ptr<InferenceInterface> retired = std::atomic_exchange(
+            &current_, std::shared_ptr<InferenceInterface>(std::move(candidate)));
+        generation_.fetch_add(1, std::memory_order_release);
+        retire(std::move(retired));
+        return true;
+    }
+
+    bool swap(const Loader& loader) {
+        std::unique_ptr<InferenceInterface> candidate;
+        try {
+            candidate = loader();
+        } catch (const std::exception& e) {
+            LOG(ERROR) << "HotSwapBackend: candidate failed to load: " << e.what();
+            return false;
+        }
+        return swap(std::move(candidate));
+    }
+
+    // swap(loader) on a background thread; the future reports its result.
+    // Swaps requested while one is in progress run after it, in order.
+    std::future<bool> swap_async(Loader loader) {
+        auto done = std::make_shared<std::promise<bool>>();
+        std::future<bool> result = done->get_future();
+        std::lock_guard<std::mutex> lock(swapper_mutex_);
+        swapper_ = std::thread([this, previous = std::move(swapper_), loader = std::move(loader), done]() mutable {
+            if (previous.joinable()) {
+                previous.join();
+            }
+            done->set_value(swap(loader));
+        });
+        return result;
+    }
+
+    // Number of successful swaps so far.
+    uint64_t generation() const noexcept { return generation_.load(std::memory_order_acquire); }
+
+  private:
+    static const InferenceInterface& checked(const std::unique_ptr<InferenceInterface>& initial) {
+        if (!initial) {
+            throw InferenceException("HotSwapBackend requires a non-null initial backend");
+        }
+        return *initial;
+    }
+
+    std::shared_ptr<InferenceInterface> current() const noexcept { return std::atomic_load(&current_); }
+
+    void record(const InferenceInterface& instance) noexcept {
+        last_inference_time_ms_atomic_.store(instance.get_last_inference_time_ms(), std::memory_order_relaxed);
+        total_inferences_atomic_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool prepare(const std::unique_ptr<InferenceInterface>& candidate) {
+        if (!candidate) {
+            LOG(ERROR) << "HotSwapBackend: no candidate to swap in";
+            return false;
+        }
+        try {
+            if (candidate->state() != BackendState::Ready) {
+                candidate->load();
+            }
+            if (candidate->state() != BackendState::Ready) {
+                LOG(ERROR) << "HotSwapBackend: candidate " << candidate->get_model_path() << " is "
+                           << to_string(candidate->state()) << ", keeping the current model";
+                return false;
+            }
+            if (warmup_) {
+                warmup_(*candidate);
+            }
+        } catch (const std::exception& e) {
+            LOG(ERROR) << "HotSwapBackend: candidate " << candidate->get_model_path() << " rejected: " << e.what();
+            return false;
+        }
+        return true;
+    }
+
+    // Readers that loaded the old pointer before the exchange still hold
+    // references; no new ones can appear, so the count only drops.
+    static void retire(std::shared_ptr<InferenceInterface> retired) {
+        while (retired.use_count() > 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        retired.reset();
+    }
+
+    // Accessed only through std::atomic_load / std::atomic_exchange.
+    std::shared_ptr<InferenceInterface> current_;
+    Warmup warmup_;
+    std::mutex swap_mutex_;
+    std::atomic<uint64_t> generation_{0};
+    std::atomic<double> last_inference_time_ms_atomic_{0.0};
+    std::atomic<size_t> total_inferences_atomic_{0};
+
+    std::mutex swapper_mutex_;
+    // Latest swap_async() thread; each joins its predecessor first.
+    std::thread swapper_;
+};
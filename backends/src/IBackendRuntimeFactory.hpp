@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BackendTuning.hpp"
 #include "IAllocator.hpp"
 #include "ITensorConverter.hpp"
 #include "InferenceInterface.hpp"
@@ -21,6 +22,16 @@ class IBackendRuntimeFactory {
     create_backend(const std::string& model_path, bool use_gpu, size_t batch_size,
                    const std::vector<std::vector<int64_t>>& input_sizes) = 0;
 
+    // Same, applying the tuning block that belongs to this runtime. Runtimes
+    // without tunables keep the default, which ignores it.
+    virtual std::unique_ptr<InferenceInterface> create_backend(const std::string& model_path, bool use_gpu,
+                                                               size_t batch_size,
+                                                               const std::vector<std::vector<int64_t>>& input_sizes,
+                                                               const BackendTuning& tuning) {
+        (void)tuning;
+        return create_backend(model_path, use_gpu, batch_size, input_sizes);
+    }
+
     virtual std::unique_ptr<IAllocator> create_allocator() = 0;
     virtual std::unique_ptr<ITensorConverter> create_converter() = 0;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ConvertKernels.hpp"
 #include "InferenceInterface.hpp"
 #include "TensorDataType.hpp"
 
@@ -8,8 +9,10 @@
 #include <vector>
 
 // Pure-virtual abstraction over the raw-bytes <-> typed-tensor conversion that
-// backends (e.g. ORTInfer) currently inline. Interface only: this step defines
-// the contract without prescribing any conversion math or behavior.
+// backends need when moving framework output into neuriplo results. Each
+// backend receives the converter of its runtime factory (see
+// InferenceInterface::set_tensor_converter()) and routes its output
+// conversion through it, so the conversion cost lives in one place.
 class ITensorConverter {
   public:
     virtual ~ITensorConverter() = default;
@@ -21,5 +24,16 @@ class ITensorConverter {
     virtual std::vector<TensorElement> from_backend(const void* data, std::size_t num_elements,
                                                     TensorDataType type) const = 0;
 
+    // Bulk typed conversion between contiguous buffers (widen, narrow or
+    // copy; see ConvertKernels.hpp for the supported pairs). Throws
+    // InferenceException for unsupported pairs.
+    virtual void convert(const void* src, ElementType src_type, void* dst, ElementType dst_type,
+                         std::size_t count) const = 0;
+
+    // Appends num_elements values of `type` at data to out. Float16 widens to
+    // float, Int8 to int32_t and Bool to a 0/1 uint8_t.
+    virtual void append_elements(std::vector<TensorElement>& out, const void* data, std::size_t num_elements,
+                                 ElementType type) const = 0;
+
     virtual const char* name() const noexcept = 0;
 };
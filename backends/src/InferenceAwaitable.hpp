@@ -0,0 +1,68 @@
+#pragma once
+
+// Optional C++20 coroutine front-end for InferenceInterface::infer_async().
+// The library itself builds as C++17; this header is empty unless the
+// including translation unit is compiled as C++20 with <coroutine>.
+//
+//     auto [outputs, shapes] = co_await infer_awaitable(*backend, std::move(inputs));
+//
+// The coroutine resumes on the thread that finished the inference, or, when
+// a CompletionQueue is given, on whichever thread drains that queue.
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+#include "InferenceInterface.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+class InferenceAwaitable {
+  public:
+    using Results = std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>;
+
+    InferenceAwaitable(InferenceInterface& backend, AsyncInputs inputs, CompletionQueue* queue = nullptr)
+        : backend_(backend), inputs_(std::move(inputs)), queue_(queue) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    // The completion may resume the coroutine before infer_async() returns,
+    // destroying this awaitable, so nothing here touches members afterwards.
+    void await_suspend(std::coroutine_handle<> handle) {
+        auto resume = [this, handle](std::exception_ptr error, Results results) {
+            error_ = error;
+            results_ = std::move(results);
+            handle.resume();
+        };
+        if (queue_ != nullptr) {
+            backend_.infer_async(std::move(inputs_), *queue_, std::move(resume));
+        } else {
+            backend_.infer_async(std::move(inputs_), std::move(resume));
+        }
+    }
+
+    Results await_resume() {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        return std::move(results_);
+    }
+
+  private:
+    InferenceInterface& backend_;
+    AsyncInputs inputs_;
+    CompletionQueue* queue_;
+    std::exception_ptr error_;
+    Results results_;
+};
+
+inline InferenceAwaitable infer_awaitable(InferenceInterface& backend, AsyncInputs inputs) {
+    return InferenceAwaitable(backend, std::move(inputs));
+}
+
+inline InferenceAwaitable infer_awaitable(InferenceInterface& backend, AsyncInputs inputs, CompletionQueue& queue) {
+    return InferenceAwaitable(backend, std::move(inputs), &queue);
+}
+
+#endif
@@ -1,15 +1,19 @@
 #include "InferenceInterface.hpp"
 
+#include "HostTensorConverter.hpp"
+
 #include <cstdint>
+#include <cstring>
+#include <string>
 
 InferenceInterface::InferenceInterface(const std::string& weights, bool use_gpu, size_t batch_size,
                                        const std::vector<std::vector<int64_t>>& input_sizes)
     : model_path_(weights), gpu_available_(use_gpu), batch_size_(batch_size), last_inference_time_ms_(0.0),
       total_inferences_(0), memory_usage_mb_(0) {}
 
-std::vector<RawOutputTensor>
-InferenceInterface::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
-    auto [outputs, shapes] = get_infer_results(input_tensors);
+// Each tensor must hold a single TensorElement alternative.
+std::vector<RawOutputTensor> flatten_to_raw(std::vector<std::vector<TensorElement>> outputs,
+                                            std::vector<std::vector<int64_t>> shapes) {
 
     std::vector<RawOutputTensor> raw_outputs;
     raw_outputs.reserve(outputs.size());
@@ -29,14 +33,15 @@ InferenceInterface::get_infer_results_raw(const std::vector<std::vector<uint8_t>
         auto flatten = [&](auto sample, TensorDtype tag) {
             using Element = decltype(sample);
             tensor.dtype = tag;
-            tensor.bytes.resize(elements.size() * sizeof(Element));
-            auto* typed = reinterpret_cast<Element*>(tensor.bytes.data());
+            std::vector<uint8_t> bytes(elements.size() * sizeof(Element));
+            auto* typed = reinterpret_cast<Element*>(bytes.data());
             for (size_t j = 0; j < elements.size(); ++j) {
                 if (elements[j].index() != alternative) {
                     throw InferenceExecutionException("output tensor mixes element types");
                 }
                 typed[j] = std::get<Element>(elements[j]);
             }
+            tensor.bytes = std::move(bytes);
         };
         switch (alternative) {
         case 0:
@@ -59,6 +64,81 @@ InferenceInterface::get_infer_results_raw(const std::vector<std::vector<uint8_t>
     return raw_outputs;
 }
 
+std::vector<TensorElement> widen_raw_output(const RawOutputTensor& tensor) {
+    std::vector<TensorElement> elements;
+    auto widen = [&](auto sample) {
+        using Element = decltype(sample);
+        const auto* typed = reinterpret_cast<const Element*>(tensor.bytes.data());
+        const size_t count = tensor.bytes.size() / sizeof(Element);
+        elements.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            elements.emplace_back(typed[i]);
+        }
+    };
+    switch (tensor.dtype) {
+    case TensorDtype::FP32:
+        widen(float{});
+        break;
+    case TensorDtype::INT32:
+        widen(int32_t{});
+        break;
+    case TensorDtype::INT64:
+        widen(int64_t{});
+        break;
+    case TensorDtype::UINT8:
+        widen(uint8_t{});
+        break;
+    }
+    return elements;
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+InferenceInterface::get_infer_results(const std::vector<TensorView>& inputs) {
+    return get_infer_results(copy_tensor_views(inputs));
+}
+
+std::vector<RawOutputTensor>
+InferenceInterface::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    auto [outputs, shapes] = get_infer_results(input_tensors);
+    return flatten_to_raw(std::move(outputs), std::move(shapes));
+}
+
+std::vector<RawOutputTensor> InferenceInterface::get_infer_results_raw(const std::vector<TensorView>& inputs) {
+    auto [outputs, shapes] = get_infer_results(inputs);
+    return flatten_to_raw(std::move(outputs), std::move(shapes));
+}
+
+void InferenceInterface::infer_into(const std::vector<TensorView>& inputs, std::vector<OutputBuffer>& outputs) {
+    std::vector<RawOutputTensor> raw_outputs = get_infer_results_raw(inputs);
+    check_output_buffer_count(outputs, raw_outputs.size());
+    for (size_t i = 0; i < raw_outputs.size(); ++i) {
+        const RawOutputTensor& raw = raw_outputs[i];
+        copy_into_output_buffer(outputs[i], i, raw.dtype, raw.bytes.data(), raw.bytes.size());
+        outputs[i].shape.assign(raw.shape.begin(), raw.shape.end());
+    }
+}
+
+void InferenceInterface::check_output_buffer_count(const std::vector<OutputBuffer>& outputs, size_t expected) {
+    if (outputs.size() != expected) {
+        throw InferenceExecutionException("Output buffer count mismatch: expected " + std::to_string(expected) +
+                                          ", got " + std::to_string(outputs.size()));
+    }
+}
+
+void InferenceInterface::copy_into_output_buffer(OutputBuffer& output, size_t index, TensorDtype dtype,
+                                                 const void* data, size_t size_bytes) {
+    if (size_bytes > output.capacity_bytes || (size_bytes != 0 && output.data == nullptr)) {
+        throw InferenceExecutionException("Output buffer at index " + std::to_string(index) + " holds " +
+                                          std::to_string(output.capacity_bytes) + " bytes, output needs " +
+                                          std::to_string(size_bytes));
+    }
+    if (size_bytes != 0) {
+        std::memcpy(output.data, data, size_bytes);
+    }
+    output.dtype = dtype;
+    output.size_bytes = size_bytes;
+}
+
 InferenceMetadata InferenceInterface::get_inference_metadata() {
     // OpenCV DNN module does not have a method to get input layer shapes and names
     if (inference_metadata_.getInputs().empty() && inference_metadata_.getOutputs().empty()) {
@@ -78,6 +158,65 @@ size_t InferenceInterface::get_memory_usage_mb() const noexcept {
     return 0;
 }
 
+const ITensorConverter& InferenceInterface::tensor_converter() const noexcept {
+    static const HostTensorConverter host_converter;
+    return converter_ ? *converter_ : host_converter;
+}
+
+std::future<std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>>
+InferenceInterface::infer_async(AsyncInputs inputs) {
+    using Results = std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>;
+    auto promise = std::make_shared<std::promise<Results>>();
+    std::future<Results> future = promise->get_future();
+    start_async(std::make_shared<const AsyncInputs>(std::move(inputs)),
+                [promise](std::exception_ptr error, Results results) {
+                    if (error) {
+                        promise->set_exception(error);
+                    } else {
+                        promise->set_value(std::move(results));
+                    }
+                });
+    return future;
+}
+
+void InferenceInterface::infer_async(AsyncInputs inputs, InferenceCallback callback) {
+    start_async(std::make_shared<const AsyncInputs>(std::move(inputs)), std::move(callback));
+}
+
+void InferenceInterface::infer_async(AsyncInputs inputs, CompletionQueue& queue, InferenceCallback callback) {
+    using Results = std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>;
+    start_async(std::make_shared<const AsyncInputs>(std::move(inputs)),
+                [&queue, callback = std::move(callback)](std::exception_ptr error, Results results) {
+                    queue.post([callback, error, results = std::move(results)]() mutable {
+                        callback(error, std::move(results));
+                    });
+                });
+}
+
+void InferenceInterface::start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) {
+    async_executor_.post(
+        [this, inputs = std::move(inputs), done = std::move(done)] { run_async_inference(*inputs, done); });
+}
+
+void InferenceInterface::run_async_inference(const AsyncInputs& inputs, const InferenceCallback& done) {
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>> results;
+    try {
+        results = get_infer_results(inputs.views());
+    } catch (...) {
+        done(std::current_exception(), {});
+        return;
+    }
+    done(nullptr, std::move(results));
+}
+
+std::unique_ptr<InferenceInterface> InferenceInterface::create_replica() {
+    std::unique_ptr<InferenceInterface> replica = make_replica();
+    if (replica) {
+        replica->converter_ = converter_;
+    }
+    return replica;
+}
+
 void InferenceInterface::start_timer() { inference_start_time_ = std::chrono::high_resolution_clock::now(); }
 
 void InferenceInterface::end_timer() {
@@ -112,3 +251,62 @@ void InferenceInterface::validate_input(const std::vector<std::vector<uint8_t>>&
         }
     }
 }
+
+void InferenceInterface::validate_input(const std::vector<TensorView>& inputs) const {
+    validate_model_loaded();
+
+    if (inputs.empty()) {
+        throw InferenceExecutionException("No input tensors provided");
+    }
+
+    if (inputs.size() != inference_metadata_.getInputs().size()) {
+        throw InferenceExecutionException("Input tensor count mismatch: expected " +
+                                          std::to_string(inference_metadata_.getInputs().size()) + ", got " +
+                                          std::to_string(inputs.size()));
+    }
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (inputs[i].empty() || inputs[i].data == nullptr) {
+            throw InferenceExecutionException("Input tensor at index " + std::to_string(i) + " is empty");
+        }
+    }
+}
+
+namespace {
+
+std::string shape_string(const std::vector<int64_t>& shape) {
+    std::string text = "[";
+    for (size_t i = 0; i < shape.size(); ++i) {
+        text += (i == 0 ? "" : ",") + std::to_string(shape[i]);
+    }
+    return text + "]";
+}
+
+} // namespace
+
+std::vector<int64_t> InferenceInterface::resolve_input_shape(const TensorView& input, size_t index,
+                                                             const std::vector<int64_t>& model_shape,
+                                                             size_t element_size) {
+    if (!input.has_shape()) {
+        return model_shape;
+    }
+    std::vector<int64_t> shape = input.shape_vector();
+    bool matches = shape.size() == model_shape.size();
+    size_t elements = 1;
+    for (size_t d = 0; d < shape.size(); ++d) {
+        if (shape[d] <= 0 || (matches && model_shape[d] >= 0 && shape[d] != model_shape[d])) {
+            matches = false;
+        }
+        elements *= static_cast<size_t>(shape[d] < 0 ? 0 : shape[d]);
+    }
+    if (!matches) {
+        throw InferenceExecutionException("Input shape " + shape_string(shape) + " at index " + std::to_string(index) +
+                                          " does not fit the model's input shape " + shape_string(model_shape));
+    }
+    if (elements * element_size != input.size_bytes) {
+        throw InferenceExecutionException("Input tensor at index " + std::to_string(index) + " has shape " +
+                                          shape_string(shape) + " (" + std::to_string(elements * element_size) +
+                                          " bytes) but holds " + std::to_string(input.size_bytes) + " bytes");
+    }
+    return shape;
+}
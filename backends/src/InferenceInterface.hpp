@@ -1,24 +1,41 @@
 #pragma once
 #include "common.hpp"
 
+#include <exception>
+#include <functional>
+#include <future>
 #include <memory>
 #include <stdexcept>
 #include <variant>
 using TensorElement = std::variant<float, int32_t, int64_t, uint8_t>;
 
+#include "AsyncInference.hpp"
 #include "BackendState.hpp"
 #include "InferenceMetadata.hpp"
+#include "OutputBuffer.hpp"
+#include "TensorBuffer.hpp"
 #include "TensorDtype.hpp"
+#include "TensorView.hpp"
 
-// One inference output as a typed contiguous native-endian byte buffer.
+class ITensorConverter;
+
+// One inference output as a typed contiguous native-endian byte buffer. The
+// bytes may be adopted framework memory (see TensorBuffer), kept alive for as
+// long as the tensor or any copy of it exists.
 struct RawOutputTensor {
     TensorDtype dtype = TensorDtype::FP32;
-    std::vector<uint8_t> bytes;
+    TensorBuffer bytes;
     std::vector<int64_t> shape;
 
     size_t element_count() const noexcept { return bytes.size() / tensor_dtype_size(dtype); }
 };
 
+// Conversions between variant and typed outputs. flatten_to_raw() throws
+// InferenceExecutionException when a tensor mixes element types.
+std::vector<RawOutputTensor> flatten_to_raw(std::vector<std::vector<TensorElement>> outputs,
+                                            std::vector<std::vector<int64_t>> shapes);
+std::vector<TensorElement> widen_raw_output(const RawOutputTensor& tensor);
+
 // Custom exceptions for better error handling
 class InferenceException : public std::runtime_error {
   public:
@@ -36,6 +53,12 @@ class InferenceExecutionException : public InferenceException {
         : InferenceException("Inference execution failed: " + message) {}
 };
 
+// Completion of an asynchronous inference: `error` is set on failure,
+// otherwise `results` holds what get_infer_results() would have returned.
+using InferenceCallback =
+    std::function<void(std::exception_ptr error,
+                       std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>> results)>;
+
 class InferenceInterface {
 
   public:
@@ -48,12 +71,46 @@ class InferenceInterface {
     virtual std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) = 0;
 
+    // Zero-copy input path: non-owning views over caller memory. Backends that
+    // can bind caller buffers directly override this; the default copies the
+    // views into owning vectors and calls the overload above, so every backend
+    // accepts views.
+    virtual std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs);
+
     // Raw typed-buffer inference: outputs as contiguous bytes instead of
     // per-element TensorElement variants (~16 bytes/scalar). The default
     // adapts get_infer_results(); backends override it to copy framework
     // output buffers directly. Calling through this->get_infer_results()
     // keeps decorator augmentations applied on the raw path.
     virtual std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors);
+    virtual std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs);
+
+    // Caller-buffer inference: writes each output into outputs[i] (one
+    // pre-registered buffer per model output) and fills in its dtype, size and
+    // shape. Throws InferenceExecutionException when the buffer count is wrong
+    // or an output does not fit. The default copies from
+    // get_infer_results_raw(); backends override it to have the framework
+    // write into the caller's memory directly.
+    virtual void infer_into(const std::vector<TensorView>& inputs, std::vector<OutputBuffer>& outputs);
+
+    // Asynchronous inference with the results of get_infer_results(). Owning
+    // inputs are moved in; views must stay valid until the call completes, and
+    // the backend must outlive its pending calls. Pending calls may run
+    // concurrently with each other but must not overlap synchronous calls on
+    // the same instance. Backends with native asynchronous execution override
+    // start_async(); the default runs get_infer_results() on
+    // AsyncThreadPool::shared(), one call at a time per instance.
+    std::future<std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>>
+    infer_async(AsyncInputs inputs);
+
+    // Callback form: `callback` runs on the thread that finished the
+    // inference, so it should hand heavy work elsewhere.
+    void infer_async(AsyncInputs inputs, InferenceCallback callback);
+
+    // Completion-queue form: `callback` is posted to `queue` and runs on
+    // whichever thread drains it. The queue must outlive the call.
+    void infer_async(AsyncInputs inputs, CompletionQueue& queue, InferenceCallback callback);
 
     // Model information
     virtual InferenceMetadata get_inference_metadata();
@@ -77,6 +134,21 @@ class InferenceInterface {
     virtual void clear_cache() noexcept;
     virtual size_t get_memory_usage_mb() const noexcept;
 
+    // Converter used for output element conversion. setup_inference_engine()
+    // installs the one from the backend's runtime factory; until then (or with
+    // nullptr) backends use a shared HostTensorConverter.
+    void set_tensor_converter(std::shared_ptr<const ITensorConverter> converter) noexcept {
+        converter_ = std::move(converter);
+    }
+
+    // Another instance of this backend, ready for inference and safe to call
+    // concurrently with this one, that shares the loaded weights instead of
+    // loading the model again (e.g. a second OpenVINO infer request on the
+    // same compiled model). Returns nullptr when the framework has no such
+    // sharing; BackendPool then loads an independent copy. The replica keeps
+    // this instance's tensor converter.
+    std::unique_ptr<InferenceInterface> create_replica();
+
   protected:
     InferenceMetadata inference_metadata_;
     BackendState state_{BackendState::Uninitialized};
@@ -90,8 +162,35 @@ class InferenceInterface {
 
     // Input validation
     void validate_input(const std::vector<std::vector<uint8_t>>& input_tensors) const;
+    void validate_input(const std::vector<TensorView>& inputs) const;
     void validate_model_loaded() const;
 
+    // Shape of input `index` for one call. A view without a shape uses
+    // `model_shape`. A view with one must match the rank of `model_shape`
+    // and every dim that is not dynamic (negative), and its byte count must
+    // be exactly that many elements of `element_size` bytes.
+    static std::vector<int64_t> resolve_input_shape(const TensorView& input, size_t index,
+                                                    const std::vector<int64_t>& model_shape, size_t element_size);
+
+    // infer_into() helpers: the caller must register exactly one buffer per
+    // output, and each typed output must fit its buffer's capacity.
+    static void check_output_buffer_count(const std::vector<OutputBuffer>& outputs, size_t expected);
+    static void copy_into_output_buffer(OutputBuffer& output, size_t index, TensorDtype dtype, const void* data,
+                                        size_t size_bytes);
+
+    const ITensorConverter& tensor_converter() const noexcept;
+
+    // Entry point of every infer_async() form: starts the inference and calls
+    // `done` exactly once, from any thread, when it finishes. The default posts
+    // run_async_inference() to this instance's serial executor.
+    virtual void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done);
+
+    // Runs get_infer_results() on the inputs and reports the outcome to `done`.
+    void run_async_inference(const AsyncInputs& inputs, const InferenceCallback& done);
+
+    // create_replica() hook; the default shares nothing.
+    virtual std::unique_ptr<InferenceInterface> make_replica() { return nullptr; }
+
     // Performance tracking
     void start_timer();
     void end_timer();
@@ -101,4 +200,6 @@ class InferenceInterface {
 
   private:
     std::chrono::high_resolution_clock::time_point inference_start_time_;
+    std::shared_ptr<const ITensorConverter> converter_;
+    SerialExecutor async_executor_;
 };
\ No newline at end of file
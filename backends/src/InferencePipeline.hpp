@@ -0,0 +1,381 @@
+#pragma once
+#include "InferenceInterface.hpp"
+#include "LockFreeRing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct PipelineOptions {
+    // Frames queued or running at once; push() blocks beyond this.
+    size_t max_in_flight = 16;
+    size_t preprocess_threads = 1;
+    // More than one inference thread only helps with a backend that is safe
+    // to call concurrently (BackendPool, BatchingBackend).
+    size_t inference_threads = 1;
+    size_t postprocess_threads = 1;
+};
+
+// Three-stage preprocess -> infer -> postprocess pipeline around a backend.
+//
+// Each stage runs on its own worker threads, so decoding frame N+1 overlaps
+// inference on frame N and post-processing of frame N-1. Frames live in a
+// fixed ring of max_in_flight slots; the stages hand slot indices to each
+// other through lock-free rings (SpscRing between single-threaded stages,
+// MpmcRing otherwise) and never allocate or lock on the way. Idle workers
+// back off from spinning to short sleeps.
+//
+// Backpressure: push() blocks while max_in_flight frames are in the
+// pipeline, including finished frames nobody has popped yet. Results come
+// out of pop() in push order whatever the per-stage parallelism.
+//
+// Each slot keeps its input tensors across frames, so the tensors handed to
+// the preprocess stage are recycled from the frame that used the slot
+// max_in_flight frames earlier. Assigning into them (resize, assign,
+// memcpy) reuses their storage and steady-state frames need no new input
+// buffers. Each slot also keeps one output buffer per model output, sized
+// from the first frame's outputs, and the backend writes into them through
+// infer_into(). An output the post-processing stage keeps beyond its frame
+// keeps its bytes: the slot then takes a new buffer. The first frame runs on
+// the backend's raw path, and so does every frame of a model whose metadata
+// has dynamic output dims (or none at all).
+//
+// An exception thrown by a stage or the backend skips the remaining stages
+// for that frame and is rethrown by the pop() that would have returned it.
+// push() may be called from several threads; pop() from one at a time.
+template <typename Input, typename Output> class InferencePipeline {
+  public:
+    using Tensors = std::vector<std::vector<uint8_t>>;
+    using PreprocessStage = std::function<void(const Input& input, Tensors& tensors)>;
+    using PostprocessStage = std::function<Output(const Input& input, std::vector<RawOutputTensor>& outputs)>;
+
+    InferencePipeline(InferenceInterface& backend, PreprocessStage preprocess, PostprocessStage postprocess,
+                      PipelineOptions options = {})
+        : backend_(backend), preprocess_(std::move(preprocess)), postprocess_(std::move(postprocess)),
+          options_(checked(options)), frames_(new Frame[options_.max_in_flight]),
+          to_preprocess_(0, options_.preprocess_threads, options_.max_in_flight),
+          to_infer_(options_.preprocess_threads, options_.inference_threads, options_.max_in_flight),
+          to_postprocess_(options_.inference_threads, options_.postprocess_threads, options_.max_in_flight) {
+        for (size_t i = 0; i < options_.max_in_flight; ++i) {
+            frames_[i].turn.store(i, std::memory_order_relaxed);
+        }
+        start_workers(options_.preprocess_threads, to_preprocess_, [this](uint32_t index) { run_preprocess(index); });
+        start_workers(options_.inference_threads, to_infer_, [this](uint32_t index) { run_inference(index); });
+        start_workers(options_.postprocess_threads, to_postprocess_,
+                      [this](uint32_t index) { run_postprocess(index); });
+    }
+
+    // Abandons frames that were not popped; stages finish the frame they are
+    // working on first.
+    ~InferencePipeline() {
+        close();
+        stopping_.store(true, std::memory_order_release);
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    InferencePipeline(const InferencePipeline&) = delete;
+    InferencePipeline& operator=(const InferencePipeline&) = delete;
+
+    // Queues a frame, waiting for room. Returns false once closed.
+    bool push(Input input) {
+        Backoff backoff;
+        for (;;) {
+            switch (try_claim(input)) {
+            case Claim::Queued:
+                return true;
+            case Claim::Closed:
+                return false;
+            case Claim::Full:
+                backoff.pause();
+                break;
+            }
+        }
+    }
+
+    // Queues a frame only if there is room. On false (full or closed) the
+    // input is left with the caller.
+    bool try_push(Input& input) { return try_claim(input) == Claim::Queued; }
+
+    // Next result in push order, waiting for it. Returns false once the
+    // pipeline is closed and every pushed frame has been popped.
+    bool pop(Output& output) {
+        Frame& frame = frames_[next_pop_ % options_.max_in_flight];
+        Backoff backoff;
+        while (!frame.done.load(std::memory_order_acquire)) {
+            if (closed_.load(std::memory_order_acquire) && next_pop_ == next_push_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            backoff.pause();
+        }
+        std::exception_ptr error = std::exchange(frame.error, nullptr);
+        if (!error) {
+            output = std::move(*frame.output);
+        }
+        frame.output.reset();
+        // Releases the slot's output buffers; the tensors keep their shape
+        // storage for the next frame.
+        for (RawOutputTensor& tensor : frame.outputs) {
+            tensor.bytes = TensorBuffer();
+        }
+        frame.done.store(false, std::memory_order_relaxed);
+        ++next_pop_;
+        // The slot now belongs to the frame max_in_flight pushes later.
+        frame.turn.store(next_pop_ - 1 + options_.max_in_flight, std::memory_order_release);
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return true;
+    }
+
+    // Stops accepting frames; frames already pushed still complete.
+    void close() noexcept { closed_.store(true, std::memory_order_release); }
+
+    const PipelineOptions& options() const noexcept { return options_; }
+
+  private:
+    enum class Claim { Queued, Full, Closed };
+
+    struct Frame {
+        // Sequence number that may claim this slot next.
+        std::atomic<uint64_t> turn{0};
+        // Set when the last stage (or a failure) finishes the frame.
+        std::atomic<bool> done{false};
+        Input input{};
+        Tensors tensors;
+        std::vector<TensorView> views;
+        std::vector<RawOutputTensor> outputs;
+        // Storage behind output_buffers, shared with the outputs handed to
+        // post-processing.
+        std::vector<std::shared_ptr<std::vector<uint8_t>>> output_storage;
+        std::vector<OutputBuffer> output_buffers;
+        std::optional<Output> output;
+        std::exception_ptr error;
+    };
+
+    // Ring between two stages; SPSC when each side has a single thread. Never
+    // fills up: it holds at most max_in_flight frame indices.
+    class StageQueue {
+      public:
+        StageQueue(size_t producers, size_t consumers, size_t capacity) {
+            if (producers == 1 && consumers == 1) {
+                spsc_ = std::make_unique<SpscRing<uint32_t>>(capacity);
+            } else {
+                mpmc_ = std::make_unique<MpmcRing<uint32_t>>(capacity);
+            }
+        }
+
+        void push(uint32_t index) {
+            const bool queued = spsc_ ? spsc_->try_push(index) : mpmc_->try_push(index);
+            (void)queued;
+        }
+
+        bool try_pop(uint32_t& index) { return spsc_ ? spsc_->try_pop(index) : mpmc_->try_pop(index); }
+
+      private:
+        std::unique_ptr<SpscRing<uint32_t>> spsc_;
+        std::unique_ptr<MpmcRing<uint32_t>> mpmc_;
+    };
+
+    // Spins briefly, then yields, then sleeps up to 100us between checks.
+    class Backoff {
+      public:
+        void pause() {
+            if (rounds_ < 64) {
+                ++rounds_;
+            } else if (rounds_ < 128) {
+                ++rounds_;
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(sleep_);
+                sleep_ = std::min(sleep_ * 2, std::chrono::microseconds(100));
+            }
+        }
+        void reset() noexcept {
+            rounds_ = 0;
+            sleep_ = std::chrono::microseconds(5);
+        }
+
+      private:
+        int rounds_ = 0;
+        std::chrono::microseconds sleep_{5};
+    };
+
+    static PipelineOptions checked(PipelineOptions options) {
+        if (options.max_in_flight == 0 || options.max_in_flight > UINT32_MAX || options.preprocess_threads == 0 ||
+            options.inference_threads == 0 || options.postprocess_threads == 0) {
+            throw InferenceException("InferencePipeline needs max_in_flight and every stage's thread count above 0");
+        }
+        return options;
+    }
+
+    // Claims the slot of the next sequence number once the frame that used it
+    // last has been popped. The CAS orders concurrent pushers; only the
+    // winner can own a slot whose turn matches its sequence number.
+    Claim try_claim(Input& input) {
+        uint64_t sequence = next_push_.load(std::memory_order_acquire);
+        for (;;) {
+            if (closed_.load(std::memory_order_acquire)) {
+                return Claim::Closed;
+            }
+            Frame& frame = frames_[sequence % options_.max_in_flight];
+            if (frame.turn.load(std::memory_order_acquire) != sequence) {
+                return Claim::Full;
+            }
+            if (next_push_.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                frame.input = std::move(input);
+                to_preprocess_.push(static_cast<uint32_t>(sequence % options_.max_in_flight));
+                return Claim::Queued;
+            }
+        }
+    }
+
+    template <typename Handler> void start_workers(size_t count, StageQueue& queue, Handler handler) {
+        for (size_t i = 0; i < count; ++i) {
+            workers_.emplace_back([this, &queue, handler] {
+                Backoff backoff;
+                while (!stopping_.load(std::memory_order_acquire)) {
+                    uint32_t index = 0;
+                    if (queue.try_pop(index)) {
+                        handler(index);
+                        backoff.reset();
+                    } else {
+                        backoff.pause();
+                    }
+                }
+            });
+        }
+    }
+
+    // Runs one stage on a frame; a failure finishes the frame early.
+    template <typename Step> void run_step(uint32_t index, StageQueue* next, Step step) {
+        Frame& frame = frames_[index];
+        try {
+            step(frame);
+        } catch (...) {
+            frame.error = std::current_exception();
+            frame.done.store(true, std::memory_order_release);
+            return;
+        }
+        if (next != nullptr) {
+            next->push(index);
+        } else {
+            frame.done.store(true, std::memory_order_release);
+        }
+    }
+
+    void run_preprocess(uint32_t index) {
+        run_step(index, &to_infer_, [this](Frame& frame) { preprocess_(frame.input, frame.tensors); });
+    }
+
+    void run_inference(uint32_t index) {
+        run_step(index, &to_postprocess_, [this](Frame& frame) {
+            bool inferred = false;
+            std::call_once(output_sizes_once_, [&] {
+                frame.outputs = backend_.get_infer_results_raw(frame.tensors);
+                inferred = true;
+                output_sizes_ = static_output_sizes(frame.outputs);
+            });
+            if (inferred) {
+                return;
+            }
+            if (output_sizes_.empty()) {
+                frame.outputs = backend_.get_infer_results_raw(frame.tensors);
+            } else {
+                infer_into_slot(frame);
+            }
+        });
+    }
+
+    // Bytes of each of the first frame's outputs, or empty when the metadata
+    // does not fix every output size. The metadata only decides whether the
+    // sizes are static: its dims may leave out the batch (OpenVINO), so the
+    // sizes come from the outputs themselves.
+    std::vector<size_t> static_output_sizes(const std::vector<RawOutputTensor>& outputs) {
+        try {
+            const InferenceMetadata metadata = backend_.get_inference_metadata();
+            const std::vector<LayerInfo>& layers = metadata.getOutputs();
+            if (layers.size() != outputs.size() ||
+                std::any_of(layers.begin(), layers.end(),
+                            [](const LayerInfo& layer) { return output_byte_size(layer) == 0; })) {
+                return {};
+            }
+        } catch (const InferenceException&) {
+            return {};
+        }
+        std::vector<size_t> sizes;
+        for (const RawOutputTensor& output : outputs) {
+            if (output.bytes.empty()) {
+                return {};
+            }
+            sizes.push_back(output.bytes.size());
+        }
+        return sizes;
+    }
+
+    void infer_into_slot(Frame& frame) {
+        frame.views.clear();
+        for (const std::vector<uint8_t>& tensor : frame.tensors) {
+            frame.views.emplace_back(tensor);
+        }
+        frame.output_storage.resize(output_sizes_.size());
+        frame.output_buffers.resize(output_sizes_.size());
+        for (size_t i = 0; i < output_sizes_.size(); ++i) {
+            std::shared_ptr<std::vector<uint8_t>>& storage = frame.output_storage[i];
+            // Missing on the slot's first frame; still held when an earlier
+            // output outlived its frame, which keeps those bytes.
+            if (!storage || storage.use_count() > 1) {
+                storage = std::make_shared<std::vector<uint8_t>>(output_sizes_[i]);
+                frame.output_buffers[i] = OutputBuffer(storage->data(), storage->size());
+            }
+        }
+        // Orders the last holder's reads (released with its reference) before
+        // the backend writes into the reused buffers.
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        backend_.infer_into(frame.views, frame.output_buffers);
+        frame.outputs.resize(output_sizes_.size());
+        for (size_t i = 0; i < output_sizes_.size(); ++i) {
+            const OutputBuffer& buffer = frame.output_buffers[i];
+            RawOutputTensor& output = frame.outputs[i];
+            output.dtype = buffer.dtype;
+            output.shape.assign(buffer.shape.begin(), buffer.shape.end());
+            output.bytes = TensorBuffer::share(buffer.data, buffer.size_bytes, frame.output_storage[i]);
+        }
+    }
+
+    void run_postprocess(uint32_t index) {
+        run_step(index, nullptr,
+                 [this](Frame& frame) { frame.output.emplace(postprocess_(frame.input, frame.outputs)); });
+    }
+
+    InferenceInterface& backend_;
+    PreprocessStage preprocess_;
+    PostprocessStage postprocess_;
+    const PipelineOptions options_;
+    std::unique_ptr<Frame[]> frames_;
+
+    StageQueue to_preprocess_;
+    StageQueue to_infer_;
+    StageQueue to_postprocess_;
+
+    std::once_flag output_sizes_once_;
+    std::vector<size_t> output_sizes_;
+
+    std::atomic<uint64_t> next_push_{0};
+    uint64_t next_pop_ = 0;
+    std::atomic<bool> closed_{false};
+    std::atomic<bool> stopping_{false};
+    std::vector<std::thread> workers_;
+};
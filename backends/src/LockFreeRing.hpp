@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free ring buffers for handing work between threads.
+//
+// Both rings round their capacity up to a power of two and never allocate
+// after construction. try_push() fails when the ring is full and try_pop()
+// when it is empty; callers decide whether to spin, back off or drop.
+// SpscRing is for exactly one producer and one consumer thread. MpmcRing
+// (Vyukov's bounded queue) accepts any number of each.
+
+namespace lock_free_ring_detail {
+
+// Keeps producer- and consumer-owned indices on separate cache lines.
+constexpr size_t kCacheLine = 64;
+
+inline size_t round_up_pow2(size_t value) noexcept {
+    size_t capacity = 1;
+    while (capacity < value) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+} // namespace lock_free_ring_detail
+
+template <typename T> class SpscRing {
+  public:
+    explicit SpscRing(size_t capacity)
+        : mask_(lock_free_ring_detail::round_up_pow2(capacity < 2 ? 2 : capacity) - 1),
+          slots_(new T[mask_ + 1]) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer thread only.
+    bool try_push(T value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only.
+    bool try_pop(T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        value = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const noexcept { return mask_ + 1; }
+
+  private:
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    // Consumer side: its index and its last view of the producer's.
+    alignas(lock_free_ring_detail::kCacheLine) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+
+    // Producer side.
+    alignas(lock_free_ring_detail::kCacheLine) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+};
+
+template <typename T> class MpmcRing {
+  public:
+    explicit MpmcRing(size_t capacity)
+        : mask_(lock_free_ring_detail::round_up_pow2(capacity < 2 ? 2 : capacity) - 1),
+          cells_(new Cell[mask_ + 1]) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    bool try_push(T value) {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+            if (lag == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false; // full: the cell still holds an unconsumed value
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& value) {
+        size_t position = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+            if (lag == 0) {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false; // empty
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t capacity() const noexcept { return mask_ + 1; }
+
+  private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(lock_free_ring_detail::kCacheLine) std::atomic<size_t> head_{0};
+    alignas(lock_free_ring_detail::kCacheLine) std::atomic<size_t> tail_{0};
+};
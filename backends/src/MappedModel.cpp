@@ -0,0 +1,125 @@
+#include "MappedModel.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iterator>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+
+struct LiveMapping {
+    off_t size = 0;
+    struct timespec modified {};
+    std::weak_ptr<const MappedModel> mapping;
+};
+
+std::mutex& registry_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_map<std::string, LiveMapping>& registry() {
+    static std::unordered_map<std::string, LiveMapping> mappings;
+    return mappings;
+}
+
+bool same_file_version(const LiveMapping& live, const struct stat& info) {
+    return live.size == info.st_size && live.modified.tv_sec == info.st_mtim.tv_sec &&
+           live.modified.tv_nsec == info.st_mtim.tv_nsec;
+}
+
+std::string errno_text() { return std::strerror(errno); }
+
+} // namespace
+
+std::shared_ptr<const MappedModel> MappedModel::open(const std::string& path, const MmapTuning& tuning) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw ModelLoadException("Cannot open model file " + path + ": " + errno_text());
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        const std::string reason = info.st_size <= 0 ? "empty file" : errno_text();
+        ::close(fd);
+        throw ModelLoadException("Cannot map model file " + path + ": " + reason);
+    }
+
+    const bool want_prefault = tuning.prefault == TuningToggle::On;
+    const bool want_lock = tuning.lock == TuningToggle::On;
+
+    std::lock_guard<std::mutex> guard(registry_mutex());
+    auto& mappings = registry();
+    for (auto it = mappings.begin(); it != mappings.end();) {
+        it = it->second.mapping.expired() ? mappings.erase(it) : std::next(it);
+    }
+
+    const auto live = mappings.find(path);
+    if (live != mappings.end() && same_file_version(live->second, info)) {
+        if (std::shared_ptr<const MappedModel> shared = live->second.mapping.lock()) {
+            ::close(fd);
+            if (want_prefault) {
+                shared->prefault();
+            }
+            if (want_lock) {
+                shared->lock();
+            }
+            return shared;
+        }
+    }
+
+    const auto size = static_cast<size_t>(info.st_size);
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (want_prefault) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    void* address = ::mmap(nullptr, size, PROT_READ, flags, fd, 0);
+    // The mapping keeps the file referenced; the descriptor is not needed.
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw ModelLoadException("Cannot map model file " + path + ": " + errno_text());
+    }
+
+    std::shared_ptr<const MappedModel> mapping(new MappedModel(path, static_cast<const uint8_t*>(address), size));
+    if (want_prefault) {
+        mapping->prefault();
+    }
+    if (want_lock) {
+        mapping->lock();
+    }
+    mappings[path] = LiveMapping{info.st_size, info.st_mtim, mapping};
+    LOG(INFO) << "Mapped model " << path << " (" << size << " bytes" << (want_prefault ? ", prefaulted" : "")
+              << (mapping->locked_ ? ", locked" : "") << ")";
+    return mapping;
+}
+
+MappedModel::~MappedModel() {
+    if (locked_) {
+        ::munlock(data_, size_);
+    }
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+void MappedModel::prefault() const noexcept {
+    // Starts read-ahead of the whole file; MAP_POPULATE already did the work
+    // for fresh mappings on Linux.
+    ::madvise(const_cast<uint8_t*>(data_), size_, MADV_WILLNEED);
+}
+
+void MappedModel::lock() const noexcept {
+    if (locked_) {
+        return;
+    }
+    if (::mlock(data_, size_) != 0) {
+        LOG(WARNING) << "Cannot lock model " << path_ << " in memory (" << errno_text()
+                     << "); raise RLIMIT_MEMLOCK to allow it";
+        return;
+    }
+    locked_ = true;
+}
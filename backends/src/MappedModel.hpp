@@ -0,0 +1,46 @@
+#pragma once
+#include "BackendTuning.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+// Read-only memory mapping of a model file, for backends that can load a
+// model from memory (TensorRT plans, LiteRT flatbuffers, ONNX Runtime
+// sessions from bytes) instead of reading it into a heap buffer.
+//
+// Instances of one file share a mapping: open() hands out the live mapping
+// when the file's path, size and mtime match, so N backends of the same
+// model in a process map its pages once. Mappings are MAP_PRIVATE and never
+// written, so processes share the page cache too.
+class MappedModel {
+  public:
+    // Maps `path` (or shares its live mapping). `tuning` should already be
+    // merged with the environment; prefault and lock also apply to a shared
+    // mapping that was created without them. Throws ModelLoadException when
+    // the file cannot be opened or mapped.
+    static std::shared_ptr<const MappedModel> open(const std::string& path, const MmapTuning& tuning = {});
+
+    ~MappedModel();
+    MappedModel(const MappedModel&) = delete;
+    MappedModel& operator=(const MappedModel&) = delete;
+
+    const uint8_t* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    const std::string& path() const noexcept { return path_; }
+
+  private:
+    MappedModel(std::string path, const uint8_t* data, size_t size) noexcept
+        : path_(std::move(path)), data_(data), size_(size) {}
+
+    // Both called under the registry lock.
+    void prefault() const noexcept;
+    void lock() const noexcept;
+
+    std::string path_;
+    const uint8_t* data_;
+    size_t size_;
+    mutable bool locked_ = false;
+};
@@ -1,6 +1,7 @@
 #include "ModelRunner.hpp"
 
-ModelRunner::ModelRunner(std::unique_ptr<InferenceInterface> backend) : backend_(std::move(backend)) {
+ModelRunner::ModelRunner(std::unique_ptr<InferenceInterface> backend, LoadingPolicy loading_policy)
+    : backend_(std::move(backend)), loading_policy_(loading_policy) {
     if (!backend_) {
         throw InferenceException("ModelRunner requires a non-null backend");
     }
@@ -24,15 +25,42 @@ void ModelRunner::load() {
     }
 }
 
-std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-ModelRunner::run(const std::vector<std::vector<uint8_t>>& input_tensors) {
+void ModelRunner::ensure_ready() {
     const auto current_state = backend_->state();
     if (current_state == BackendState::Failed) {
         throw InferenceExecutionException(
             "backend is in Failed state; reconstruct the backend or transition Failed -> Loading before retry");
     }
+    if (current_state == BackendState::Loading && loading_policy_ == LoadingPolicy::Reject) {
+        throw InferenceExecutionException("backend is still loading " + backend_->get_model_path() +
+                                          "; retry once it is Ready");
+    }
     if (current_state != BackendState::Ready) {
         load();
     }
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+ModelRunner::run(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    ensure_ready();
     return backend_->get_infer_results(input_tensors);
 }
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+ModelRunner::run(const std::vector<TensorView>& inputs) {
+    ensure_ready();
+    return backend_->get_infer_results(inputs);
+}
+
+std::future<std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>>
+ModelRunner::run_async(AsyncInputs inputs) {
+    if (backend_->state() != BackendState::Loading || loading_policy_ == LoadingPolicy::Reject) {
+        ensure_ready();
+    }
+    return backend_->infer_async(std::move(inputs));
+}
+
+void ModelRunner::run_into(const std::vector<TensorView>& inputs, std::vector<OutputBuffer>& outputs) {
+    ensure_ready();
+    backend_->infer_into(inputs, outputs);
+}
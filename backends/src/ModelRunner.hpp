@@ -4,6 +4,7 @@
 #include "InferenceInterface.hpp"
 
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <tuple>
 #include <vector>
@@ -14,7 +15,13 @@
 // forwards high-level calls.
 class ModelRunner {
   public:
-    explicit ModelRunner(std::unique_ptr<InferenceInterface> backend);
+    // What run*() does while the backend is still Loading in the background
+    // (see DeferredBackend): Wait queues the call until the load finishes,
+    // Reject throws InferenceExecutionException right away.
+    enum class LoadingPolicy { Wait, Reject };
+
+    explicit ModelRunner(std::unique_ptr<InferenceInterface> backend,
+                         LoadingPolicy loading_policy = LoadingPolicy::Wait);
 
     // Lifecycle orchestration. Idempotent: returns early when already Ready.
     void load();
@@ -24,6 +31,21 @@ class ModelRunner {
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     run(const std::vector<std::vector<uint8_t>>& input_tensors);
 
+    // Zero-copy variant: the views must stay valid until run() returns.
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    run(const std::vector<TensorView>& inputs);
+
+    // Asynchronous variant; loading happens on the calling thread before the
+    // inference is started, except that a backend still loading in the
+    // background starts the call once it is Ready without blocking. See
+    // InferenceInterface::infer_async().
+    std::future<std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>>
+    run_async(AsyncInputs inputs);
+
+    // Caller-buffer variant for allocation-free hot loops; see
+    // InferenceInterface::infer_into().
+    void run_into(const std::vector<TensorView>& inputs, std::vector<OutputBuffer>& outputs);
+
     // Convenience delegators.
     InferenceMetadata get_inference_metadata() { return backend_->get_inference_metadata(); }
     bool is_gpu_available() const noexcept { return backend_->is_gpu_available(); }
@@ -37,5 +59,8 @@ class ModelRunner {
     InferenceInterface* backend() const noexcept { return backend_.get(); }
 
   private:
+    void ensure_ready();
+
     std::unique_ptr<InferenceInterface> backend_;
+    LoadingPolicy loading_policy_;
 };
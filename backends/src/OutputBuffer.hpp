@@ -0,0 +1,56 @@
+#pragma once
+#include "InferenceMetadata.hpp"
+#include "TensorDtype.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Caller-owned destination for one inference output, used by
+// InferenceInterface::infer_into().
+//
+// The caller provides data/capacity_bytes once (typically sized with
+// output_byte_size() from InferenceMetadata::getOutputs()) and reuses the
+// buffer across calls. infer_into() writes the tensor into data and reports
+// dtype, size_bytes and shape; shape reuses its capacity, so a steady-state
+// loop allocates nothing here.
+struct OutputBuffer {
+    uint8_t* data = nullptr;
+    size_t capacity_bytes = 0;
+
+    // Filled by infer_into().
+    TensorDtype dtype = TensorDtype::FP32;
+    size_t size_bytes = 0;
+    std::vector<int64_t> shape;
+
+    OutputBuffer() = default;
+    OutputBuffer(void* bytes, size_t capacity) : data(static_cast<uint8_t*>(bytes)), capacity_bytes(capacity) {}
+};
+
+constexpr size_t tensor_data_type_size(TensorDataType type) noexcept {
+    switch (type) {
+    case TensorDataType::Float32:
+    case TensorDataType::Int32:
+        return 4;
+    case TensorDataType::Int64:
+        return 8;
+    case TensorDataType::UInt8:
+    case TensorDataType::Int8:
+    case TensorDataType::Bool:
+        return 1;
+    }
+    return 0;
+}
+
+// Bytes needed to hold one output described by model metadata, or 0 when the
+// shape has dynamic (negative) dimensions and is only known after inference.
+inline size_t output_byte_size(const LayerInfo& layer) noexcept {
+    size_t elements = 1;
+    for (const int64_t dim : layer.shape) {
+        if (dim < 0) {
+            return 0;
+        }
+        elements *= static_cast<size_t>(dim);
+    }
+    return elements * tensor_data_type_size(layer.datatype);
+}
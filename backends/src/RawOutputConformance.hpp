@@ -0,0 +1,87 @@
+#pragma once
+
+#include "InferenceInterface.hpp"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+/**
+ * Shared conformance check for native get_infer_results_raw() overrides.
+ *
+ * Runs the same inputs through get_infer_results() and get_infer_results_raw()
+ * and verifies that every raw output carries the dtype, shape and exact bytes
+ * of the corresponding variant output. Only meaningful for deterministic
+ * backends; usage: EXPECT_TRUE(RawMatchesVariant(backend, input_tensors)).
+ */
+inline TensorDtype ExpectedRawDtype(const TensorElement& element) {
+    return std::visit(
+        [](auto value) {
+            using Element = decltype(value);
+            if constexpr (std::is_same_v<Element, float>) {
+                return TensorDtype::FP32;
+            } else if constexpr (std::is_same_v<Element, int32_t>) {
+                return TensorDtype::INT32;
+            } else if constexpr (std::is_same_v<Element, int64_t>) {
+                return TensorDtype::INT64;
+            } else {
+                return TensorDtype::UINT8;
+            }
+        },
+        element);
+}
+
+inline ::testing::AssertionResult RawMatchesVariant(InferenceInterface& backend,
+                                                    const std::vector<std::vector<uint8_t>>& input_tensors) {
+    const auto [outputs, shapes] = backend.get_infer_results(input_tensors);
+    const std::vector<RawOutputTensor> raw = backend.get_infer_results_raw(input_tensors);
+
+    if (raw.size() != outputs.size()) {
+        return ::testing::AssertionFailure()
+               << "raw path returned " << raw.size() << " outputs, variant path " << outputs.size();
+    }
+
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        const std::vector<TensorElement>& elements = outputs[i];
+        const RawOutputTensor& tensor = raw[i];
+        const std::string where = "output " + std::to_string(i) + ": ";
+
+        if (i < shapes.size() && tensor.shape != shapes[i]) {
+            return ::testing::AssertionFailure() << where << "shape differs between raw and variant paths";
+        }
+        if (elements.empty()) {
+            if (!tensor.bytes.empty()) {
+                return ::testing::AssertionFailure() << where << "raw output has bytes for an empty variant output";
+            }
+            continue;
+        }
+
+        const TensorDtype dtype = ExpectedRawDtype(elements.front());
+        if (tensor.dtype != dtype) {
+            return ::testing::AssertionFailure() << where << "dtype differs between raw and variant paths";
+        }
+
+        const size_t element_size = tensor_dtype_size(dtype);
+        if (tensor.bytes.size() != elements.size() * element_size) {
+            return ::testing::AssertionFailure() << where << "raw output has " << tensor.bytes.size()
+                                                 << " bytes, expected " << elements.size() * element_size;
+        }
+
+        for (size_t j = 0; j < elements.size(); ++j) {
+            if (ExpectedRawDtype(elements[j]) != dtype) {
+                return ::testing::AssertionFailure() << where << "variant output mixes element types";
+            }
+            const uint8_t* bytes = tensor.bytes.data() + j * element_size;
+            const bool same =
+                std::visit([&](auto value) { return std::memcmp(bytes, &value, element_size) == 0; }, elements[j]);
+            if (!same) {
+                return ::testing::AssertionFailure() << where << "element " << j << " differs from the variant path";
+            }
+        }
+    }
+
+    return ::testing::AssertionSuccess();
+}
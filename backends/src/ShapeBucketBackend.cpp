@@ -0,0 +1,315 @@
+#include "ShapeBucketBackend.hpp"
+
+#include <algorithm>
+#include <glog/logging.h>
+#include <string>
+#include <utility>
+
+namespace {
+
+size_t element_count(const std::vector<int64_t>& shape) {
+    size_t count = 1;
+    for (const int64_t dim : shape) {
+        count *= static_cast<size_t>(dim);
+    }
+    return count;
+}
+
+// Copies the region both shapes share, `unit` values per element, from `src`
+// into `dst`: padding when `dst` is larger, cropping when it is smaller.
+template <typename T>
+void copy_region(const T* src, const std::vector<int64_t>& src_shape, T* dst, const std::vector<int64_t>& dst_shape,
+                 size_t unit) {
+    const size_t rank = src_shape.size();
+    if (rank == 0) {
+        std::copy(src, src + unit, dst);
+        return;
+    }
+    std::vector<size_t> src_strides(rank);
+    std::vector<size_t> dst_strides(rank);
+    std::vector<size_t> region(rank);
+    size_t src_stride = unit;
+    size_t dst_stride = unit;
+    for (size_t k = rank; k-- > 0;) {
+        src_strides[k] = src_stride;
+        dst_strides[k] = dst_stride;
+        src_stride *= static_cast<size_t>(src_shape[k]);
+        dst_stride *= static_cast<size_t>(dst_shape[k]);
+        region[k] = static_cast<size_t>(std::min(src_shape[k], dst_shape[k]));
+        if (region[k] == 0) {
+            return;
+        }
+    }
+
+    // Rows along the last axis are contiguous in both layouts.
+    const size_t run = region[rank - 1] * unit;
+    std::vector<size_t> index(rank, 0);
+    for (;;) {
+        size_t src_offset = 0;
+        size_t dst_offset = 0;
+        for (size_t k = 0; k + 1 < rank; ++k) {
+            src_offset += index[k] * src_strides[k];
+            dst_offset += index[k] * dst_strides[k];
+        }
+        std::copy(src + src_offset, src + src_offset + run, dst + dst_offset);
+
+        size_t k = rank - 1;
+        for (;;) {
+            if (k == 0) {
+                return;
+            }
+            --k;
+            if (++index[k] < region[k]) {
+                break;
+            }
+            index[k] = 0;
+        }
+    }
+}
+
+} // namespace
+
+std::vector<ShapeBucket> make_shape_buckets(const std::vector<size_t>& batch_sizes,
+                                            const std::vector<std::vector<std::vector<int64_t>>>& input_sizes) {
+    std::vector<ShapeBucket> buckets;
+    buckets.reserve(batch_sizes.size() * input_sizes.size());
+    for (const size_t batch_size : batch_sizes) {
+        for (const auto& sizes : input_sizes) {
+            buckets.push_back(ShapeBucket{batch_size, sizes});
+        }
+    }
+    return buckets;
+}
+
+ShapeBucketBackend::ShapeBucketBackend(const std::string& model_path, bool use_gpu, std::vector<ShapeBucket> buckets,
+                                       Loader loader, bool preload)
+    : InferenceInterface(model_path, use_gpu, 1, std::vector<std::vector<int64_t>>()), loader_(std::move(loader)) {
+    if (buckets.empty()) {
+        throw InferenceException("ShapeBucketBackend needs at least one bucket");
+    }
+    if (!loader_) {
+        throw InferenceException("ShapeBucketBackend requires a loader");
+    }
+
+    buckets_.resize(buckets.size());
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        Bucket& bucket = buckets_[b];
+        bucket.config = std::move(buckets[b]);
+        if (bucket.config.batch_size == 0 ||
+            bucket.config.input_sizes.size() != buckets_[0].config.input_sizes.size()) {
+            throw InferenceException("ShapeBucketBackend bucket " + std::to_string(b) +
+                                     " needs a batch size and the same number of inputs as the others");
+        }
+        for (const auto& sizes : bucket.config.input_sizes) {
+            std::vector<int64_t> shape{static_cast<int64_t>(bucket.config.batch_size)};
+            shape.insert(shape.end(), sizes.begin(), sizes.end());
+            if (std::any_of(shape.begin(), shape.end(), [](int64_t dim) { return dim <= 0; })) {
+                throw InferenceException("ShapeBucketBackend bucket " + std::to_string(b) + " has a non-positive dim");
+            }
+            bucket.elements += element_count(shape);
+            bucket.shapes.push_back(std::move(shape));
+        }
+        bucket.staging.resize(bucket.shapes.size());
+        if (bucket.elements > buckets_[largest_].elements) {
+            largest_ = b;
+        }
+    }
+    batch_size_ = buckets_[largest_].config.batch_size;
+
+    if (preload) {
+        for (Bucket& bucket : buckets_) {
+            try {
+                executor(bucket);
+            } catch (const InferenceExecutionException& e) {
+                throw ModelLoadException(e.what());
+            }
+        }
+    }
+    state_ = BackendState::Ready;
+}
+
+ShapeBucketBackend::~ShapeBucketBackend() = default;
+
+size_t ShapeBucketBackend::loaded_buckets() const noexcept {
+    return static_cast<size_t>(std::count_if(buckets_.begin(), buckets_.end(),
+                                             [](const Bucket& bucket) { return bucket.backend != nullptr; }));
+}
+
+InferenceInterface& ShapeBucketBackend::executor(Bucket& bucket) {
+    if (!bucket.backend) {
+        std::unique_ptr<InferenceInterface> backend;
+        std::string error = "model failed to load";
+        try {
+            backend = loader_(bucket.config);
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+        if (!backend || backend->state() != BackendState::Ready) {
+            // Not cached: the next call for this bucket tries again.
+            throw InferenceExecutionException("ShapeBucketBackend: bucket for batch " +
+                                              std::to_string(bucket.config.batch_size) + " of " + model_path_ +
+                                              " failed to load: " + error);
+        }
+        LOG(INFO) << "ShapeBucketBackend: built the batch " << bucket.config.batch_size << " bucket of "
+                  << model_path_;
+        bucket.backend = std::move(backend);
+    }
+    return *bucket.backend;
+}
+
+size_t ShapeBucketBackend::select_bucket(const std::vector<std::vector<int64_t>>& shapes) const {
+    size_t best = buckets_.size();
+    for (size_t b = 0; b < buckets_.size(); ++b) {
+        const Bucket& bucket = buckets_[b];
+        bool fits = shapes.size() == bucket.shapes.size();
+        for (size_t i = 0; fits && i < shapes.size(); ++i) {
+            fits = shapes[i].size() == bucket.shapes[i].size() &&
+                   std::equal(shapes[i].begin(), shapes[i].end(), bucket.shapes[i].begin(),
+                              [](int64_t requested, int64_t available) { return requested <= available; });
+        }
+        if (fits && (best == buckets_.size() || bucket.elements < buckets_[best].elements)) {
+            best = b;
+        }
+    }
+    if (best == buckets_.size()) {
+        throw InferenceExecutionException("ShapeBucketBackend: no bucket of " + model_path_ +
+                                          " fits the input shapes of this call");
+    }
+    return best;
+}
+
+ShapeBucketBackend::Routed ShapeBucketBackend::route(const std::vector<TensorView>& inputs) {
+    const size_t num_inputs = buckets_.front().shapes.size();
+    if (inputs.size() != num_inputs) {
+        throw InferenceExecutionException("Input tensor count mismatch: expected " + std::to_string(num_inputs) +
+                                          ", got " + std::to_string(inputs.size()));
+    }
+    const size_t shaped = static_cast<size_t>(
+        std::count_if(inputs.begin(), inputs.end(), [](const TensorView& view) { return view.has_shape(); }));
+    if (shaped == 0) {
+        Routed routed;
+        routed.bucket = &buckets_.front();
+        routed.views = inputs;
+        return routed;
+    }
+    if (shaped != num_inputs) {
+        throw InferenceExecutionException("ShapeBucketBackend: every input of a call needs a shape, or none");
+    }
+
+    std::vector<std::vector<int64_t>> shapes;
+    shapes.reserve(num_inputs);
+    for (const TensorView& view : inputs) {
+        shapes.push_back(view.shape_vector());
+    }
+    Routed routed;
+    routed.bucket = &buckets_[select_bucket(shapes)];
+    Bucket& bucket = *routed.bucket;
+    const auto metadata = executor(bucket).get_inference_metadata().getInputs();
+
+    bool padded = false;
+    routed.views.reserve(num_inputs);
+    for (size_t i = 0; i < num_inputs; ++i) {
+        const TensorView& view = inputs[i];
+        const size_t element_size = view.dtype          ? tensor_data_type_size(*view.dtype)
+                                    : i < metadata.size() ? tensor_data_type_size(metadata[i].datatype)
+                                                          : 1;
+        resolve_input_shape(view, i, std::vector<int64_t>(shapes[i].size(), -1), element_size);
+        const std::vector<int64_t>& target = bucket.shapes[i];
+        if (shapes[i] == target) {
+            routed.views.emplace_back(view.data, view.size_bytes, target, view.dtype);
+            continue;
+        }
+        std::vector<uint8_t>& staging = bucket.staging[i];
+        staging.assign(element_count(target) * element_size, 0);
+        copy_region(view.data, shapes[i], staging.data(), target, element_size);
+        routed.views.emplace_back(staging.data(), staging.size(), target, view.dtype);
+        padded = true;
+    }
+    if (padded) {
+        routed.request_shape = shapes.front();
+    }
+    return routed;
+}
+
+std::vector<int64_t> ShapeBucketBackend::unpadded_shape(const std::vector<int64_t>& output,
+                                                        const std::vector<int64_t>& padded,
+                                                        const std::vector<int64_t>& request) {
+    std::vector<int64_t> shape = output;
+    if (shape.empty()) {
+        return shape;
+    }
+    if (shape[0] == padded[0]) {
+        shape[0] = request[0];
+    }
+    for (size_t j = 1; j < shape.size() && j < padded.size(); ++j) {
+        const size_t o = shape.size() - j;
+        const size_t p = padded.size() - j;
+        if (o == 0 || p == 0 || output[o] != padded[p]) {
+            break;
+        }
+        shape[o] = request[p];
+    }
+    return shape;
+}
+
+void ShapeBucketBackend::record(const InferenceInterface& backend) noexcept {
+    last_inference_time_ms_ = backend.get_last_inference_time_ms();
+    ++total_inferences_;
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+ShapeBucketBackend::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+ShapeBucketBackend::get_infer_results(const std::vector<TensorView>& inputs) {
+    Routed routed = route(inputs);
+    InferenceInterface& backend = executor(*routed.bucket);
+    auto [outputs, shapes] = backend.get_infer_results(routed.views);
+    record(backend);
+    if (!routed.request_shape.empty()) {
+        for (size_t k = 0; k < outputs.size() && k < shapes.size(); ++k) {
+            std::vector<int64_t> shape = unpadded_shape(shapes[k], routed.bucket->shapes.front(), routed.request_shape);
+            if (shape == shapes[k] || element_count(shapes[k]) != outputs[k].size()) {
+                continue;
+            }
+            std::vector<TensorElement> cropped(element_count(shape));
+            copy_region(outputs[k].data(), shapes[k], cropped.data(), shape, 1);
+            outputs[k] = std::move(cropped);
+            shapes[k] = std::move(shape);
+        }
+    }
+    return std::make_tuple(std::move(outputs), std::move(shapes));
+}
+
+std::vector<RawOutputTensor>
+ShapeBucketBackend::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> ShapeBucketBackend::get_infer_results_raw(const std::vector<TensorView>& inputs) {
+    Routed routed = route(inputs);
+    InferenceInterface& backend = executor(*routed.bucket);
+    std::vector<RawOutputTensor> outputs = backend.get_infer_results_raw(routed.views);
+    record(backend);
+    if (!routed.request_shape.empty()) {
+        for (RawOutputTensor& output : outputs) {
+            std::vector<int64_t> shape =
+                unpadded_shape(output.shape, routed.bucket->shapes.front(), routed.request_shape);
+            const size_t element_size = tensor_dtype_size(output.dtype);
+            if (shape == output.shape || element_count(output.shape) * element_size != output.bytes.size()) {
+                continue;
+            }
+            std::vector<uint8_t> cropped(element_count(shape) * element_size);
+            copy_region(output.bytes.data(), output.shape, cropped.data(), shape, element_size);
+            output.bytes = TensorBuffer(std::move(cropped));
+            output.shape = std::move(shape);
+        }
+    }
+    return outputs;
+}
+
+InferenceMetadata ShapeBucketBackend::get_inference_metadata() {
+    return executor(buckets_[largest_]).get_inference_metadata();
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "InferenceInterface.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One input configuration a ShapeBucketBackend builds an executor for, in
+// the terms of EngineOptions: a batch size plus each input's shape without
+// the batch dim.
+struct ShapeBucket {
+    size_t batch_size = 1;
+    std::vector<std::vector<int64_t>> input_sizes;
+};
+
+// Every combination of a batch size and an input shape set, e.g. batch
+// {1,2,4,8} x resolution {{{3,320,320}}, {{3,640,640}}} gives eight buckets.
+std::vector<ShapeBucket> make_shape_buckets(const std::vector<size_t>& batch_sizes,
+                                            const std::vector<std::vector<std::vector<int64_t>>>& input_sizes);
+
+// InferenceInterface over one executor per input shape, for backends that
+// size their buffers for a single shape (TensorRT, LiteRT, MIGraphX, OpenCV
+// DNN).
+//
+// A call whose TensorViews carry shapes runs on the smallest bucket whose
+// every dim is at least the call's: inputs are zero-padded at the end of each
+// axis up to the bucket's shape, and outputs are cut back to the call's. An
+// output dim is cut when it echoes the padded input: the leading dim when it
+// equals the bucket's batch size, and trailing dims, from the last one
+// inwards, while they equal the first input's (e.g. a segmentation mask).
+// Other dims, such as a detector's box count, come back as the bucket
+// produced them. Calls without shapes run unpadded on the first bucket.
+//
+// Executors are built on first use unless `preload` is set. Like a plain
+// backend, one instance is not safe to call concurrently.
+class ShapeBucketBackend : public InferenceInterface {
+  public:
+    using Loader = std::function<std::unique_ptr<InferenceInterface>(const ShapeBucket&)>;
+
+    ShapeBucketBackend(const std::string& model_path, bool use_gpu, std::vector<ShapeBucket> buckets, Loader loader,
+                       bool preload = false);
+    ~ShapeBucketBackend() override;
+
+    ShapeBucketBackend(const ShapeBucketBackend&) = delete;
+    ShapeBucketBackend& operator=(const ShapeBucketBackend&) = delete;
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override;
+
+    // Metadata of the largest bucket, building it if needed.
+    InferenceMetadata get_inference_metadata() override;
+
+    // Index of the bucket calls with these full input shapes (batch dim
+    // included) run on; throws InferenceExecutionException if none fits.
+    size_t select_bucket(const std::vector<std::vector<int64_t>>& shapes) const;
+
+    size_t bucket_count() const noexcept { return buckets_.size(); }
+    size_t loaded_buckets() const noexcept;
+
+  private:
+    struct Bucket {
+        ShapeBucket config;
+        // Full input shapes, batch dim first.
+        std::vector<std::vector<int64_t>> shapes;
+        size_t elements = 0;
+        std::unique_ptr<InferenceInterface> backend;
+        // Padded inputs, reused between calls.
+        std::vector<std::vector<uint8_t>> staging;
+    };
+
+    // A call mapped onto a bucket.
+    struct Routed {
+        Bucket* bucket = nullptr;
+        std::vector<TensorView> views;
+        // The call's shape of the first input; empty when not padded.
+        std::vector<int64_t> request_shape;
+    };
+
+    InferenceInterface& executor(Bucket& bucket);
+    Routed route(const std::vector<TensorView>& inputs);
+    void record(const InferenceInterface& backend) noexcept;
+    static std::vector<int64_t> unpadded_shape(const std::vector<int64_t>& output, const std::vector<int64_t>& padded,
+                                               const std::vector<int64_t>& request);
+
+    std::vector<Bucket> buckets_;
+    Loader loader_;
+    size_t largest_ = 0;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Immutable bytes of one output tensor.
+//
+// A buffer either owns a std::vector<uint8_t> or adopts memory that belongs to
+// a framework object (Ort::Value, torch::Tensor, cv::Mat, ...). Adopted
+// buffers keep that owner alive until the last TensorBuffer referring to it is
+// destroyed, so backends can hand out framework memory without a final copy.
+//
+// Copies share the underlying storage and the contents are never modified
+// after construction. Backends must only adopt memory the framework will not
+// reuse on a later inference (per-call allocations, not arena slots).
+class TensorBuffer {
+  public:
+    using value_type = uint8_t;
+    using const_iterator = const uint8_t*;
+    using iterator = const_iterator;
+
+    TensorBuffer() = default;
+
+    // Implicit so code that builds a std::vector<uint8_t> can keep assigning it.
+    TensorBuffer(std::vector<uint8_t> bytes) { // NOLINT(google-explicit-constructor)
+        if (bytes.empty()) {
+            return;
+        }
+        auto storage = std::make_shared<std::vector<uint8_t>>(std::move(bytes));
+        data_ = storage->data();
+        size_ = storage->size();
+        owner_ = std::move(storage);
+    }
+
+    TensorBuffer(const uint8_t* first, const uint8_t* last) : TensorBuffer(std::vector<uint8_t>(first, last)) {}
+
+    // Adopts size_bytes at data, which `owner` keeps valid; the owner is moved
+    // into the buffer and destroyed together with its last copy.
+    template <typename Owner> static TensorBuffer adopt(const void* data, size_t size_bytes, Owner&& owner) {
+        auto holder = std::make_shared<std::decay_t<Owner>>(std::forward<Owner>(owner));
+        return TensorBuffer(static_cast<const uint8_t*>(data), size_bytes, std::move(holder));
+    }
+
+    // Adopts size_bytes at data, which the shared `owner` keeps valid. Unlike
+    // adopt(), this allocates nothing.
+    static TensorBuffer share(const void* data, size_t size_bytes, std::shared_ptr<const void> owner) {
+        return TensorBuffer(static_cast<const uint8_t*>(data), size_bytes, std::move(owner));
+    }
+
+    // Adopts size_bytes at data and calls release() once no copy refers to it.
+    template <typename Release>
+    static TensorBuffer with_release(const void* data, size_t size_bytes, Release release) {
+        std::shared_ptr<const void> guard(nullptr, [release = std::move(release)](const void*) mutable { release(); });
+        return TensorBuffer(static_cast<const uint8_t*>(data), size_bytes, std::move(guard));
+    }
+
+    void assign(const uint8_t* first, const uint8_t* last) { *this = TensorBuffer(first, last); }
+
+    const uint8_t* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    // True when the bytes belong to adopted framework memory rather than an
+    // owned vector.
+    bool is_external() const noexcept { return external_; }
+
+    std::vector<uint8_t> to_vector() const { return std::vector<uint8_t>(begin(), end()); }
+
+    friend bool operator==(const TensorBuffer& lhs, const TensorBuffer& rhs) noexcept {
+        return lhs.size_ == rhs.size_ &&
+               (lhs.data_ == rhs.data_ || lhs.size_ == 0 || std::memcmp(lhs.data_, rhs.data_, lhs.size_) == 0);
+    }
+    friend bool operator!=(const TensorBuffer& lhs, const TensorBuffer& rhs) noexcept { return !(lhs == rhs); }
+
+  private:
+    TensorBuffer(const uint8_t* data, size_t size_bytes, std::shared_ptr<const void> owner)
+        : owner_(std::move(owner)), data_(data), size_(size_bytes), external_(true) {}
+
+    std::shared_ptr<const void> owner_;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool external_ = false;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include "TensorDataType.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Non-owning view of one inference input: a contiguous native-endian byte
+// buffer plus an optional per-call shape and element type.
+//
+// Views never copy. The caller keeps the referenced bytes (and the shape
+// array, when set) alive until the inference call returns. An unset shape or
+// dtype means "use the model metadata", which is exactly how the legacy
+// std::vector<uint8_t> inputs are interpreted, so a view built from a byte
+// vector behaves identically to passing the vector itself.
+struct TensorView {
+    const uint8_t* data = nullptr;
+    size_t size_bytes = 0;
+    const int64_t* shape = nullptr;
+    size_t ndim = 0;
+    std::optional<TensorDataType> dtype;
+
+    TensorView() = default;
+
+    TensorView(const void* bytes, size_t byte_count)
+        : data(static_cast<const uint8_t*>(bytes)), size_bytes(byte_count) {}
+
+    TensorView(const void* bytes, size_t byte_count, const std::vector<int64_t>& dims,
+               std::optional<TensorDataType> element_type = std::nullopt)
+        : data(static_cast<const uint8_t*>(bytes)), size_bytes(byte_count), shape(dims.data()), ndim(dims.size()),
+          dtype(element_type) {}
+
+    // Explicit so braced std::vector<std::vector<uint8_t>> arguments never
+    // become ambiguous with the view overloads.
+    explicit TensorView(const std::vector<uint8_t>& bytes) : TensorView(bytes.data(), bytes.size()) {}
+
+    bool empty() const noexcept { return size_bytes == 0; }
+    bool has_shape() const noexcept { return shape != nullptr; }
+
+    std::vector<int64_t> shape_vector() const {
+        return has_shape() ? std::vector<int64_t>(shape, shape + ndim) : std::vector<int64_t>();
+    }
+};
+
+// Views over legacy owning inputs; the vectors must outlive the views.
+inline std::vector<TensorView> make_tensor_views(const std::vector<std::vector<uint8_t>>& tensors) {
+    std::vector<TensorView> views;
+    views.reserve(tensors.size());
+    for (const auto& tensor : tensors) {
+        views.emplace_back(tensor);
+    }
+    return views;
+}
+
+// Owning copies of views, for backends that still implement only the
+// std::vector<std::vector<uint8_t>> entry point.
+inline std::vector<std::vector<uint8_t>> copy_tensor_views(const std::vector<TensorView>& views) {
+    std::vector<std::vector<uint8_t>> tensors;
+    tensors.reserve(views.size());
+    for (const TensorView& view : views) {
+        tensors.emplace_back(view.data, view.data + view.size_bytes);
+    }
+    return tensors;
+}
@@ -0,0 +1,75 @@
+#include "Warmup.hpp"
+
+#include "OutputBuffer.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <glog/logging.h>
+
+namespace {
+
+// Relative latency change between consecutive calls treated as steady state.
+constexpr double kStableTolerance = 0.1;
+
+} // namespace
+
+std::vector<std::vector<uint8_t>> synthesize_warmup_inputs(const InferenceMetadata& metadata,
+                                                           const std::vector<std::vector<int64_t>>& input_sizes) {
+    std::vector<std::vector<uint8_t>> inputs;
+    inputs.reserve(metadata.getInputs().size());
+    for (size_t i = 0; i < metadata.getInputs().size(); ++i) {
+        const LayerInfo& layer = metadata.getInputs()[i];
+        const std::vector<int64_t>* provided = i < input_sizes.size() ? &input_sizes[i] : nullptr;
+        size_t elements = 1;
+        for (size_t d = 0; d < layer.shape.size(); ++d) {
+            int64_t dim = layer.shape[d];
+            if (dim <= 0) {
+                if (d == 0) {
+                    dim = static_cast<int64_t>(layer.batch_size);
+                } else if (provided != nullptr && d - 1 < provided->size()) {
+                    dim = (*provided)[d - 1];
+                }
+            }
+            elements *= static_cast<size_t>(dim > 0 ? dim : 1);
+        }
+        inputs.emplace_back(elements * tensor_data_type_size(layer.datatype), 0);
+    }
+    return inputs;
+}
+
+WarmupResult warm_up(InferenceInterface& backend, size_t max_iterations,
+                     const std::vector<std::vector<std::vector<uint8_t>>>& samples,
+                     const std::vector<std::vector<int64_t>>& input_sizes) {
+    WarmupResult result;
+    if (max_iterations == 0) {
+        return result;
+    }
+
+    std::vector<std::vector<std::vector<uint8_t>>> synthesized;
+    if (samples.empty()) {
+        synthesized.push_back(synthesize_warmup_inputs(backend.get_inference_metadata(), input_sizes));
+    }
+    const auto& inputs = samples.empty() ? synthesized : samples;
+
+    double previous_ms = 0.0;
+    while (result.iterations < max_iterations) {
+        const auto& sample = inputs[result.iterations % inputs.size()];
+        const auto start = std::chrono::steady_clock::now();
+        backend.get_infer_results(sample);
+        const double elapsed_ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (result.iterations == 0) {
+            result.first_ms = elapsed_ms;
+        }
+        result.last_ms = elapsed_ms;
+        ++result.iterations;
+        if (result.iterations > 1 && std::abs(elapsed_ms - previous_ms) <= kStableTolerance * previous_ms) {
+            break;
+        }
+        previous_ms = elapsed_ms;
+    }
+    LOG(INFO) << "Warmed up " << backend.get_model_path() << " in " << result.iterations << " inferences ("
+              << result.first_ms << " ms -> " << result.last_ms << " ms)";
+    return result;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "InferenceInterface.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// First inferences after a load run far slower than steady state on most
+// frameworks (lazy kernel selection, JIT profiling, allocator growth, weight
+// repacking). Warming up runs representative inferences before a backend
+// takes traffic so callers never see that tail.
+
+// Zero-filled inputs sized and typed from the backend's input metadata.
+// Dynamic dimensions (<= 0) take the layer's batch size for the leading one
+// and the matching entry of `input_sizes` (which, as in EngineOptions, omits
+// the batch dimension) or 1 for the others.
+std::vector<std::vector<uint8_t>> synthesize_warmup_inputs(const InferenceMetadata& metadata,
+                                                           const std::vector<std::vector<int64_t>>& input_sizes = {});
+
+struct WarmupResult {
+    size_t iterations = 0;
+    double first_ms = 0.0;
+    double last_ms = 0.0;
+};
+
+// Runs up to `max_iterations` inferences on `backend`, cycling through
+// `samples` or, when there are none, synthesize_warmup_inputs(). Stops early
+// once two consecutive calls are within 10% of each other. Inference errors
+// propagate.
+WarmupResult warm_up(InferenceInterface& backend, size_t max_iterations,
+                     const std::vector<std::vector<std::vector<uint8_t>>>& samples = {},
+                     const std::vector<std::vector<int64_t>>& input_sizes = {});
@@ -0,0 +1,392 @@
+#pragma once
+#include "BackendDecorator.hpp"
+#include "ConvertKernels.hpp"
+#include "ITensorConverter.hpp"
+#include "InferenceInterface.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// How BatchingBackend fills a merged batch that is smaller than the maximum.
+// Models exported with a static batch dimension need Zero or RepeatLast; the
+// padded rows are run and their outputs discarded.
+enum class BatchPadding { None, Zero, RepeatLast };
+
+struct BatchingOptions {
+    // Rows per merged inference; 0 uses the wrapped backend's get_batch_size().
+    size_t max_batch_size = 0;
+    // How long the first queued request waits for others before its batch runs.
+    std::chrono::microseconds max_delay{2000};
+    BatchPadding padding = BatchPadding::None;
+};
+
+// Decorator that merges concurrent requests into one batched inference.
+//
+// Each call contributes the rows of its inputs (dim 0 of the first input's
+// view shape, or one row without a shape). Calls arriving while a batch is
+// filling or running are queued; the first queued caller waits until
+// max_batch_size rows are queued or max_delay has passed, concatenates the
+// compatible requests along dim 0, runs the wrapped backend's raw path once and
+// hands every caller its slice of each output. Slices share the merged output
+// buffers, so scattering copies nothing.
+//
+// Requests are merged only when they have the same number of inputs and the
+// same per-row byte size, dtype and trailing shape for each of them. Every
+// output of the model must carry the batch as dim 0; a batch whose outputs do
+// not fails all of its callers with InferenceExecutionException. A caller that
+// ends up alone in its batch (and needs no padding) is forwarded unchanged, so
+// single-threaded use behaves exactly like the undecorated backend.
+//
+// The wrapped backend is only ever called by one thread at a time. BatchingBackend
+// and CachingBackend are the decorators that are safe to call concurrently, so
+// any other decorator must sit inside them. To serve cache hits without
+// waiting for a batch, put CachingBackend outside BatchingBackend and set
+// CachingOptions::concurrent_inner so that concurrent misses can reach the
+// batcher together; otherwise the cache runs one miss at a time and nothing is
+// left to batch.
+class BatchingBackend : public BackendDecorator {
+
+  public:
+    explicit BatchingBackend(std::unique_ptr<InferenceInterface> inner, BatchingOptions options = {})
+        : BackendDecorator(std::move(inner)), options_(options) {
+        if (options_.max_batch_size == 0) {
+            options_.max_batch_size = std::max<size_t>(inner_->get_batch_size(), 1);
+        }
+    }
+
+    using BackendDecorator::get_infer_results;
+    using BackendDecorator::get_infer_results_raw;
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        Request request(inputs, /*wants_variant=*/true);
+        submit(request);
+        if (request.value) {
+            return std::move(*request.value);
+        }
+        return to_variant(request.raw);
+    }
+
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override {
+        Request request(inputs, /*wants_variant=*/false);
+        submit(request);
+        return std::move(request.raw);
+    }
+
+    const BatchingOptions& options() const noexcept { return options_; }
+
+    // Inferences run on the wrapped backend so far and the requests they served.
+    size_t batches_run() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batches_run_;
+    }
+    size_t requests_served() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return requests_served_;
+    }
+
+  protected:
+    std::unique_ptr<InferenceInterface> rewrap(std::unique_ptr<InferenceInterface> inner) override {
+        return std::make_unique<BatchingBackend>(std::move(inner), options_);
+    }
+
+    // Asynchronous calls wait for their batch on a pool thread instead of
+    // queueing behind each other, so they can share inferences too.
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override {
+        AsyncThreadPool::shared().submit(
+            [this, inputs = std::move(inputs), done = std::move(done)] { run_async_inference(*inputs, done); });
+    }
+
+  private:
+    using ResultTuple = std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>;
+
+    // One caller's pending call. Lives on the caller's stack; the queue only
+    // points at it, and the caller does not return before `done` is set.
+    struct Request {
+        Request(const std::vector<TensorView>& request_inputs, bool variant)
+            : inputs(request_inputs), rows(leading_rows(request_inputs)), wants_variant(variant),
+              enqueued(std::chrono::steady_clock::now()) {}
+
+        const std::vector<TensorView>& inputs;
+        size_t rows;
+        bool wants_variant;
+        std::chrono::steady_clock::time_point enqueued;
+
+        bool done = false;
+        std::vector<RawOutputTensor> raw;
+        std::optional<ResultTuple> value;
+        std::exception_ptr error;
+    };
+
+    static size_t leading_rows(const std::vector<TensorView>& inputs) noexcept {
+        if (inputs.empty() || !inputs.front().has_shape() || inputs.front().ndim == 0 || inputs.front().shape[0] <= 0) {
+            return 1;
+        }
+        return static_cast<size_t>(inputs.front().shape[0]);
+    }
+
+    // Leader/follower batching without a worker thread: whichever waiting
+    // caller finds no leader collects the next batch and runs it on its own
+    // thread, then hands leadership on.
+    void submit(Request& request) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        queue_.push_back(&request);
+        queued_rows_ += request.rows;
+        cv_.notify_all();
+
+        while (!request.done) {
+            if (leader_active_) {
+                cv_.wait(lock);
+                continue;
+            }
+
+            leader_active_ = true;
+            const auto deadline = queue_.front()->enqueued + options_.max_delay;
+            cv_.wait_until(lock, deadline, [this] { return queued_rows_ >= options_.max_batch_size; });
+            std::vector<Request*> batch = take_batch();
+
+            lock.unlock();
+            run_batch(batch);
+            lock.lock();
+
+            for (Request* member : batch) {
+                member->done = true;
+            }
+            ++batches_run_;
+            requests_served_ += batch.size();
+            leader_active_ = false;
+            cv_.notify_all();
+        }
+
+        lock.unlock();
+        if (request.error) {
+            std::rethrow_exception(request.error);
+        }
+    }
+
+    // Removes the oldest request plus every later one that can share its
+    // batch, up to max_batch_size rows. Called with mutex_ held.
+    std::vector<Request*> take_batch() {
+        std::vector<Request*> batch{queue_.front()};
+        queue_.pop_front();
+        size_t rows = batch.front()->rows;
+
+        if (mergeable(*batch.front())) {
+            for (auto it = queue_.begin(); it != queue_.end() && rows < options_.max_batch_size;) {
+                if (rows + (*it)->rows <= options_.max_batch_size && compatible(*batch.front(), **it)) {
+                    rows += (*it)->rows;
+                    batch.push_back(*it);
+                    it = queue_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        for (const Request* member : batch) {
+            queued_rows_ -= member->rows;
+        }
+        return batch;
+    }
+
+    bool mergeable(const Request& request) const noexcept {
+        if (request.inputs.empty() || request.rows > options_.max_batch_size) {
+            return false;
+        }
+        for (const TensorView& view : request.inputs) {
+            if (view.data == nullptr || view.size_bytes == 0 || view.size_bytes % request.rows != 0 ||
+                (view.has_shape() && (view.ndim == 0 || view.shape[0] != static_cast<int64_t>(request.rows)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool compatible(const Request& first, const Request& other) const noexcept {
+        if (!mergeable(other) || other.inputs.size() != first.inputs.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < first.inputs.size(); ++i) {
+            const TensorView& a = first.inputs[i];
+            const TensorView& b = other.inputs[i];
+            if (a.size_bytes / first.rows != b.size_bytes / other.rows || a.dtype != b.dtype ||
+                a.has_shape() != b.has_shape()) {
+                return false;
+            }
+            if (a.has_shape() && (a.ndim != b.ndim || !std::equal(a.shape + 1, a.shape + a.ndim, b.shape + 1))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void run_batch(const std::vector<Request*>& batch) {
+        try {
+            Request& first = *batch.front();
+            const bool pad = options_.padding != BatchPadding::None && first.rows < options_.max_batch_size;
+            if (batch.size() == 1 && (!pad || !mergeable(first))) {
+                if (first.wants_variant) {
+                    first.value = BackendDecorator::get_infer_results(first.inputs);
+                } else {
+                    first.raw = forward_raw(first.inputs);
+                }
+                return;
+            }
+            run_merged(batch);
+        } catch (...) {
+            const std::exception_ptr error = std::current_exception();
+            for (Request* member : batch) {
+                member->error = error;
+            }
+        }
+    }
+
+    void run_merged(const std::vector<Request*>& batch) {
+        const Request& first = *batch.front();
+        size_t rows = 0;
+        for (const Request* member : batch) {
+            rows += member->rows;
+        }
+        const size_t padded_rows =
+            options_.padding == BatchPadding::None ? rows : std::max(rows, options_.max_batch_size);
+
+        const size_t num_inputs = first.inputs.size();
+        std::vector<std::vector<uint8_t>> merged(num_inputs);
+        std::vector<std::vector<int64_t>> shapes(num_inputs);
+        std::vector<TensorView> views;
+        views.reserve(num_inputs);
+        for (size_t i = 0; i < num_inputs; ++i) {
+            const TensorView& head = first.inputs[i];
+            const size_t row_bytes = head.size_bytes / first.rows;
+
+            std::vector<uint8_t>& bytes = merged[i];
+            bytes.reserve(padded_rows * row_bytes);
+            for (const Request* member : batch) {
+                const TensorView& view = member->inputs[i];
+                bytes.insert(bytes.end(), view.data, view.data + view.size_bytes);
+            }
+            if (options_.padding == BatchPadding::Zero) {
+                bytes.resize(padded_rows * row_bytes, 0);
+            } else if (options_.padding == BatchPadding::RepeatLast) {
+                const std::vector<uint8_t> last_row(bytes.end() - row_bytes, bytes.end());
+                for (size_t row = rows; row < padded_rows; ++row) {
+                    bytes.insert(bytes.end(), last_row.begin(), last_row.end());
+                }
+            }
+
+            shapes[i] = batched_shape(head, row_bytes, i, padded_rows);
+            TensorView view(bytes.data(), bytes.size());
+            if (!shapes[i].empty()) {
+                view = TensorView(bytes.data(), bytes.size(), shapes[i]);
+            }
+            view.dtype = head.dtype;
+            views.push_back(view);
+        }
+
+        const std::vector<RawOutputTensor> outputs = forward_raw(views);
+        for (size_t k = 0; k < outputs.size(); ++k) {
+            if (outputs[k].shape.empty() || outputs[k].shape[0] != static_cast<int64_t>(padded_rows)) {
+                throw InferenceExecutionException("BatchingBackend: output " + std::to_string(k) +
+                                                  " does not carry the batch as dim 0");
+            }
+        }
+
+        size_t row_offset = 0;
+        for (Request* member : batch) {
+            member->raw.reserve(outputs.size());
+            for (const RawOutputTensor& output : outputs) {
+                const size_t row_bytes = output.bytes.size() / padded_rows;
+                RawOutputTensor slice;
+                slice.dtype = output.dtype;
+                slice.shape = output.shape;
+                slice.shape[0] = static_cast<int64_t>(member->rows);
+                slice.bytes = TensorBuffer::adopt(output.bytes.data() + row_offset * row_bytes,
+                                                  member->rows * row_bytes, output.bytes);
+                member->raw.push_back(std::move(slice));
+            }
+            row_offset += member->rows;
+        }
+    }
+
+    // Shape of merged input i: the callers' shape, else the model's input
+    // shape when every non-batch dimension is static; empty lets the backend
+    // fall back to its metadata. Backends such as OpenVINO leave the batch
+    // dimension out of their metadata, so a metadata shape that spans one
+    // whole row gets the row count prepended instead of written over dim 0.
+    std::vector<int64_t> batched_shape(const TensorView& head, size_t row_bytes, size_t index, size_t rows) {
+        std::vector<int64_t> shape = head.shape_vector();
+        if (!shape.empty()) {
+            shape[0] = static_cast<int64_t>(rows);
+            return shape;
+        }
+        const std::vector<LayerInfo>& layers = model_inputs();
+        if (index >= layers.size()) {
+            return {};
+        }
+        const LayerInfo& layer = layers[index];
+        shape = layer.shape;
+        if (shape.empty() || std::any_of(shape.begin() + 1, shape.end(), [](int64_t dim) { return dim < 0; })) {
+            return {};
+        }
+        size_t row_elements = 1;
+        for (auto dim = shape.begin() + 1; dim != shape.end(); ++dim) {
+            row_elements *= static_cast<size_t>(*dim);
+        }
+        const size_t element_size = tensor_data_type_size(head.dtype.value_or(layer.datatype));
+        if (row_elements * element_size != row_bytes && shape[0] > 0 &&
+            row_elements * static_cast<size_t>(shape[0]) * element_size == row_bytes) {
+            shape.insert(shape.begin(), static_cast<int64_t>(rows));
+            return shape;
+        }
+        shape[0] = static_cast<int64_t>(rows);
+        return shape;
+    }
+
+    // Only called by the current leader, so no locking is needed.
+    const std::vector<LayerInfo>& model_inputs() {
+        if (!model_inputs_) {
+            model_inputs_.emplace();
+            try {
+                *model_inputs_ = inner_->get_inference_metadata().getInputs();
+            } catch (const InferenceException&) {
+                // No metadata (e.g. OpenCV DNN): merged inputs go without a shape.
+            }
+        }
+        return *model_inputs_;
+    }
+
+    ResultTuple to_variant(const std::vector<RawOutputTensor>& raw) const {
+        std::vector<std::vector<TensorElement>> outputs(raw.size());
+        std::vector<std::vector<int64_t>> shapes;
+        shapes.reserve(raw.size());
+        for (size_t k = 0; k < raw.size(); ++k) {
+            tensor_converter().append_elements(outputs[k], raw[k].bytes.data(), raw[k].element_count(),
+                                               to_element_type(raw[k].dtype));
+            shapes.push_back(raw[k].shape);
+        }
+        return {std::move(outputs), std::move(shapes)};
+    }
+
+    BatchingOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Request*> queue_;
+    size_t queued_rows_ = 0;
+    bool leader_active_ = false;
+    size_t batches_run_ = 0;
+    size_t requests_served_ = 0;
+
+    std::optional<std::vector<LayerInfo>> model_inputs_;
+};
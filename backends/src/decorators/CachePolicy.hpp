@@ -0,0 +1,278 @@
+#pragma once
+#include "ContentHash.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Decides which entries one CachingBackend shard keeps.
+//
+// The shard reports every lookup and every stored entry. When it goes over
+// its entry or byte limit it asks for victims one at a time until it fits
+// again, and drops whichever entry evict() names. Calls are made with the
+// shard's lock held, so implementations need no locking of their own.
+class CachePolicy {
+  public:
+    // An entry to drop. `rejected` when it is a newcomer refused admission
+    // rather than an established entry being evicted.
+    struct Victim {
+        ContentHash128 key;
+        bool rejected = false;
+    };
+
+    virtual ~CachePolicy() = default;
+
+    // A lookup of `key`, whether it hits or not.
+    virtual void record_access(const ContentHash128& key) { (void)key; }
+    // A stored entry was read.
+    virtual void on_hit(const ContentHash128& key) = 0;
+    // A new entry was stored.
+    virtual void on_insert(const ContentHash128& key) = 0;
+    // Picks one of the stored entries and forgets it. Only called while at
+    // least two entries are stored.
+    virtual Victim evict() = 0;
+    // Every entry was dropped.
+    virtual void clear() = 0;
+};
+
+// Builds the policy of one shard, given the most entries it may hold (0 =
+// no entry limit).
+using CachePolicyFactory = std::function<std::unique_ptr<CachePolicy>(size_t shard_entries)>;
+
+// Least recently used first. CachingBackend's default.
+class LruPolicy : public CachePolicy {
+  public:
+    void on_hit(const ContentHash128& key) override {
+        auto it = positions_.find(key);
+        if (it != positions_.end()) {
+            order_.splice(order_.begin(), order_, it->second);
+        }
+    }
+
+    void on_insert(const ContentHash128& key) override {
+        order_.push_front(key);
+        positions_[key] = order_.begin();
+    }
+
+    Victim evict() override {
+        Victim victim{order_.back(), false};
+        positions_.erase(victim.key);
+        order_.pop_back();
+        return victim;
+    }
+
+    void clear() override {
+        order_.clear();
+        positions_.clear();
+    }
+
+  private:
+    struct KeyHash {
+        size_t operator()(const ContentHash128& key) const noexcept { return static_cast<size_t>(key.low); }
+    };
+
+    // Most recently used first.
+    std::list<ContentHash128> order_;
+    std::unordered_map<ContentHash128, std::list<ContentHash128>::iterator, KeyHash> positions_;
+};
+
+// Approximate access counts in a count-min sketch: four rows of saturating
+// 4-bit counters, four per expected entry so that one-off keys rarely share
+// all their counters with a popular one. Every counter is halved once the
+// recorded accesses reach ten times the row width, so old popularity fades.
+class FrequencySketch {
+  public:
+    explicit FrequencySketch(size_t expected_entries) {
+        size_t width = 64;
+        while (width < 4 * expected_entries) {
+            width <<= 1;
+        }
+        mask_ = width - 1;
+        counters_.assign(kRows * width, 0);
+        sample_size_ = 10 * width;
+    }
+
+    void increment(const ContentHash128& key) noexcept {
+        for (size_t row = 0; row < kRows; ++row) {
+            uint8_t& counter = counters_[slot(key, row)];
+            if (counter < kMaxCount) {
+                ++counter;
+            }
+        }
+        if (++additions_ >= sample_size_) {
+            for (uint8_t& counter : counters_) {
+                counter >>= 1;
+            }
+            additions_ /= 2;
+        }
+    }
+
+    unsigned frequency(const ContentHash128& key) const noexcept {
+        unsigned count = kMaxCount;
+        for (size_t row = 0; row < kRows; ++row) {
+            count = std::min<unsigned>(count, counters_[slot(key, row)]);
+        }
+        return count;
+    }
+
+    void clear() noexcept {
+        std::fill(counters_.begin(), counters_.end(), 0);
+        additions_ = 0;
+    }
+
+  private:
+    static constexpr size_t kRows = 4;
+    static constexpr uint8_t kMaxCount = 15;
+
+    size_t slot(const ContentHash128& key, size_t row) const noexcept {
+        // Both halves of the key are well mixed, so combining them gives each
+        // row its own index.
+        const uint64_t index = key.low + row * (key.high | 1);
+        return row * (mask_ + 1) + static_cast<size_t>((index ^ (index >> 32)) & mask_);
+    }
+
+    std::vector<uint8_t> counters_;
+    size_t mask_ = 0;
+    size_t sample_size_ = 0;
+    size_t additions_ = 0;
+};
+
+// Window TinyLFU: scan-resistant admission in front of a segmented LRU.
+//
+// New entries enter a small LRU window (1% of the entries). An entry leaving
+// the window must then beat the main area's next victim on access frequency,
+// as estimated by a FrequencySketch of every lookup; otherwise it is
+// rejected. A stream of one-off inputs therefore cycles through the window
+// without displacing entries that are read repeatedly. The main area is a
+// segmented LRU: entries are admitted on probation and move to the protected
+// segment (80% of the main area) when read again.
+//
+// Without an entry limit the segments are sized for kDefaultEntries, and
+// byte-budget evictions still go through the frequency comparison.
+class TinyLfuPolicy : public CachePolicy {
+  public:
+    static constexpr size_t kDefaultEntries = 1024;
+
+    explicit TinyLfuPolicy(size_t max_entries)
+        : capacity_(max_entries == 0 ? kDefaultEntries : max_entries), sketch_(capacity_) {
+        window_capacity_ = std::max<size_t>(1, capacity_ / 100);
+        main_capacity_ = capacity_ > window_capacity_ ? capacity_ - window_capacity_ : 1;
+        protected_capacity_ = main_capacity_ * 4 / 5;
+    }
+
+    void record_access(const ContentHash128& key) override { sketch_.increment(key); }
+
+    void on_hit(const ContentHash128& key) override {
+        auto it = positions_.find(key);
+        if (it == positions_.end()) {
+            return;
+        }
+        Position& position = it->second;
+        if (position.segment == Segment::Probation) {
+            move_to(position, Segment::Protected);
+            while (protected_.size() > protected_capacity_) {
+                // Demote the least recently used protected entry.
+                move_to(positions_.at(protected_.back()), Segment::Probation);
+            }
+        } else {
+            std::list<ContentHash128>& list = segment(position.segment);
+            list.splice(list.begin(), list, position.it);
+        }
+    }
+
+    void on_insert(const ContentHash128& key) override {
+        window_.push_front(key);
+        positions_[key] = Position{Segment::Window, window_.begin()};
+        // Entries leaving the window are admitted freely while the main area
+        // has room.
+        while (window_.size() > window_capacity_ && probation_.size() + protected_.size() < main_capacity_) {
+            move_to(positions_.at(window_.back()), Segment::Probation);
+        }
+    }
+
+    Victim evict() override {
+        const bool has_main = !probation_.empty() || !protected_.empty();
+        if (window_.empty() || !has_main) {
+            return forget(window_.empty() ? main_victim() : window_.back(), false);
+        }
+        const ContentHash128 candidate = window_.back();
+        const ContentHash128 victim = main_victim();
+        if (sketch_.frequency(candidate) > sketch_.frequency(victim)) {
+            move_to(positions_.at(candidate), Segment::Probation);
+            return forget(victim, false);
+        }
+        return forget(candidate, true);
+    }
+
+    void clear() override {
+        window_.clear();
+        probation_.clear();
+        protected_.clear();
+        positions_.clear();
+        sketch_.clear();
+    }
+
+  private:
+    enum class Segment { Window, Probation, Protected };
+
+    struct Position {
+        Segment segment;
+        std::list<ContentHash128>::iterator it;
+    };
+
+    struct KeyHash {
+        size_t operator()(const ContentHash128& key) const noexcept { return static_cast<size_t>(key.low); }
+    };
+
+    std::list<ContentHash128>& segment(Segment which) noexcept {
+        switch (which) {
+        case Segment::Window:
+            return window_;
+        case Segment::Probation:
+            return probation_;
+        case Segment::Protected:
+            break;
+        }
+        return protected_;
+    }
+
+    // Moves an entry to the most recently used end of `target`.
+    void move_to(Position& position, Segment target) {
+        std::list<ContentHash128>& to = segment(target);
+        to.splice(to.begin(), segment(position.segment), position.it);
+        position.segment = target;
+    }
+
+    ContentHash128 main_victim() const { return probation_.empty() ? protected_.back() : probation_.back(); }
+
+    Victim forget(const ContentHash128& key, bool rejected) {
+        auto it = positions_.find(key);
+        segment(it->second.segment).erase(it->second.it);
+        positions_.erase(it);
+        return Victim{key, rejected};
+    }
+
+    size_t capacity_;
+    size_t window_capacity_ = 1;
+    size_t main_capacity_ = 1;
+    size_t protected_capacity_ = 0;
+    FrequencySketch sketch_;
+    // Most recently used first.
+    std::list<ContentHash128> window_;
+    std::list<ContentHash128> probation_;
+    std::list<ContentHash128> protected_;
+    std::unordered_map<ContentHash128, Position, KeyHash> positions_;
+};
+
+inline CachePolicyFactory lru_cache_policy() {
+    return [](size_t) { return std::make_unique<LruPolicy>(); };
+}
+
+inline CachePolicyFactory tiny_lfu_cache_policy() {
+    return [](size_t shard_entries) { return std::make_unique<TinyLfuPolicy>(shard_entries); };
+}
@@ -1,119 +1,654 @@
 #pragma once
 #include "BackendDecorator.hpp"
+#include "CachePolicy.hpp"
+#include "ContentHash.hpp"
 #include "InferenceInterface.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
-#include <list>
+#include <cstring>
+#include <exception>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
-// Decorator that memoizes inference results in a bounded LRU cache.
+struct CachingOptions {
+    // Most entries kept; 0 = no entry limit.
+    size_t max_entries = 16;
+    // Most bytes of cached outputs plus a fixed charge per entry; 0 = no
+    // byte limit. A result larger than its shard's share is not cached.
+    size_t max_bytes = 0;
+    // Independently locked shards, each with its own share of the limits
+    // and its own policy; 0 = one per 8 entries of max_entries, at most 16.
+    size_t shards = 0;
+    // Which entries each shard keeps: lru_cache_policy() when empty, or e.g.
+    // tiny_lfu_cache_policy() for workloads with scans of one-off inputs.
+    CachePolicyFactory policy;
+    // The wrapped backend may run several misses at once (e.g. a
+    // BackendPool). Otherwise misses are serialized; hits never wait on them.
+    bool concurrent_inner = false;
+    // Cache each sample of a batched call on its own; see CachingBackend.
+    bool per_sample = false;
+};
+
+// Cumulative CachingBackend counters.
+struct CachingStats {
+    // Calls served without running the wrapped backend, including ones that
+    // waited for an identical call already running. Per-sample calls count
+    // each row.
+    size_t hits = 0;
+    size_t misses = 0;
+    // New entries the policy dropped instead of an established one.
+    size_t admission_rejects = 0;
+    // Established entries dropped to make room.
+    size_t evictions = 0;
+};
+
+// Decorator that memoizes inference results in bounded caches.
 //
-// Wraps any InferenceInterface and keys cached outputs on a hash of the raw
-// input bytes plus the per-tensor sizes. On a cache hit the stored input bytes
-// are compared before returning a cached result; hash collisions fall through
-// to a real inference. On a miss the call is forwarded, the result stored, and
-// the least-recently-used entry evicted once the capacity is exceeded.
+// Wraps any InferenceInterface and keys cached outputs on a 128-bit
+// content_hash128() fingerprint of the input bytes, per-tensor sizes and
+// per-call shapes; the inputs themselves are not kept. The key picks one of
+// several shards, each a mutex-guarded map with its own CachePolicy (LRU by
+// default), so concurrent callers only contend when they land on the same
+// shard. Concurrent misses on the same inputs run the wrapped backend once and
+// share its result (or exception).
+//
+// Outputs are stored once, as typed RawOutputTensor buffers shared by every
+// hit: a raw hit only bumps reference counts, and a variant hit widens the
+// stored bytes into TensorElements. Variant outputs that mix element types
+// within a tensor cannot be stored typed and are kept as returned.
+//
+// With CachingOptions::per_sample, a call of several rows (dim 0 of the first
+// input's view shape, or the model's static batch for inputs without a shape)
+// is looked up row by row, and only the rows missing from the cache are run,
+// as one smaller batch. For models with a static batch (dim 0 of the first
+// input in the metadata) the missing rows are zero-padded up to it, in as many
+// inferences as needed. Outputs are put back together in row order. Every
+// output must carry the batch as dim 0; for models whose outputs do not, the
+// mode switches itself off and whole calls are cached instead. Concurrent
+// calls missing the same row may both run it.
+//
+// Safe to call concurrently.
 //
 // DETERMINISM: this decorator assumes that identical inputs always yield
 // identical outputs. It is strictly opt-in (only present when explicitly
 // constructed) and MUST NOT be placed around nondeterministic backends, since
 // returning a stale cached result would silently change observable behavior.
+// It also treats equal fingerprints as equal inputs; for non-adversarial
+// inputs the chance of a false hit is around n^2 / 2^129 for n distinct
+// inputs.
 class CachingBackend : public BackendDecorator {
 
   public:
     explicit CachingBackend(std::unique_ptr<InferenceInterface> inner, size_t capacity = 16)
-        : BackendDecorator(std::move(inner)), capacity_(capacity == 0 ? 1 : capacity) {}
+        : CachingBackend(std::move(inner), entry_limit(capacity)) {}
 
-    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
-        const size_t key = compute_key(input_tensors);
-
-        auto it = entries_.find(key);
-        if (it != entries_.end()) {
-            if (inputs_equal(it->second.inputs, input_tensors)) {
-                // Cache hit: promote to most-recently-used and return a copy.
-                lru_order_.splice(lru_order_.begin(), lru_order_, it->second.order_it);
-                return it->second.value;
+    CachingBackend(std::unique_ptr<InferenceInterface> inner, const CachingOptions& options)
+        : BackendDecorator(std::move(inner)), options_(options), concurrent_inner_(options.concurrent_inner),
+          per_sample_(options.per_sample) {
+        size_t shards = options.shards;
+        if (shards == 0) {
+            shards = options.max_entries == 0 ? kMaxAutoShards
+                                               : std::min(kMaxAutoShards, std::max<size_t>(1, options.max_entries / 8));
+        }
+        if (options.max_entries != 0) {
+            shards = std::min(shards, options.max_entries);
+        }
+        shard_entries_ = options.max_entries == 0 ? 0 : (options.max_entries + shards - 1) / shards;
+        shard_bytes_ = options.max_bytes == 0 ? 0 : std::max<size_t>(1, options.max_bytes / shards);
+        const CachePolicyFactory& policy = options.policy ? options.policy : lru_cache_policy();
+        for (size_t i = 0; i < shards; ++i) {
+            shards_.push_back(std::make_unique<Shard>());
+            shards_.back()->policy = policy(shard_entries_);
+            if (!shards_.back()->policy) {
+                throw InferenceException("CachingBackend: the cache policy factory returned nullptr");
             }
-            // Hash collision: drop the stale entry and treat as a miss.
-            lru_order_.erase(it->second.order_it);
-            entries_.erase(it);
         }
+    }
 
-        // Cache miss: forward to the wrapped backend before mutating state so an
-        // exception leaves the cache untouched.
-        auto result = BackendDecorator::get_infer_results(input_tensors);
-
-        lru_order_.push_front(key);
-        entries_.emplace(key, Entry{lru_order_.begin(), input_tensors, result});
+    using BackendDecorator::get_infer_results;
+    using BackendDecorator::get_infer_results_raw;
 
-        if (entries_.size() > capacity_) {
-            const size_t evict_key = lru_order_.back();
-            lru_order_.pop_back();
-            entries_.erase(evict_key);
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        if (per_sample_) {
+            if (std::optional<std::vector<RawOutputTensor>> rows = lookup_rows(inputs)) {
+                return widen_outputs(*rows);
+            }
         }
+        const Outputs outputs = lookup(inputs, false, [&] {
+            ResultTuple result = BackendDecorator::get_infer_results(inputs);
+            Outputs stored;
+            if (single_typed(std::get<0>(result))) {
+                stored.raw = std::make_shared<const std::vector<RawOutputTensor>>(
+                    flatten_to_raw(std::move(std::get<0>(result)), std::move(std::get<1>(result))));
+            } else {
+                stored.mixed = std::make_shared<const ResultTuple>(std::move(result));
+            }
+            return stored;
+        });
+        return outputs.raw ? widen_outputs(*outputs.raw) : *outputs.mixed;
+    }
 
-        return result;
+    // Raw results are produced by the wrapped backend's raw path, so raw
+    // callers never go through TensorElement.
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override {
+        if (per_sample_) {
+            if (std::optional<std::vector<RawOutputTensor>> rows = lookup_rows(inputs)) {
+                return std::move(*rows);
+            }
+        }
+        return *lookup(inputs, true, [&] {
+                    Outputs stored;
+                    stored.raw = std::make_shared<const std::vector<RawOutputTensor>>(forward_raw(inputs));
+                    return stored;
+                }).raw;
     }
 
     void clear_cache() noexcept override {
         // noexcept: container operations should not throw here, but guard anyway
         // so a faulty allocator/inner backend can never escape this contract.
         try {
-            entries_.clear();
-            lru_order_.clear();
+            for (const auto& shard : shards_) {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                shard->entries.clear();
+                shard->policy->clear();
+                shard->bytes = 0;
+            }
+            std::unique_lock<std::mutex> inner_lock(inner_mutex_, std::defer_lock);
+            if (!concurrent_inner_) {
+                inner_lock.lock();
+            }
             BackendDecorator::clear_cache();
         } catch (...) {
         }
     }
 
+    // Entries and their counted bytes across all shards.
+    size_t cached_entries() const {
+        size_t entries = 0;
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            entries += shard->entries.size();
+        }
+        return entries;
+    }
+
+    size_t cached_bytes() const {
+        size_t bytes = 0;
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            bytes += shard->bytes;
+        }
+        return bytes;
+    }
+
+    size_t shard_count() const noexcept { return shards_.size(); }
+
+    CachingStats stats() const {
+        CachingStats total;
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            total.hits += shard->stats.hits;
+            total.misses += shard->stats.misses;
+            total.admission_rejects += shard->stats.admission_rejects;
+            total.evictions += shard->stats.evictions;
+        }
+        return total;
+    }
+
+  protected:
+    // Replicas start with an empty cache of their own.
+    std::unique_ptr<InferenceInterface> rewrap(std::unique_ptr<InferenceInterface> inner) override {
+        return std::make_unique<CachingBackend>(std::move(inner), options_);
+    }
+
+    // Asynchronous calls go through the cache as well, rather than straight
+    // to the wrapped backend.
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override {
+        InferenceInterface::start_async(std::move(inputs), std::move(done));
+    }
+
   private:
     using ResultTuple = std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>;
 
+    static constexpr size_t kMaxAutoShards = 16;
+    // Bookkeeping charged to every entry on top of its outputs.
+    static constexpr size_t kEntryOverhead = 128;
+
+    static CachingOptions entry_limit(size_t capacity) {
+        CachingOptions options;
+        options.max_entries = capacity == 0 ? 1 : capacity;
+        return options;
+    }
+
+    struct KeyHash {
+        size_t operator()(const ContentHash128& key) const noexcept { return static_cast<size_t>(key.low); }
+    };
+
+    // Immutable once published; copies share the buffers.
+    struct Outputs {
+        std::shared_ptr<const std::vector<RawOutputTensor>> raw;
+        // Only for variant outputs that cannot be stored typed.
+        std::shared_ptr<const ResultTuple> mixed;
+    };
+
     struct Entry {
-        std::list<size_t>::iterator order_it;
-        std::vector<std::vector<uint8_t>> inputs;
-        ResultTuple value;
+        Outputs outputs;
+        size_t bytes = 0;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<ContentHash128, Entry, KeyHash> entries;
+        std::unique_ptr<CachePolicy> policy;
+        CachingStats stats;
+        // Misses being computed, by key; callers with the same inputs wait on
+        // the first one's result instead of running the backend again.
+        std::unordered_map<ContentHash128, std::shared_future<Outputs>, KeyHash> flights;
+        size_t bytes = 0;
+    };
+
+    // Outputs for `inputs`, from the cache or from `infer`. With `need_raw`,
+    // only typed outputs will do.
+    template <typename Infer> Outputs lookup(const std::vector<TensorView>& inputs, bool need_raw, Infer infer) {
+        const ContentHash128 key = compute_key(inputs);
+        Shard& shard = shard_for(key);
+
+        std::shared_ptr<std::promise<Outputs>> leader;
+        bool follower_retry = false;
+        while (!leader) {
+            std::shared_future<Outputs> follower;
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                if (!follower_retry) {
+                    shard.policy->record_access(key);
+                }
+                auto it = shard.entries.find(key);
+                if (it != shard.entries.end() && (it->second.outputs.raw || !need_raw)) {
+                    shard.policy->on_hit(key);
+                    ++shard.stats.hits;
+                    return it->second.outputs;
+                }
+                auto flight = shard.flights.find(key);
+                if (flight != shard.flights.end()) {
+                    follower = flight->second;
+                    ++shard.stats.hits;
+                } else {
+                    ++shard.stats.misses;
+                    leader = std::make_shared<std::promise<Outputs>>();
+                    shard.flights.emplace(key, leader->get_future().share());
+                }
+            }
+            if (follower.valid()) {
+                Outputs outputs = follower.get();
+                if (outputs.raw || !need_raw) {
+                    return outputs;
+                }
+                // A variant call left mixed outputs; look again and compute
+                // the raw ones.
+                follower_retry = true;
+            }
+        }
+
+        // Cache miss: forward to the wrapped backend before mutating state so an
+        // exception leaves the cache untouched.
+        Outputs outputs;
+        try {
+            outputs = run_inner(infer);
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.flights.erase(key);
+            }
+            leader->set_exception(std::current_exception());
+            throw;
+        }
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.flights.erase(key);
+            store_locked(shard, key, outputs);
+        }
+        leader->set_value(outputs);
+        return outputs;
+    }
+
+    // How the rows of a per-sample call are laid out.
+    struct RowLayout {
+        size_t rows = 0;
+        // Rows per inference for a static-batch model; 0 = any number.
+        size_t static_rows = 0;
+        // Per input: bytes of one row, and its shape with dim 0 = 1 (empty
+        // for inputs without a view shape).
+        std::vector<size_t> row_bytes;
+        std::vector<std::vector<int64_t>> row_shapes;
     };
 
-    static bool inputs_equal(const std::vector<std::vector<uint8_t>>& lhs,
-                             const std::vector<std::vector<uint8_t>>& rhs) noexcept {
-        if (lhs.size() != rhs.size()) {
-            return false;
+    // Per-sample outputs for a call of several rows, or nullopt when the call
+    // cannot be split and goes through the whole-call cache.
+    std::optional<std::vector<RawOutputTensor>> lookup_rows(const std::vector<TensorView>& inputs) {
+        const std::optional<RowLayout> layout = row_layout(inputs);
+        if (!layout) {
+            return std::nullopt;
+        }
+
+        std::vector<ContentHash128> keys(layout->rows);
+        std::vector<std::shared_ptr<const std::vector<RawOutputTensor>>> samples(layout->rows);
+        std::vector<size_t> missing;
+        for (size_t row = 0; row < layout->rows; ++row) {
+            keys[row] = compute_key(row_views(inputs, *layout, row));
+            Shard& shard = shard_for(keys[row]);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.policy->record_access(keys[row]);
+            auto it = shard.entries.find(keys[row]);
+            if (it != shard.entries.end() && it->second.outputs.raw) {
+                shard.policy->on_hit(keys[row]);
+                ++shard.stats.hits;
+                samples[row] = it->second.outputs.raw;
+            } else {
+                ++shard.stats.misses;
+                missing.push_back(row);
+            }
+        }
+
+        const size_t chunk_rows = layout->static_rows != 0 ? layout->static_rows : missing.size();
+        for (size_t begin = 0; begin < missing.size(); begin += chunk_rows) {
+            const size_t count = std::min(chunk_rows, missing.size() - begin);
+            const size_t padded = layout->static_rows != 0 ? layout->static_rows : count;
+            // Every row missing and no padding: the caller's inputs are the batch.
+            const bool whole = count == layout->rows && padded == layout->rows;
+
+            std::vector<std::vector<uint8_t>> merged;
+            std::vector<std::vector<int64_t>> shapes;
+            std::vector<TensorView> views;
+            if (!whole) {
+                merged.resize(inputs.size());
+                shapes.resize(inputs.size());
+                for (size_t i = 0; i < inputs.size(); ++i) {
+                    const size_t row_bytes = layout->row_bytes[i];
+                    merged[i].resize(padded * row_bytes, 0);
+                    for (size_t j = 0; j < count; ++j) {
+                        std::memcpy(merged[i].data() + j * row_bytes, inputs[i].data + missing[begin + j] * row_bytes,
+                                    row_bytes);
+                    }
+                    TensorView view(merged[i].data(), merged[i].size());
+                    if (!layout->row_shapes[i].empty()) {
+                        shapes[i] = layout->row_shapes[i];
+                        shapes[i][0] = static_cast<int64_t>(padded);
+                        view = TensorView(merged[i].data(), merged[i].size(), shapes[i]);
+                    }
+                    view.dtype = inputs[i].dtype;
+                    views.push_back(view);
+                }
+            }
+
+            std::vector<RawOutputTensor> outputs = run_inner([&] { return forward_raw(whole ? inputs : views); });
+            for (const RawOutputTensor& output : outputs) {
+                if (output.shape.empty() || output.shape[0] != static_cast<int64_t>(padded)) {
+                    per_sample_disabled_ = true;
+                    return std::nullopt;
+                }
+            }
+            for (size_t j = 0; j < count; ++j) {
+                const size_t row = missing[begin + j];
+                samples[row] = std::make_shared<const std::vector<RawOutputTensor>>(row_of(outputs, j, padded));
+                Outputs stored;
+                stored.raw = samples[row];
+                Shard& shard = shard_for(keys[row]);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                store_locked(shard, keys[row], stored);
+            }
+            if (whole) {
+                return outputs;
+            }
+        }
+        return join_rows(samples);
+    }
+
+    std::optional<RowLayout> row_layout(const std::vector<TensorView>& inputs) {
+        if (inputs.empty() || per_sample_disabled_) {
+            return std::nullopt;
+        }
+        RowLayout layout;
+        layout.static_rows = model_static_rows();
+        const TensorView& head = inputs.front();
+        if (head.has_shape()) {
+            if (head.ndim == 0 || head.shape[0] <= 0) {
+                return std::nullopt;
+            }
+            layout.rows = static_cast<size_t>(head.shape[0]);
+        } else {
+            layout.rows = layout.static_rows;
+        }
+        // A single row is a whole call, which also shares concurrent misses.
+        if (layout.rows < 2) {
+            return std::nullopt;
+        }
+        for (const TensorView& view : inputs) {
+            if (view.data == nullptr || view.size_bytes == 0 || view.size_bytes % layout.rows != 0) {
+                return std::nullopt;
+            }
+            std::vector<int64_t> row_shape;
+            if (view.has_shape()) {
+                if (view.ndim == 0 || view.shape[0] != static_cast<int64_t>(layout.rows)) {
+                    return std::nullopt;
+                }
+                row_shape = view.shape_vector();
+                row_shape[0] = 1;
+            } else if (layout.rows != layout.static_rows) {
+                // Without a shape, a smaller batch could not be described.
+                return std::nullopt;
+            }
+            layout.row_bytes.push_back(view.size_bytes / layout.rows);
+            layout.row_shapes.push_back(std::move(row_shape));
+        }
+        return layout;
+    }
+
+    // Views of one row of every input.
+    static std::vector<TensorView> row_views(const std::vector<TensorView>& inputs, const RowLayout& layout,
+                                             size_t row) {
+        std::vector<TensorView> views;
+        views.reserve(inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            const size_t row_bytes = layout.row_bytes[i];
+            TensorView view(inputs[i].data + row * row_bytes, row_bytes);
+            if (!layout.row_shapes[i].empty()) {
+                view = TensorView(view.data, row_bytes, layout.row_shapes[i]);
+            }
+            view.dtype = inputs[i].dtype;
+            views.push_back(view);
+        }
+        return views;
+    }
+
+    // Row `row` of batched outputs, copied so that a cached row does not keep
+    // the whole batch alive.
+    static std::vector<RawOutputTensor> row_of(const std::vector<RawOutputTensor>& outputs, size_t row, size_t rows) {
+        std::vector<RawOutputTensor> sample;
+        sample.reserve(outputs.size());
+        for (const RawOutputTensor& output : outputs) {
+            const size_t row_bytes = output.bytes.size() / rows;
+            const uint8_t* first = output.bytes.data() + row * row_bytes;
+            RawOutputTensor tensor;
+            tensor.dtype = output.dtype;
+            tensor.shape = output.shape;
+            tensor.shape[0] = 1;
+            tensor.bytes = TensorBuffer(first, first + row_bytes);
+            sample.push_back(std::move(tensor));
         }
-        for (size_t i = 0; i < lhs.size(); ++i) {
-            if (lhs[i] != rhs[i]) {
-                return false;
+        return sample;
+    }
+
+    static std::vector<RawOutputTensor>
+    join_rows(const std::vector<std::shared_ptr<const std::vector<RawOutputTensor>>>& samples) {
+        const std::vector<RawOutputTensor>& head = *samples.front();
+        std::vector<RawOutputTensor> outputs(head.size());
+        for (size_t k = 0; k < head.size(); ++k) {
+            std::vector<uint8_t> bytes;
+            bytes.reserve(samples.size() * head[k].bytes.size());
+            for (const auto& sample : samples) {
+                if (sample->size() != head.size() || (*sample)[k].dtype != head[k].dtype ||
+                    (*sample)[k].shape != head[k].shape) {
+                    throw InferenceExecutionException("CachingBackend: rows of a batch have different output " +
+                                                      std::to_string(k) + " shapes");
+                }
+                bytes.insert(bytes.end(), (*sample)[k].bytes.begin(), (*sample)[k].bytes.end());
+            }
+            outputs[k].dtype = head[k].dtype;
+            outputs[k].shape = head[k].shape;
+            outputs[k].shape[0] = static_cast<int64_t>(samples.size());
+            outputs[k].bytes = std::move(bytes);
+        }
+        return outputs;
+    }
+
+    // Batch size the metadata gives the model's first input, else 0. Taken
+    // from LayerInfo::batch_size rather than dim 0: some backends (OpenVINO)
+    // leave the batch out of the metadata shape.
+    size_t model_static_rows() {
+        std::call_once(model_rows_once_, [this] {
+            try {
+                const std::vector<LayerInfo> layers =
+                    run_inner([this] { return inner_->get_inference_metadata().getInputs(); });
+                if (!layers.empty()) {
+                    model_static_rows_ = layers.front().batch_size;
+                }
+            } catch (const InferenceException&) {
+                // No metadata (e.g. OpenCV DNN): only calls with shapes are split.
+            }
+        });
+        return model_static_rows_;
+    }
+
+    template <typename Infer> auto run_inner(Infer infer) -> decltype(infer()) {
+        std::unique_lock<std::mutex> inner_lock(inner_mutex_, std::defer_lock);
+        if (!concurrent_inner_) {
+            inner_lock.lock();
+        }
+        return infer();
+    }
+
+    Shard& shard_for(const ContentHash128& key) const { return *shards_[key.high % shards_.size()]; }
+
+    static ResultTuple widen_outputs(const std::vector<RawOutputTensor>& raw) {
+        ResultTuple result;
+        std::get<0>(result).reserve(raw.size());
+        std::get<1>(result).reserve(raw.size());
+        for (const RawOutputTensor& tensor : raw) {
+            std::get<0>(result).push_back(widen_raw_output(tensor));
+            std::get<1>(result).push_back(tensor.shape);
+        }
+        return result;
+    }
+
+    void store_locked(Shard& shard, const ContentHash128& key, const Outputs& outputs) {
+        const size_t added = payload_bytes(outputs);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            if (shard_bytes_ != 0 && kEntryOverhead + added > shard_bytes_) {
+                return;
+            }
+            Entry entry;
+            entry.outputs = outputs;
+            entry.bytes = kEntryOverhead + added;
+            shard.bytes += entry.bytes;
+            shard.entries.emplace(key, std::move(entry));
+            shard.policy->on_insert(key);
+        } else {
+            // Typed outputs computed for an entry that only held mixed ones;
+            // they now serve both call kinds.
+            Entry& entry = it->second;
+            if (shard_bytes_ != 0 && kEntryOverhead + added > shard_bytes_) {
+                return;
+            }
+            shard.bytes = shard.bytes - entry.bytes + kEntryOverhead + added;
+            entry.bytes = kEntryOverhead + added;
+            entry.outputs = outputs;
+            shard.policy->on_hit(key);
+        }
+
+        // Each entry fits the budget on its own, so one always remains.
+        while (shard.entries.size() > 1 && ((shard_entries_ != 0 && shard.entries.size() > shard_entries_) ||
+                                            (shard_bytes_ != 0 && shard.bytes > shard_bytes_))) {
+            const CachePolicy::Victim victim = shard.policy->evict();
+            auto dropped = shard.entries.find(victim.key);
+            shard.bytes -= dropped->second.bytes;
+            shard.entries.erase(dropped);
+            ++(victim.rejected ? shard.stats.admission_rejects : shard.stats.evictions);
+        }
+    }
+
+    static bool single_typed(const std::vector<std::vector<TensorElement>>& outputs) noexcept {
+        for (const std::vector<TensorElement>& tensor : outputs) {
+            for (const TensorElement& element : tensor) {
+                if (element.index() != tensor.front().index()) {
+                    return false;
+                }
             }
         }
         return true;
     }
 
-    static void hash_combine(size_t& seed, size_t value) noexcept {
-        // Boost-style mixing constant to spread bits across combined hashes.
-        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    static size_t payload_bytes(const Outputs& outputs) noexcept {
+        size_t bytes = 0;
+        if (outputs.raw) {
+            for (const RawOutputTensor& tensor : *outputs.raw) {
+                bytes += tensor.bytes.size() + tensor.shape.size() * sizeof(int64_t);
+            }
+        }
+        if (outputs.mixed) {
+            for (const auto& tensor : std::get<0>(*outputs.mixed)) {
+                bytes += tensor.size() * sizeof(TensorElement);
+            }
+            for (const auto& shape : std::get<1>(*outputs.mixed)) {
+                bytes += shape.size() * sizeof(int64_t);
+            }
+        }
+        return bytes;
     }
 
-    static size_t compute_key(const std::vector<std::vector<uint8_t>>& input_tensors) noexcept {
-        size_t seed = 0;
-        // Fold in the tensor count and each tensor's size before its bytes so
-        // that differing partitions of the same byte stream do not collide.
-        hash_combine(seed, std::hash<size_t>{}(input_tensors.size()));
-        for (const auto& tensor : input_tensors) {
-            hash_combine(seed, std::hash<size_t>{}(tensor.size()));
-            for (const uint8_t byte : tensor) {
-                hash_combine(seed, std::hash<uint8_t>{}(byte));
+    static ContentHash128 compute_key(const std::vector<TensorView>& inputs) noexcept {
+        // Fold in the tensor count and each tensor's size, dtype and shape
+        // before the bytes so that differing partitions of the same byte
+        // stream, or the same bytes read as another element type, do not
+        // collide. An unset dtype hashes apart from every set one.
+        ContentHasher layout;
+        const uint64_t count = inputs.size();
+        layout.update(&count, sizeof(count));
+        for (const TensorView& tensor : inputs) {
+            const uint64_t dtype = tensor.dtype ? static_cast<uint64_t>(*tensor.dtype) + 1 : 0;
+            const uint64_t sizes[3] = {tensor.size_bytes, tensor.ndim, dtype};
+            layout.update(sizes, sizeof(sizes));
+            if (tensor.has_shape()) {
+                layout.update(tensor.shape, tensor.ndim * sizeof(int64_t));
             }
         }
-        return seed;
+        ContentHash128 key{layout.digest(), 0};
+        for (const TensorView& tensor : inputs) {
+            const ContentHash128 part = content_hash128(tensor.data, tensor.size_bytes, key.low);
+            key.low = part.low;
+            key.high = (key.high * 0x9e3779b97f4a7c15ULL) ^ part.high;
+        }
+        return key;
     }
 
-    size_t capacity_;
-    std::list<size_t> lru_order_;
-    std::unordered_map<size_t, Entry> entries_;
+    const CachingOptions options_;
+    const bool concurrent_inner_;
+    const bool per_sample_;
+    std::atomic<bool> per_sample_disabled_{false};
+    std::once_flag model_rows_once_;
+    size_t model_static_rows_ = 0;
+    size_t shard_entries_ = 0;
+    size_t shard_bytes_ = 0;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::mutex inner_mutex_;
 };
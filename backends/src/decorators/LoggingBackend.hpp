@@ -4,6 +4,7 @@
 #include "InferenceInterface.hpp"
 
 #include <cstddef>
+#include <exception>
 #include <glog/logging.h>
 #include <memory>
 #include <sstream>
@@ -14,9 +15,11 @@
 
 // Decorator that logs lifecycle and inference events for the wrapped backend.
 //
-// Wraps any InferenceInterface and emits glog messages around load() and
-// get_infer_results(). The numeric inference output is forwarded unchanged;
-// this decorator only augments observability and never alters results.
+// Wraps any InferenceInterface and emits glog messages around load(),
+// get_infer_results() and get_infer_results_raw(). The numeric inference
+// output is forwarded unchanged; this decorator only augments observability
+// and never alters results. Asynchronous calls keep the wrapped backend's
+// native asynchronous execution and are logged when they complete.
 class LoggingBackend : public BackendDecorator {
 
   public:
@@ -28,11 +31,14 @@ class LoggingBackend : public BackendDecorator {
         LOG(INFO) << "LoggingBackend: load complete, state=" << to_string(state());
     }
 
+    using BackendDecorator::get_infer_results;
+    using BackendDecorator::get_infer_results_raw;
+
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
-        LOG(INFO) << "LoggingBackend: running inference on " << input_tensors.size() << " input tensor(s)";
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        LOG(INFO) << "LoggingBackend: running inference on " << inputs.size() << " input tensor(s)";
         try {
-            auto result = BackendDecorator::get_infer_results(input_tensors);
+            auto result = BackendDecorator::get_infer_results(inputs);
             const auto& shapes = std::get<1>(result);
             LOG(INFO) << "LoggingBackend: inference produced " << std::get<0>(result).size()
                       << " output tensor(s); shapes=" << format_shapes(shapes);
@@ -43,24 +49,80 @@ class LoggingBackend : public BackendDecorator {
         }
     }
 
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override {
+        LOG(INFO) << "LoggingBackend: running raw inference on " << inputs.size() << " input tensor(s)";
+        try {
+            auto outputs = forward_raw(inputs);
+            LOG(INFO) << "LoggingBackend: raw inference produced " << outputs.size()
+                      << " output tensor(s); shapes=" << format_shapes(outputs);
+            return outputs;
+        } catch (const std::exception& e) {
+            LOG(ERROR) << "LoggingBackend: raw inference failed: " << e.what();
+            throw;
+        }
+    }
+
+  protected:
+    std::unique_ptr<InferenceInterface> rewrap(std::unique_ptr<InferenceInterface> inner) override {
+        return std::make_unique<LoggingBackend>(std::move(inner));
+    }
+
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override {
+        LOG(INFO) << "LoggingBackend: starting asynchronous inference on " << inputs->views().size()
+                  << " input tensor(s)";
+        forward_async(std::move(inputs), [done = std::move(done)](std::exception_ptr error, auto results) {
+            if (error) {
+                LOG(ERROR) << "LoggingBackend: asynchronous inference failed: " << describe(error);
+            } else {
+                LOG(INFO) << "LoggingBackend: asynchronous inference produced " << std::get<0>(results).size()
+                          << " output tensor(s); shapes=" << format_shapes(std::get<1>(results));
+            }
+            done(std::move(error), std::move(results));
+        });
+    }
+
   private:
+    static std::string describe(const std::exception_ptr& error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            return e.what();
+        } catch (...) {
+            return "unknown error";
+        }
+    }
+
     static std::string format_shapes(const std::vector<std::vector<int64_t>>& shapes) {
         std::ostringstream oss;
         oss << "[";
         for (size_t i = 0; i < shapes.size(); ++i) {
-            if (i != 0) {
-                oss << ", ";
-            }
-            oss << "(";
-            for (size_t j = 0; j < shapes[i].size(); ++j) {
-                if (j != 0) {
-                    oss << "x";
-                }
-                oss << shapes[i][j];
-            }
-            oss << ")";
+            append_shape(oss, i, shapes[i]);
         }
         oss << "]";
         return oss.str();
     }
+
+    static std::string format_shapes(const std::vector<RawOutputTensor>& outputs) {
+        std::ostringstream oss;
+        oss << "[";
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            append_shape(oss, i, outputs[i].shape);
+        }
+        oss << "]";
+        return oss.str();
+    }
+
+    static void append_shape(std::ostringstream& oss, size_t index, const std::vector<int64_t>& shape) {
+        if (index != 0) {
+            oss << ", ";
+        }
+        oss << "(";
+        for (size_t j = 0; j < shape.size(); ++j) {
+            if (j != 0) {
+                oss << "x";
+            }
+            oss << shape[j];
+        }
+        oss << ")";
+    }
 };
@@ -5,47 +5,92 @@
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
 // Decorator that measures wall-clock inference time for the wrapped backend.
 //
-// Wraps any InferenceInterface and times each get_infer_results() call,
-// exposing its own measured timings via get_last_inference_time_ms() and
-// get_total_inferences(). The numeric inference output is forwarded unchanged;
-// this decorator only augments timing/instrumentation.
+// Wraps any InferenceInterface and times each get_infer_results() and
+// get_infer_results_raw() call, exposing its own measured timings via
+// get_last_inference_time_ms() and get_total_inferences(). The numeric
+// inference output is forwarded unchanged; this decorator only augments
+// timing/instrumentation. Asynchronous calls keep the wrapped backend's
+// native asynchronous execution and are timed from submission to completion.
 class ProfilingBackend : public BackendDecorator {
 
   public:
     explicit ProfilingBackend(std::unique_ptr<InferenceInterface> inner) : BackendDecorator(std::move(inner)) {}
 
-    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
-        const auto start = std::chrono::high_resolution_clock::now();
-        auto result = BackendDecorator::get_infer_results(input_tensors);
-        const auto end = std::chrono::high_resolution_clock::now();
+    using BackendDecorator::get_infer_results;
+    using BackendDecorator::get_infer_results_raw;
 
-        // Only record on success: an exception above propagates without
-        // updating the counters, so we never double count or record partial work.
-        last_inference_time_ms_local_ = std::chrono::duration<double, std::milli>(end - start).count();
-        total_inference_time_ms_local_ += last_inference_time_ms_local_;
-        total_inferences_local_ += 1;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        return timed([&] { return BackendDecorator::get_infer_results(inputs); });
+    }
 
-        return result;
+    // Times the wrapped backend's raw path directly, so profiling a raw caller
+    // adds no variant conversion.
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override {
+        return timed([&] { return forward_raw(inputs); });
     }
 
-    double get_last_inference_time_ms() const noexcept override { return last_inference_time_ms_local_; }
+    double get_last_inference_time_ms() const noexcept override {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        return last_inference_time_ms_local_;
+    }
 
-    size_t get_total_inferences() const noexcept override { return total_inferences_local_; }
+    size_t get_total_inferences() const noexcept override {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        return total_inferences_local_;
+    }
 
     double average_inference_time_ms() const {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
         if (total_inferences_local_ == 0) {
             return 0.0;
         }
         return total_inference_time_ms_local_ / static_cast<double>(total_inferences_local_);
     }
 
+  protected:
+    std::unique_ptr<InferenceInterface> rewrap(std::unique_ptr<InferenceInterface> inner) override {
+        return std::make_unique<ProfilingBackend>(std::move(inner));
+    }
+
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override {
+        const auto start = std::chrono::high_resolution_clock::now();
+        forward_async(std::move(inputs), [this, start, done = std::move(done)](std::exception_ptr error, auto results) {
+            if (!error) {
+                record(start);
+            }
+            done(std::move(error), std::move(results));
+        });
+    }
+
   private:
+    template <typename Infer> auto timed(Infer infer) -> decltype(infer()) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        auto result = infer();
+
+        // Only record on success: an exception above propagates without
+        // updating the counters, so we never double count or record partial work.
+        record(start);
+        return result;
+    }
+
+    // Completions of asynchronous calls record from the wrapped backend's
+    // threads, hence the lock.
+    void record(std::chrono::high_resolution_clock::time_point start) {
+        const auto end = std::chrono::high_resolution_clock::now();
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        last_inference_time_ms_local_ = std::chrono::duration<double, std::milli>(end - start).count();
+        total_inference_time_ms_local_ += last_inference_time_ms_local_;
+        total_inferences_local_ += 1;
+    }
+
+    mutable std::mutex stats_mutex_;
     double last_inference_time_ms_local_{0.0};
     double total_inference_time_ms_local_{0.0};
     size_t total_inferences_local_{0};
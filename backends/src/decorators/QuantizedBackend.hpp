@@ -3,6 +3,7 @@
 #include "InferenceInterface.hpp"
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <tuple>
 #include <utility>
@@ -18,9 +19,10 @@
 //
 // For that reason it is built to be SAFE BY DEFAULT:
 //   * QuantizationParams::enabled defaults to FALSE.
-//   * When disabled (the default and ONLY safe path) get_infer_results() is an
-//     EXACT PASSTHROUGH: the wrapped backend's output is returned byte-for-byte
-//     unchanged. No numeric transformation occurs.
+//   * When disabled (the default and ONLY safe path) get_infer_results() and
+//     get_infer_results_raw() are an EXACT PASSTHROUGH: the wrapped backend's
+//     output is returned byte-for-byte unchanged. No numeric transformation
+//     occurs.
 //   * The dequantization path is for demonstration / explicit opt-in only.
 //
 // DO NOT wrap any backend with this decorator in a default decorator chain,
@@ -41,17 +43,20 @@ class QuantizedBackend : public BackendDecorator {
     explicit QuantizedBackend(std::unique_ptr<InferenceInterface> inner, QuantizationParams params = {})
         : BackendDecorator(std::move(inner)), params_(params) {}
 
+    using BackendDecorator::get_infer_results;
+    using BackendDecorator::get_infer_results_raw;
+
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+    get_infer_results(const std::vector<TensorView>& inputs) override {
         // Default and only safe path: exact passthrough, no numeric change.
         if (!params_.enabled) {
-            return BackendDecorator::get_infer_results(input_tensors);
+            return BackendDecorator::get_infer_results(inputs);
         }
 
         // Opt-in path (requires reviewer sign-off): dequantize integer-typed
         // elements to float using real = scale * (q - zero_point). Float
         // elements are left untouched and shapes are preserved.
-        auto result = BackendDecorator::get_infer_results(input_tensors);
+        auto result = BackendDecorator::get_infer_results(inputs);
         auto& tensors = std::get<0>(result);
         for (auto& tensor : tensors) {
             for (auto& element : tensor) {
@@ -61,9 +66,47 @@ class QuantizedBackend : public BackendDecorator {
         return result;
     }
 
+    // Raw counterpart of the above: passthrough when disabled, otherwise
+    // integer tensors are rewritten as FP32 bytes holding the same values the
+    // variant path produces.
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override {
+        auto outputs = forward_raw(inputs);
+        if (!params_.enabled) {
+            return outputs;
+        }
+
+        for (auto& tensor : outputs) {
+            switch (tensor.dtype) {
+            case TensorDtype::FP32:
+                break;
+            case TensorDtype::INT32:
+                dequantize_bytes<int32_t>(tensor);
+                break;
+            case TensorDtype::INT64:
+                dequantize_bytes<int64_t>(tensor);
+                break;
+            case TensorDtype::UINT8:
+                dequantize_bytes<uint8_t>(tensor);
+                break;
+            }
+        }
+        return outputs;
+    }
+
     void set_quantization(QuantizationParams p) { params_ = p; }
     QuantizationParams quantization() const { return params_; }
 
+  protected:
+    std::unique_ptr<InferenceInterface> rewrap(std::unique_ptr<InferenceInterface> inner) override {
+        return std::make_unique<QuantizedBackend>(std::move(inner), params_);
+    }
+
+    // Asynchronous results are dequantized too, rather than forwarded as the
+    // wrapped backend returns them.
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override {
+        InferenceInterface::start_async(std::move(inputs), std::move(done));
+    }
+
   private:
     // Converts a single quantized integer element to a dequantized float.
     // Float elements pass through unchanged.
@@ -81,5 +124,19 @@ class QuantizedBackend : public BackendDecorator {
             element);
     }
 
+    template <typename T> void dequantize_bytes(RawOutputTensor& tensor) const {
+        const size_t count = tensor.bytes.size() / sizeof(T);
+        std::vector<uint8_t> bytes(count * sizeof(float));
+        auto* values = reinterpret_cast<float*>(bytes.data());
+        for (size_t i = 0; i < count; ++i) {
+            T value;
+            std::memcpy(&value, tensor.bytes.data() + i * sizeof(T), sizeof(T));
+            const auto q = static_cast<float>(value);
+            values[i] = params_.scale * (q - static_cast<float>(params_.zero_point));
+        }
+        tensor.dtype = TensorDtype::FP32;
+        tensor.bytes = std::move(bytes);
+    }
+
     QuantizationParams params_;
 };
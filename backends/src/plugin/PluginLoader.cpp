@@ -145,61 +145,97 @@ class PluginBackendAdapter final : public InferenceInterface {
     PluginBackendAdapter(const PluginBackendAdapter&) = delete;
     PluginBackendAdapter& operator=(const PluginBackendAdapter&) = delete;
 
-    // Primary path: one ABI call, outputs copied once as typed bytes.
+    // Primary path: one ABI call, inputs passed in place and outputs copied
+    // once as typed bytes. The ABI carries bytes only, so per-call view
+    // shapes/dtypes do not cross it; the plugin reads its model metadata.
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override {
+        std::vector<RawOutputTensor> outputs;
+        invoke(inputs, [&](const neuriplo_output_tensor_t* tensors, size_t count) {
+            outputs.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                RawOutputTensor output;
+                output.dtype = static_cast<TensorDtype>(tensors[i].dtype);
+                const auto* data = static_cast<const uint8_t*>(tensors[i].data);
+                output.bytes.assign(data, data + tensors[i].size_bytes);
+                output.shape.assign(tensors[i].shape, tensors[i].shape + tensors[i].ndim);
+                outputs.push_back(std::move(output));
+            }
+        });
+        return outputs;
+    }
+
+    // Copies plugin outputs straight into the caller's buffers before they are
+    // released, skipping the intermediate RawOutputTensor vectors.
+    void infer_into(const std::vector<TensorView>& inputs, std::vector<OutputBuffer>& outputs) override {
+        invoke(inputs, [&](const neuriplo_output_tensor_t* tensors, size_t count) {
+            check_output_buffer_count(outputs, count);
+            for (size_t i = 0; i < count; ++i) {
+                copy_into_output_buffer(outputs[i], i, static_cast<TensorDtype>(tensors[i].dtype), tensors[i].data,
+                                        tensors[i].size_bytes);
+                outputs[i].shape.assign(tensors[i].shape, tensors[i].shape + tensors[i].ndim);
+            }
+        });
+    }
+
     std::vector<RawOutputTensor>
     get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override {
-        std::vector<neuriplo_input_buffer_t> buffers;
-        buffers.reserve(input_tensors.size());
-        for (const auto& tensor : input_tensors) {
+        return get_infer_results_raw(make_tensor_views(input_tensors));
+    }
+
+    // Legacy variant view, derived from the raw path.
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        std::vector<RawOutputTensor> raw_outputs = get_infer_results_raw(inputs);
+
+        std::vector<std::vector<TensorElement>> outputs;
+        std::vector<std::vector<int64_t>> shapes;
+        outputs.reserve(raw_outputs.size());
+        shapes.reserve(raw_outputs.size());
+        for (RawOutputTensor& raw : raw_outputs) {
+            outputs.push_back(widen_raw_output(raw));
+            shapes.push_back(std::move(raw.shape));
+        }
+        return std::make_tuple(std::move(outputs), std::move(shapes));
+    }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        return get_infer_results(make_tensor_views(input_tensors));
+    }
+
+  private:
+    // Runs one ABI infer call and hands the plugin-owned outputs to consume();
+    // they are released afterwards even if consume() throws.
+    template <typename Consume> void invoke(const std::vector<TensorView>& inputs, Consume&& consume) {
+        input_buffers_.clear();
+        for (const TensorView& view : inputs) {
             neuriplo_input_buffer_t buffer{};
-            buffer.data = tensor.data();
-            buffer.size_bytes = tensor.size();
-            buffers.push_back(buffer);
+            buffer.data = view.data;
+            buffer.size_bytes = view.size_bytes;
+            input_buffers_.push_back(buffer);
         }
 
         neuriplo_output_tensor_t* tensors = nullptr;
         size_t count = 0;
         char error[kErrorBufferSize] = {0};
         start_timer();
-        const int rc =
-            descriptor_.api->infer(handle_, buffers.data(), buffers.size(), &tensors, &count, error, sizeof(error));
+        const int rc = descriptor_.api->infer(handle_, input_buffers_.data(), input_buffers_.size(), &tensors, &count,
+                                              error, sizeof(error));
         end_timer();
         if (rc != 0) {
             throw InferenceExecutionException(std::string(descriptor_.id) +
                                               " plugin: " + (error[0] != '\0' ? error : "inference failed"));
         }
 
-        std::vector<RawOutputTensor> outputs;
-        outputs.reserve(count);
-        for (size_t i = 0; i < count; ++i) {
-            RawOutputTensor output;
-            output.dtype = static_cast<TensorDtype>(tensors[i].dtype);
-            const auto* data = static_cast<const uint8_t*>(tensors[i].data);
-            output.bytes.assign(data, data + tensors[i].size_bytes);
-            output.shape.assign(tensors[i].shape, tensors[i].shape + tensors[i].ndim);
-            outputs.push_back(std::move(output));
+        try {
+            consume(tensors, count);
+        } catch (...) {
+            descriptor_.api->release_outputs(handle_, tensors, count);
+            throw;
         }
         descriptor_.api->release_outputs(handle_, tensors, count);
-        return outputs;
-    }
-
-    // Legacy variant view, derived from the raw path.
-    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
-        std::vector<RawOutputTensor> raw_outputs = get_infer_results_raw(input_tensors);
-
-        std::vector<std::vector<TensorElement>> outputs;
-        std::vector<std::vector<int64_t>> shapes;
-        outputs.reserve(raw_outputs.size());
-        shapes.reserve(raw_outputs.size());
-        for (RawOutputTensor& raw : raw_outputs) {
-            outputs.push_back(to_elements(raw));
-            shapes.push_back(std::move(raw.shape));
-        }
-        return std::make_tuple(std::move(outputs), std::move(shapes));
     }
 
-  private:
     void populate_metadata() {
         neuriplo_metadata_t metadata{};
         if (descriptor_.api->get_metadata(handle_, &metadata) != 0) {
@@ -217,36 +253,10 @@ class PluginBackendAdapter final : public InferenceInterface {
         }
     }
 
-    static std::vector<TensorElement> to_elements(const RawOutputTensor& tensor) {
-        std::vector<TensorElement> elements;
-        auto widen = [&](auto sample) {
-            using Element = decltype(sample);
-            const auto* typed = reinterpret_cast<const Element*>(tensor.bytes.data());
-            const size_t count = tensor.bytes.size() / sizeof(Element);
-            elements.reserve(count);
-            for (size_t i = 0; i < count; ++i) {
-                elements.emplace_back(typed[i]);
-            }
-        };
-        switch (tensor.dtype) {
-        case TensorDtype::FP32:
-            widen(float{});
-            break;
-        case TensorDtype::INT32:
-            widen(int32_t{});
-            break;
-        case TensorDtype::INT64:
-            widen(int64_t{});
-            break;
-        case TensorDtype::UINT8:
-            widen(uint8_t{});
-            break;
-        }
-        return elements;
-    }
-
     PluginBackendDescriptor descriptor_;
     neuriplo_backend_t* handle_ = nullptr;
+    // Reused across calls so steady-state inference does not reallocate it.
+    std::vector<neuriplo_input_buffer_t> input_buffers_;
 };
 
 } // namespace
@@ -296,7 +306,8 @@ const PluginBackendDescriptor* find_plugin_backend(std::string_view id) noexcept
 std::unique_ptr<InferenceInterface> create_plugin_backend(const PluginBackendDescriptor& descriptor,
                                                           const std::string& model_path, bool use_gpu,
                                                           size_t batch_size,
-                                                          const std::vector<std::vector<int64_t>>& input_sizes) {
+                                                          const std::vector<std::vector<int64_t>>& input_sizes,
+                                                          const BackendTuning& tuning) {
     std::vector<std::vector<int64_t>> shapes = input_sizes;
     std::vector<neuriplo_shape_t> shape_views;
     shape_views.reserve(shapes.size());
@@ -314,6 +325,20 @@ std::unique_ptr<InferenceInterface> create_plugin_backend(const PluginBackendDes
     options.batch_size = batch_size;
     options.input_sizes = shape_views.empty() ? nullptr : shape_views.data();
     options.n_input_sizes = shape_views.size();
+    options.ort_intra_op_threads = tuning.ort.intra_op_threads;
+    options.ort_inter_op_threads = tuning.ort.inter_op_threads;
+    options.ort_execution_mode = static_cast<int32_t>(tuning.ort.execution_mode);
+    options.ort_graph_optimization = static_cast<int32_t>(tuning.ort.graph_optimization);
+    options.ort_allow_spinning = static_cast<int32_t>(tuning.ort.allow_spinning);
+    options.ort_cpu_mem_arena = static_cast<int32_t>(tuning.ort.cpu_mem_arena);
+    options.ort_mem_pattern = static_cast<int32_t>(tuning.ort.mem_pattern);
+    options.ort_global_thread_pools = static_cast<int32_t>(tuning.ort.global_thread_pools);
+    options.ort_shared_cpu_allocator = static_cast<int32_t>(tuning.ort.shared_cpu_allocator);
+    options.ort_share_prepacked_weights = static_cast<int32_t>(tuning.ort.share_prepacked_weights);
+    options.artifact_cache_dir = tuning.artifact_cache_dir.c_str();
+    options.mmap_enabled = static_cast<int32_t>(tuning.mmap.enabled);
+    options.mmap_prefault = static_cast<int32_t>(tuning.mmap.prefault);
+    options.mmap_lock = static_cast<int32_t>(tuning.mmap.lock);
 
     const neuriplo_host_services_t services = host_services();
     char error[kErrorBufferSize] = {0};
@@ -5,6 +5,7 @@
 // dependencies stay private to it), and exposes their backends alongside the
 // compiled-in registrations.
 
+#include "BackendTuning.hpp"
 #include "InferenceInterface.hpp"
 #include "neuriplo/plugin_abi.h"
 
@@ -39,4 +40,5 @@ const PluginBackendDescriptor* find_plugin_backend(std::string_view id) noexcept
 std::unique_ptr<InferenceInterface> create_plugin_backend(const PluginBackendDescriptor& descriptor,
                                                           const std::string& model_path, bool use_gpu,
                                                           size_t batch_size,
-                                                          const std::vector<std::vector<int64_t>>& input_sizes);
+                                                          const std::vector<std::vector<int64_t>>& input_sizes,
+                                                          const BackendTuning& tuning = {});
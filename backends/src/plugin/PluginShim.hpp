@@ -5,11 +5,13 @@
 // per-backend rewrite to become plugins. Used only inside plugin shared
 // libraries via NEURIPLO_DEFINE_PLUGIN; the host never includes this header.
 
+#include "BackendTuning.hpp"
 #include "IBackendRuntimeFactory.hpp"
 #include "InferenceInterface.hpp"
 #include "TensorDataType.hpp"
 #include "neuriplo/plugin_abi.h"
 
+#include <cstddef>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -39,7 +41,7 @@ struct BackendHandle {
     std::vector<neuriplo_layer_info_t> output_infos;
 
     // infer storage
-    std::vector<std::vector<uint8_t>> output_bytes;
+    std::vector<TensorBuffer> output_bytes;
     std::vector<std::vector<int64_t>> output_shapes;
     std::vector<neuriplo_output_tensor_t> output_tensors;
 
@@ -74,6 +76,39 @@ inline neuriplo_dtype_t metadata_dtype_to_abi(TensorDataType dtype) {
     return NEURIPLO_DTYPE_FP32;
 }
 
+// Tuning fields appended to the options struct; absent when the host predates them.
+inline BackendTuning tuning_from_abi(const neuriplo_engine_options_t& options) {
+    BackendTuning tuning;
+    constexpr size_t tuning_end =
+        offsetof(neuriplo_engine_options_t, ort_share_prepacked_weights) + sizeof(int32_t);
+    if (options.struct_size < tuning_end) {
+        return tuning;
+    }
+    tuning.ort.intra_op_threads = options.ort_intra_op_threads;
+    tuning.ort.inter_op_threads = options.ort_inter_op_threads;
+    tuning.ort.execution_mode = static_cast<OrtTuning::ExecutionMode>(options.ort_execution_mode);
+    tuning.ort.graph_optimization = static_cast<OrtTuning::GraphOptimization>(options.ort_graph_optimization);
+    tuning.ort.allow_spinning = static_cast<TuningToggle>(options.ort_allow_spinning);
+    tuning.ort.cpu_mem_arena = static_cast<TuningToggle>(options.ort_cpu_mem_arena);
+    tuning.ort.mem_pattern = static_cast<TuningToggle>(options.ort_mem_pattern);
+    tuning.ort.global_thread_pools = static_cast<TuningToggle>(options.ort_global_thread_pools);
+    tuning.ort.shared_cpu_allocator = static_cast<TuningToggle>(options.ort_shared_cpu_allocator);
+    tuning.ort.share_prepacked_weights = static_cast<TuningToggle>(options.ort_share_prepacked_weights);
+
+    constexpr size_t cache_end = offsetof(neuriplo_engine_options_t, artifact_cache_dir) + sizeof(const char*);
+    if (options.struct_size >= cache_end && options.artifact_cache_dir != nullptr) {
+        tuning.artifact_cache_dir = options.artifact_cache_dir;
+    }
+
+    constexpr size_t mmap_end = offsetof(neuriplo_engine_options_t, mmap_lock) + sizeof(int32_t);
+    if (options.struct_size >= mmap_end) {
+        tuning.mmap.enabled = static_cast<TuningToggle>(options.mmap_enabled);
+        tuning.mmap.prefault = static_cast<TuningToggle>(options.mmap_prefault);
+        tuning.mmap.lock = static_cast<TuningToggle>(options.mmap_lock);
+    }
+    return tuning;
+}
+
 template <typename Factory>
 neuriplo_backend_t* plugin_create(const neuriplo_engine_options_t* options, const neuriplo_host_services_t* host,
                                   char* error, size_t error_size) {
@@ -93,12 +128,16 @@ neuriplo_backend_t* plugin_create(const neuriplo_engine_options_t* options, cons
         }
 
         Factory factory;
-        auto backend =
-            factory.create_backend(options->model_path, options->use_gpu != 0, options->batch_size, input_sizes);
+        // Called through the interface: factories that only override the
+        // untuned overload hide this one.
+        IBackendRuntimeFactory& runtime = factory;
+        auto backend = runtime.create_backend(options->model_path, options->use_gpu != 0, options->batch_size,
+                                              input_sizes, tuning_from_abi(*options));
         if (!backend) {
             write_error(error, error_size, "backend factory returned null");
             return nullptr;
         }
+        backend->set_tensor_converter(factory.create_converter());
 
         backend->load();
         if (backend->state() == BackendState::Failed) {
@@ -178,13 +217,15 @@ inline int plugin_infer(neuriplo_backend_t* backend, const neuriplo_input_buffer
     }
     auto* handle = reinterpret_cast<BackendHandle*>(backend);
     try {
-        std::vector<std::vector<uint8_t>> input_tensors;
-        input_tensors.reserve(n_inputs);
+        // The host keeps the input buffers alive for the duration of this call,
+        // so the backend reads them in place.
+        std::vector<TensorView> input_views;
+        input_views.reserve(n_inputs);
         for (size_t i = 0; i < n_inputs; ++i) {
-            input_tensors.emplace_back(inputs[i].data, inputs[i].data + inputs[i].size_bytes);
+            input_views.emplace_back(inputs[i].data, inputs[i].size_bytes);
         }
 
-        std::vector<RawOutputTensor> outputs = handle->backend->get_infer_results_raw(input_tensors);
+        std::vector<RawOutputTensor> outputs = handle->backend->get_infer_results_raw(input_views);
 
         handle->output_bytes.clear();
         handle->output_shapes.clear();
@@ -5,24 +5,55 @@
 // DEFAULT_BACKEND. They depend only on gtest (no gmock), matching the project's
 // no-new-dependency constraint.
 
+#include "ArtifactCache.hpp"
 #include "BackendDecorator.hpp"
+#include "BackendPool.hpp"
 #include "BackendRuntimeRegistry.hpp"
 #include "BackendState.hpp"
+#include "BackendTuning.hpp"
+#include "ContentHash.hpp"
+#include "DeferredBackend.hpp"
+#include "ConvertKernels.hpp"
 #include "HostTensorConverter.hpp"
+#include "HotSwapBackend.hpp"
 #include "IAllocator.hpp"
 #include "ITensorConverter.hpp"
 #include "InferenceBackendSetup.hpp"
 #include "InferenceInterface.hpp"
+#include "InferencePipeline.hpp"
+#include "LockFreeRing.hpp"
+#include "MappedModel.hpp"
+#include "ModelManager.hpp"
 #include "ModelRunner.hpp"
+#include "RawOutputConformance.hpp"
+#include "ShapeBucketBackend.hpp"
+#include "TensorBuffer.hpp"
+#include "TensorView.hpp"
+#include "Warmup.hpp"
+#include "decorators/BatchingBackend.hpp"
+#include "decorators/CachePolicy.hpp"
 #include "decorators/CachingBackend.hpp"
 #include "decorators/LoggingBackend.hpp"
 #include "decorators/ProfilingBackend.hpp"
 #include "decorators/QuantizedBackend.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
 // Deterministic, dependency-free backend for exercising the patterns.
@@ -248,6 +279,56 @@ TEST(BackendDecoratorTest, ForwardsModelMetadata) {
     EXPECT_EQ(deco.get_batch_size(), 1u);
 }
 
+// Runs asynchronous calls itself instead of on the default executor, like a
+// backend with native asynchronous execution.
+class NativeAsyncBackend : public FakeBackend {
+  public:
+    std::atomic<int> native_calls_{0};
+
+  protected:
+    void start_async(std::shared_ptr<const AsyncInputs> inputs, InferenceCallback done) override {
+        ++native_calls_;
+        run_async_inference(*inputs, done);
+    }
+};
+
+TEST(BackendDecoratorTest, ObservingDecoratorsKeepNativeAsync) {
+    auto fake = std::make_unique<NativeAsyncBackend>();
+    NativeAsyncBackend* raw = fake.get();
+    ProfilingBackend profiled(std::make_unique<LoggingBackend>(std::move(fake)));
+
+    auto [outputs, shapes] = profiled.infer_async(make_input()).get();
+    EXPECT_EQ(std::get<int32_t>(outputs[0][0]), 7);
+    EXPECT_EQ(raw->native_calls_.load(), 1);
+    EXPECT_EQ(profiled.get_total_inferences(), 1u);
+
+    raw->throw_on_infer_ = true;
+    EXPECT_THROW(profiled.infer_async(make_input()).get(), InferenceExecutionException);
+    EXPECT_EQ(raw->native_calls_.load(), 2);
+    EXPECT_EQ(profiled.get_total_inferences(), 1u);
+}
+
+TEST(BackendDecoratorTest, ResultChangingDecoratorsApplyToAsyncCalls) {
+    QuantizationParams params;
+    params.enabled = true;
+    params.scale = 2.0f;
+    params.zero_point = 1;
+    auto quantized_inner = std::make_unique<NativeAsyncBackend>();
+    NativeAsyncBackend* quantized_raw = quantized_inner.get();
+    QuantizedBackend quantized(std::move(quantized_inner), params);
+    auto [outputs, shapes] = quantized.infer_async(make_input()).get();
+    EXPECT_FLOAT_EQ(std::get<float>(outputs[0][0]), 12.0f);
+    EXPECT_EQ(quantized_raw->native_calls_.load(), 0);
+
+    auto cached_inner = std::make_unique<NativeAsyncBackend>();
+    NativeAsyncBackend* cached_raw = cached_inner.get();
+    CachingBackend cached(std::move(cached_inner), 8);
+    cached.infer_async(make_input()).get();
+    cached.infer_async(make_input()).get();
+    EXPECT_EQ(cached_raw->call_count_, 1);
+    EXPECT_EQ(cached_raw->native_calls_.load(), 0);
+}
+
 // ---------------------------------------------------------------------------
 // ProfilingBackend
 // ---------------------------------------------------------------------------
@@ -310,6 +391,25 @@ TEST(CachingBackendTest, EvictsLeastRecentlyUsed) {
     EXPECT_EQ(raw->call_count_, 3);
 }
 
+TEST(CachingBackendTest, SameBytesWithAnotherDtypeMiss) {
+    auto fake = std::make_unique<FakeBackend>();
+    FakeBackend* raw = fake.get();
+    CachingBackend deco(std::move(fake), 8);
+
+    const std::vector<uint8_t> bytes(4, 1);
+    const std::vector<int64_t> shape{1};
+    const std::vector<std::optional<TensorDataType>> dtypes = {std::nullopt, TensorDataType::Float32,
+                                                               TensorDataType::Int32};
+    for (const std::optional<TensorDataType>& dtype : dtypes) {
+        deco.get_infer_results(std::vector<TensorView>{TensorView(bytes.data(), bytes.size(), shape, dtype)});
+    }
+    EXPECT_EQ(raw->call_count_, 3);
+
+    // Each dtype hits its own entry.
+    deco.get_infer_results(std::vector<TensorView>{TensorView(bytes.data(), bytes.size(), shape, dtypes[2])});
+    EXPECT_EQ(raw->call_count_, 3);
+}
+
 // ---------------------------------------------------------------------------
 // LoggingBackend
 // ---------------------------------------------------------------------------
@@ -356,133 +456,2509 @@ TEST(QuantizedBackendTest, EnabledDequantizesIntegersOnly) {
 }
 
 // ---------------------------------------------------------------------------
-// Abstract Factory products: HostAllocator
+// BatchingBackend
 // ---------------------------------------------------------------------------
 
-TEST(HostAllocatorTest, AllocatesUsableMemory) {
-    HostAllocator alloc;
-    EXPECT_STREQ(alloc.name(), "HostAllocator");
+// One uint8 input byte per row; one FP32 output row (2 * byte) per input row.
+// Records the rows of every inference it runs.
+class RowBackend : public InferenceInterface {
+  public:
+    RowBackend() : InferenceInterface("fake_model", false, 4, {}) {}
 
-    void* p = alloc.allocate(64);
-    ASSERT_NE(p, nullptr);
-    std::memset(p, 0, 64); // must be writable
-    alloc.deallocate(p);
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        if (throw_on_infer_) {
+            throw InferenceExecutionException("fake failure");
+        }
+        const std::vector<uint8_t>& rows = input_tensors.at(0);
+        batches_.push_back(rows);
+        std::vector<TensorElement> output;
+        for (const uint8_t value : rows) {
+            output.emplace_back(2.0f * value);
+        }
+        return std::make_tuple(std::vector<std::vector<TensorElement>>{std::move(output)},
+                               std::vector<std::vector<int64_t>>{{static_cast<int64_t>(rows.size()), 1}});
+    }
+
+    bool throw_on_infer_ = false;
+    std::vector<std::vector<uint8_t>> batches_;
+};
+
+TEST(BatchingBackendTest, SingleCallerIsForwardedUnchanged) {
+    auto fake = std::make_unique<RowBackend>();
+    RowBackend* raw_fake = fake.get();
+    BatchingOptions options;
+    options.max_batch_size = 1;
+    BatchingBackend batching(std::move(fake), options);
+
+    auto [outputs, shapes] = batching.get_infer_results(std::vector<std::vector<uint8_t>>{{7}});
+    ASSERT_EQ(outputs.size(), 1u);
+    EXPECT_EQ(std::get<float>(outputs[0][0]), 14.0f);
+    EXPECT_EQ(shapes[0], (std::vector<int64_t>{1, 1}));
+    ASSERT_EQ(raw_fake->batches_.size(), 1u);
+    EXPECT_EQ(batching.batches_run(), 1u);
+}
+
+TEST(BatchingBackendTest, ConcurrentCallersShareOneInference) {
+    auto fake = std::make_unique<RowBackend>();
+    RowBackend* raw_fake = fake.get();
+    BatchingOptions options;
+    options.max_delay = std::chrono::seconds(10); // the batch runs once all four are queued
+    BatchingBackend batching(std::move(fake), options);
+    ASSERT_EQ(batching.options().max_batch_size, 4u);
+
+    std::vector<float> variant_results(4, -1.0f);
+    std::vector<std::vector<int64_t>> raw_shapes(4);
+    std::vector<std::thread> callers;
+    for (uint8_t i = 0; i < 4; ++i) {
+        callers.emplace_back([&, i] {
+            const std::vector<uint8_t> row{static_cast<uint8_t>(i + 1)};
+            const std::vector<TensorView> views{TensorView(row)};
+            if (i % 2 == 0) {
+                auto [outputs, shapes] = batching.get_infer_results(views);
+                variant_results[i] = std::get<float>(outputs[0][0]);
+            } else {
+                std::vector<RawOutputTensor> raw = batching.get_infer_results_raw(views);
+                float value = 0.0f;
+                std::memcpy(&value, raw[0].bytes.data(), sizeof(value));
+                variant_results[i] = value;
+                raw_shapes[i] = raw[0].shape;
+            }
+        });
+    }
+    for (std::thread& caller : callers) {
+        caller.join();
+    }
+
+    ASSERT_EQ(raw_fake->batches_.size(), 1u);
+    EXPECT_EQ(raw_fake->batches_[0].size(), 4u);
+    EXPECT_EQ(batching.batches_run(), 1u);
+    EXPECT_EQ(batching.requests_served(), 4u);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(variant_results[i], 2.0f * static_cast<float>(i + 1)) << i;
+    }
+    EXPECT_EQ(raw_shapes[1], (std::vector<int64_t>{1, 1}));
+}
+
+TEST(BatchingBackendTest, PadsStaticBatches) {
+    for (const BatchPadding padding : {BatchPadding::Zero, BatchPadding::RepeatLast}) {
+        auto fake = std::make_unique<RowBackend>();
+        RowBackend* raw_fake = fake.get();
+        BatchingOptions options;
+        options.max_delay = std::chrono::microseconds(0);
+        options.padding = padding;
+        BatchingBackend batching(std::move(fake), options);
+
+        auto [outputs, shapes] = batching.get_infer_results(std::vector<std::vector<uint8_t>>{{5}});
+        ASSERT_EQ(outputs[0].size(), 1u);
+        EXPECT_EQ(std::get<float>(outputs[0][0]), 10.0f);
+        EXPECT_EQ(shapes[0], (std::vector<int64_t>{1, 1}));
+
+        ASSERT_EQ(raw_fake->batches_.size(), 1u);
+        const std::vector<uint8_t> expected =
+            padding == BatchPadding::Zero ? std::vector<uint8_t>{5, 0, 0, 0} : std::vector<uint8_t>{5, 5, 5, 5};
+        EXPECT_EQ(raw_fake->batches_[0], expected);
+    }
+}
+
+TEST(BatchingBackendTest, FailureReachesEveryCallerInTheBatch) {
+    auto fake = std::make_unique<RowBackend>();
+    fake->throw_on_infer_ = true;
+    BatchingOptions options;
+    options.max_batch_size = 2;
+    options.max_delay = std::chrono::seconds(10);
+    BatchingBackend batching(std::move(fake), options);
+
+    std::vector<int> failures(2, 0);
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 2; ++i) {
+        callers.emplace_back([&, i] {
+            try {
+                batching.get_infer_results(std::vector<std::vector<uint8_t>>{{1}});
+            } catch (const InferenceExecutionException&) {
+                failures[i] = 1;
+            }
+        });
+    }
+    for (std::thread& caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(failures, (std::vector<int>{1, 1}));
+    EXPECT_EQ(batching.batches_run(), 1u);
+}
+
+// Takes [rows, 3, 2, 2] uint8 inputs and returns each row's sum; inputs
+// without a shape hold two rows. Reports the input shape in its metadata
+// either with the batch dimension (ONNX Runtime style) or without it
+// (OpenVINO style).
+class ChannelRowBackend : public InferenceInterface {
+  public:
+    explicit ChannelRowBackend(std::vector<int64_t> metadata_shape) : InferenceInterface("fake_model", false, 2, {}) {
+        inference_metadata_.addInput("input", metadata_shape, batch_size_, TensorDataType::UInt8);
+    }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        std::vector<int64_t> shape = inputs.at(0).shape_vector();
+        shapes_.push_back(shape);
+        if (shape.empty()) {
+            shape = {static_cast<int64_t>(batch_size_), 3, 2, 2};
+        }
+        if (shape.size() != 4 || !std::equal(shape.begin() + 1, shape.end(), row_shape_.begin())) {
+            throw InferenceExecutionException("unexpected input shape");
+        }
+        std::vector<TensorElement> sums;
+        for (int64_t row = 0; row < shape[0]; ++row) {
+            const uint8_t* begin = inputs[0].data + row * 12;
+            sums.emplace_back(static_cast<float>(std::accumulate(begin, begin + 12, 0)));
+        }
+        return std::make_tuple(std::vector<std::vector<TensorElement>>{std::move(sums)},
+                               std::vector<std::vector<int64_t>>{{shape[0], 1}});
+    }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        return get_infer_results(make_tensor_views(input_tensors));
+    }
+
+    std::vector<std::vector<int64_t>> shapes_;
+
+  private:
+    const std::vector<int64_t> row_shape_{3, 2, 2};
+};
+
+TEST(BatchingBackendTest, MergedShapeFollowsMetadataWithOrWithoutBatchDim) {
+    const std::vector<std::vector<int64_t>> metadata_shapes = {{1, 3, 2, 2}, {3, 2, 2}};
+    for (const std::vector<int64_t>& metadata_shape : metadata_shapes) {
+        auto fake = std::make_unique<ChannelRowBackend>(metadata_shape);
+        ChannelRowBackend* raw_fake = fake.get();
+        BatchingOptions options;
+        options.max_delay = std::chrono::seconds(10); // the batch runs once both are queued
+        BatchingBackend batching(std::move(fake), options);
+
+        std::vector<float> sums(2, -1.0f);
+        std::vector<std::thread> callers;
+        for (uint8_t i = 0; i < 2; ++i) {
+            callers.emplace_back([&, i] {
+                auto [outputs, shapes] = batching.get_infer_results(std::vector<std::vector<uint8_t>>{
+                    std::vector<uint8_t>(12, static_cast<uint8_t>(i + 1))});
+                sums[i] = std::get<float>(outputs[0][0]);
+            });
+        }
+        for (std::thread& caller : callers) {
+            caller.join();
+        }
+
+        ASSERT_EQ(raw_fake->shapes_.size(), 1u) << metadata_shape.size();
+        EXPECT_EQ(raw_fake->shapes_[0], (std::vector<int64_t>{2, 3, 2, 2}));
+        EXPECT_EQ(sums, (std::vector<float>{12.0f, 24.0f}));
+    }
 }
 
 // ---------------------------------------------------------------------------
-// Abstract Factory products: HostTensorConverter
+// BackendPool
 // ---------------------------------------------------------------------------
 
-TEST(HostTensorConverterTest, ToTypedDecodesFloatBytes) {
-    HostTensorConverter conv;
-    EXPECT_STREQ(conv.name(), "HostTensorConverter");
+// Reports its id as the single int32 output and records whether two calls ever
+// ran on it at the same time.
+class ExclusiveBackend : public InferenceInterface {
+  public:
+    ExclusiveBackend(int32_t id, std::atomic<int>& pool_active, std::atomic<int>& pool_peak)
+        : InferenceInterface("fake_model", false, 1, {}), id_(id), pool_active_(pool_active), pool_peak_(pool_peak) {}
 
-    const float values[2] = {1.5f, -2.25f};
-    std::vector<uint8_t> raw(sizeof(values));
-    std::memcpy(raw.data(), values, sizeof(values));
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        (void)input_tensors;
+        if (active_.fetch_add(1) != 0) {
+            overlapped_ = true;
+        }
+        const int active = pool_active_.fetch_add(1) + 1;
+        int peak = pool_peak_.load();
+        while (active > peak && !pool_peak_.compare_exchange_weak(peak, active)) {
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        ++calls_;
+        pool_active_.fetch_sub(1);
+        active_.fetch_sub(1);
+        if (fail_next_.exchange(false)) {
+            throw InferenceExecutionException("fake failure");
+        }
+        return std::make_tuple(std::vector<std::vector<TensorElement>>{{id_}}, std::vector<std::vector<int64_t>>{{1}});
+    }
 
-    auto out = conv.to_typed(raw, TensorDataType::Float32);
-    ASSERT_EQ(out.size(), 2u);
-    EXPECT_FLOAT_EQ(std::get<float>(out[0]), 1.5f);
-    EXPECT_FLOAT_EQ(std::get<float>(out[1]), -2.25f);
+    std::atomic<bool> overlapped_{false};
+    std::atomic<bool> fail_next_{false};
+    int calls_ = 0;
+
+  private:
+    int32_t id_;
+    std::atomic<int> active_{0};
+    std::atomic<int>& pool_active_;
+    std::atomic<int>& pool_peak_;
+};
+
+TEST(BackendPoolTest, RejectsEmptyOrNullInstances) {
+    EXPECT_THROW(BackendPool{std::vector<std::unique_ptr<InferenceInterface>>{}}, InferenceException);
+    std::vector<std::unique_ptr<InferenceInterface>> instances;
+    instances.push_back(std::make_unique<FakeBackend>());
+    instances.push_back(nullptr);
+    EXPECT_THROW(BackendPool{std::move(instances)}, InferenceException);
 }
 
-TEST(HostTensorConverterTest, FromBackendDecodesInt64) {
-    HostTensorConverter conv;
-    const int64_t values[3] = {7, -1, 1000};
-    auto out = conv.from_backend(values, 3, TensorDataType::Int64);
-    ASSERT_EQ(out.size(), 3u);
-    EXPECT_EQ(std::get<int64_t>(out[0]), 7);
-    EXPECT_EQ(std::get<int64_t>(out[1]), -1);
-    EXPECT_EQ(std::get<int64_t>(out[2]), 1000);
+TEST(BackendPoolTest, ConcurrentCallsNeverShareAnInstance) {
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    std::vector<ExclusiveBackend*> fakes;
+    std::vector<std::unique_ptr<InferenceInterface>> instances;
+    for (int32_t id = 0; id < 3; ++id) {
+        auto fake = std::make_unique<ExclusiveBackend>(id, active, peak);
+        fakes.push_back(fake.get());
+        instances.push_back(std::move(fake));
+    }
+    BackendPool pool(std::move(instances));
+    ASSERT_EQ(pool.size(), 3u);
+
+    std::vector<std::thread> callers;
+    std::atomic<int> bad_results{0};
+    for (int t = 0; t < 8; ++t) {
+        callers.emplace_back([&] {
+            for (int i = 0; i < 25; ++i) {
+                auto [outputs, shapes] = pool.get_infer_results(make_input());
+                const int32_t id = std::get<int32_t>(outputs.at(0).at(0));
+                if (id < 0 || id > 2) {
+                    ++bad_results;
+                }
+            }
+        });
+    }
+    for (std::thread& caller : callers) {
+        caller.join();
+    }
+
+    EXPECT_EQ(bad_results.load(), 0);
+    int calls = 0;
+    for (const ExclusiveBackend* fake : fakes) {
+        EXPECT_FALSE(fake->overlapped_);
+        calls += fake->calls_;
+    }
+    EXPECT_EQ(calls, 200);
+    EXPECT_EQ(pool.get_total_inferences(), 200u);
+    EXPECT_GE(peak.load(), 1);
+    EXPECT_LE(peak.load(), 3);
 }
 
-TEST(HostTensorConverterTest, WidensInt8ToInt32) {
-    HostTensorConverter conv;
-    const int8_t values[2] = {-5, 5};
-    auto out = conv.from_backend(values, 2, TensorDataType::Int8);
-    ASSERT_EQ(out.size(), 2u);
-    EXPECT_EQ(std::get<int32_t>(out[0]), -5);
-    EXPECT_EQ(std::get<int32_t>(out[1]), 5);
+TEST(BackendPoolTest, FailedCallReturnsItsInstance) {
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    auto fake = std::make_unique<ExclusiveBackend>(5, active, peak);
+    fake->fail_next_ = true;
+    std::vector<std::unique_ptr<InferenceInterface>> instances;
+    instances.push_back(std::move(fake));
+    BackendPool pool(std::move(instances));
+
+    EXPECT_THROW(pool.get_infer_results(make_input()), InferenceExecutionException);
+    auto [outputs, shapes] = pool.get_infer_results(make_input());
+    EXPECT_EQ(std::get<int32_t>(outputs[0][0]), 5);
+    EXPECT_EQ(pool.get_total_inferences(), 1u);
 }
 
-TEST(HostTensorConverterTest, HandlesEmptyAndNull) {
-    HostTensorConverter conv;
-    EXPECT_TRUE(conv.to_typed({}, TensorDataType::Float32).empty());
-    EXPECT_TRUE(conv.from_backend(nullptr, 4, TensorDataType::Int32).empty());
+TEST(BackendPoolTest, ForwardsResultsAndMetadataUnchanged) {
+    FakeBackend reference;
+    std::vector<std::unique_ptr<InferenceInterface>> instances;
+    instances.push_back(std::make_unique<FakeBackend>());
+    instances.push_back(std::make_unique<FakeBackend>());
+    BackendPool pool(std::move(instances));
+
+    EXPECT_EQ(pool.get_infer_results(make_input()), reference.get_infer_results(make_input()));
+    const std::vector<std::vector<uint8_t>> input = make_input();
+    EXPECT_EQ(pool.get_infer_results(make_tensor_views(input)), reference.get_infer_results(input));
+    EXPECT_EQ(pool.get_model_path(), "fake_model");
+    EXPECT_EQ(pool.get_batch_size(), 1u);
+
+    pool.load();
+    EXPECT_EQ(pool.state(), BackendState::Ready);
+    EXPECT_EQ(static_cast<FakeBackend*>(pool.instance(1))->load_count_, 1);
+    pool.clear_cache();
+    EXPECT_EQ(pool.get_infer_results(make_input()), reference.get_infer_results(make_input()));
 }
 
 // ---------------------------------------------------------------------------
-// Raw output API (get_infer_results_raw)
+// Hot model swap
 // ---------------------------------------------------------------------------
 
-// Homogeneous outputs (one FP32 tensor, one INT64 tensor) so the default
-// variant-flattening adapter has well-defined dtypes to produce.
-class HomogeneousFakeBackend : public InferenceInterface {
+std::unique_ptr<FakeBackend> fake_returning(int32_t value) {
+    auto backend = std::make_unique<FakeBackend>();
+    backend->output_ = {value};
+    return backend;
+}
+
+int32_t first_output(InferenceInterface& backend) {
+    auto [outputs, shapes] = backend.get_infer_results(make_input());
+    return std::get<int32_t>(outputs.at(0).at(0));
+}
+
+// Blocks every call until the gate opens and reports its destruction.
+class GatedBackend : public FakeBackend {
   public:
-    HomogeneousFakeBackend() : InferenceInterface("fake_model", false, 1, {}) { state_ = BackendState::Ready; }
+    GatedBackend(std::shared_future<void> gate, std::atomic<bool>& destroyed)
+        : gate_(std::move(gate)), destroyed_(destroyed) {}
+    ~GatedBackend() override { destroyed_ = true; }
 
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
-        (void)input_tensors;
-        ++call_count_;
-        std::vector<std::vector<TensorElement>> outputs;
-        outputs.push_back({1.5f, -2.0f, 3.25f});
-        outputs.push_back({static_cast<int64_t>(10), static_cast<int64_t>(-20)});
-        std::vector<std::vector<int64_t>> shapes;
-        shapes.push_back({3});
-        shapes.push_back({2});
-        return std::make_tuple(outputs, shapes);
+        entered_ = true;
+        gate_.wait();
+        return FakeBackend::get_infer_results(input_tensors);
     }
 
-    int call_count_ = 0;
+    std::atomic<bool> entered_{false};
+
+  private:
+    std::shared_future<void> gate_;
+    std::atomic<bool>& destroyed_;
 };
 
-TEST(RawOutputApiTest, DefaultAdapterFlattensVariantsToTypedBytes) {
-    HomogeneousFakeBackend backend;
-    const auto raw = backend.get_infer_results_raw(make_input());
+TEST(HotSwapBackendTest, PublishesReadyCandidatesOnly) {
+    EXPECT_THROW(HotSwapBackend{nullptr}, InferenceException);
 
-    ASSERT_EQ(raw.size(), 2u);
+    int warmups = 0;
+    HotSwapBackend backend(fake_returning(1), [&warmups](InferenceInterface& candidate) {
+        ++warmups;
+        if (first_output(candidate) < 0) {
+            throw InferenceExecutionException("warmup failed");
+        }
+    });
+    EXPECT_EQ(first_output(backend), 1);
+
+    EXPECT_TRUE(backend.swap(fake_returning(2)));
+    EXPECT_EQ(first_output(backend), 2);
+    EXPECT_EQ(backend.generation(), 1u);
+    EXPECT_EQ(warmups, 1);
+
+    auto broken = fake_returning(3);
+    broken->load_should_fail_ = true;
+    EXPECT_FALSE(backend.swap(std::move(broken)));
+    EXPECT_FALSE(backend.swap(fake_returning(-1)));
+    EXPECT_FALSE(backend.swap(std::unique_ptr<InferenceInterface>()));
+    EXPECT_FALSE(backend.swap_async([]() -> std::unique_ptr<InferenceInterface> {
+                            throw ModelLoadException("missing model");
+                        }).get());
+    EXPECT_EQ(first_output(backend), 2);
+    EXPECT_EQ(backend.generation(), 1u);
+    EXPECT_EQ(backend.get_total_inferences(), 3u);
+}
 
-    EXPECT_EQ(raw[0].dtype, TensorDtype::FP32);
-    EXPECT_EQ(raw[0].shape, (std::vector<int64_t>{3}));
-    ASSERT_EQ(raw[0].element_count(), 3u);
-    float floats[3];
-    std::memcpy(floats, raw[0].bytes.data(), sizeof(floats));
-    EXPECT_FLOAT_EQ(floats[0], 1.5f);
-    EXPECT_FLOAT_EQ(floats[1], -2.0f);
-    EXPECT_FLOAT_EQ(floats[2], 3.25f);
+TEST(HotSwapBackendTest, InFlightCallsFinishOnTheRetiredInstance) {
+    std::promise<void> open_gate;
+    std::atomic<bool> old_destroyed{false};
+    auto gated = std::make_unique<GatedBackend>(open_gate.get_future().share(), old_destroyed);
+    gated->output_ = {1};
+    GatedBackend* old_instance = gated.get();
+    HotSwapBackend backend(std::move(gated));
+
+    std::future<int32_t> in_flight = std::async(std::launch::async, [&backend] { return first_output(backend); });
+    while (!old_instance->entered_) {
+        std::this_thread::yield();
+    }
 
-    EXPECT_EQ(raw[1].dtype, TensorDtype::INT64);
-    EXPECT_EQ(raw[1].shape, (std::vector<int64_t>{2}));
-    ASSERT_EQ(raw[1].element_count(), 2u);
-    int64_t ints[2];
-    std::memcpy(ints, raw[1].bytes.data(), sizeof(ints));
-    EXPECT_EQ(ints[0], 10);
-    EXPECT_EQ(ints[1], -20);
+    std::future<bool> swapped = backend.swap_async([] { return fake_returning(2); });
+    while (backend.generation() == 0) {
+        std::this_thread::yield();
+    }
+    // New calls already run on the new instance; the old one is kept alive.
+    EXPECT_EQ(first_output(backend), 2);
+    EXPECT_FALSE(old_destroyed);
+    EXPECT_EQ(swapped.wait_for(std::chrono::milliseconds(20)), std::future_status::timeout);
+
+    open_gate.set_value();
+    EXPECT_EQ(in_flight.get(), 1);
+    EXPECT_TRUE(swapped.get());
+    EXPECT_TRUE(old_destroyed);
 }
 
-TEST(RawOutputApiTest, DefaultAdapterRejectsMixedElementTypes) {
-    // FakeBackend's canned output mixes int32 and float in one tensor.
+// ---------------------------------------------------------------------------
+// Background loading
+// ---------------------------------------------------------------------------
+
+// Loader returning a Ready FakeBackend once `gate` opens.
+DeferredBackend::Loader gated_loader(std::shared_future<void> gate) {
+    return [gate]() -> std::unique_ptr<InferenceInterface> {
+        gate.wait();
+        auto backend = std::make_unique<FakeBackend>();
+        backend->load();
+        return backend;
+    };
+}
+
+TEST(DeferredBackendTest, ReturnsLoadingAndBecomesReady) {
+    AsyncThreadPool pool(1);
+    std::promise<void> open_gate;
+    DeferredBackend backend("fake_model", false, 4, gated_loader(open_gate.get_future().share()), pool);
+
+    std::promise<BackendState> notified;
+    backend.on_ready([&notified](BackendState state) { notified.set_value(state); });
+    EXPECT_EQ(backend.state(), BackendState::Loading);
+    EXPECT_EQ(backend.inner(), nullptr);
+    EXPECT_EQ(backend.get_batch_size(), 4u);
+    EXPECT_EQ(backend.ready().wait_for(std::chrono::milliseconds(10)), std::future_status::timeout);
+
+    open_gate.set_value();
+    EXPECT_EQ(backend.ready().get(), BackendState::Ready);
+    EXPECT_EQ(notified.get_future().get(), BackendState::Ready);
+    EXPECT_EQ(backend.get_batch_size(), 1u);
+    EXPECT_EQ(backend.get_infer_results(make_input()), FakeBackend().get_infer_results(make_input()));
+
+    // Registered after the load: runs right away.
+    BackendState late = BackendState::Loading;
+    backend.on_ready([&late](BackendState state) { late = state; });
+    EXPECT_EQ(late, BackendState::Ready);
+}
+
+TEST(DeferredBackendTest, FailedLoadsSurfaceTheError) {
+    AsyncThreadPool pool(1);
+    DeferredBackend backend(
+        "missing.onnx", false, 1, []() -> std::unique_ptr<InferenceInterface> { throw ModelLoadException("no file"); },
+        pool);
+    EXPECT_EQ(backend.wait(), BackendState::Failed);
+    EXPECT_NE(backend.error().find("no file"), std::string::npos);
+    EXPECT_THROW(backend.get_infer_results(make_input()), InferenceExecutionException);
+    EXPECT_THROW(backend.infer_async(make_input()).get(), InferenceExecutionException);
+
+    DeferredBackend null_backend("broken.onnx", false, 1, [] { return std::unique_ptr<InferenceInterface>(); }, pool);
+    EXPECT_EQ(null_backend.ready().get(), BackendState::Failed);
+}
+
+TEST(DeferredBackendTest, LoadsModelsInParallel) {
+    AsyncThreadPool pool(3);
+    std::atomic<int> loading{0};
+    std::atomic<int> peak{0};
+    auto loader = [&loading, &peak]() -> std::unique_ptr<InferenceInterface> {
+        const int now = ++loading;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+        }
+        // Each load waits (bounded) for the others to start.
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (peak.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        auto backend = std::make_unique<FakeBackend>();
+        backend->load();
+        return backend;
+    };
+
+    std::vector<std::unique_ptr<DeferredBackend>> backends;
+    for (int i = 0; i < 3; ++i) {
+        backends.push_back(std::make_unique<DeferredBackend>("fake_model", false, 1, loader, pool));
+    }
+    for (const auto& backend : backends) {
+        EXPECT_EQ(backend->wait(), BackendState::Ready);
+    }
+    EXPECT_EQ(peak.load(), 3);
+}
+
+TEST(DeferredBackendTest, RunnerQueuesOrRejectsCallsWhileLoading) {
+    AsyncThreadPool pool(2);
+    std::promise<void> open_gate;
+    const std::shared_future<void> gate = open_gate.get_future().share();
+
+    ModelRunner rejecting(std::make_unique<DeferredBackend>("fake_model", false, 1, gated_loader(gate), pool),
+                          ModelRunner::LoadingPolicy::Reject);
+    EXPECT_THROW(rejecting.run(make_input()), InferenceExecutionException);
+
+    ModelRunner waiting(std::make_unique<DeferredBackend>("fake_model", false, 1, gated_loader(gate), pool));
+    auto queued = waiting.run_async(make_input());
+    EXPECT_EQ(queued.wait_for(std::chrono::milliseconds(10)), std::future_status::timeout);
+
+    open_gate.set_value();
+    EXPECT_EQ(queued.get(), FakeBackend().get_infer_results(make_input()));
+    EXPECT_EQ(waiting.state(), BackendState::Ready);
+    rejecting.load();
+    EXPECT_NO_THROW(rejecting.run(make_input()));
+}
+
+// ---------------------------------------------------------------------------
+// ShapeBucketBackend
+// ---------------------------------------------------------------------------
+
+// Static-shape stand-in: accepts only its own float32 input shape and echoes
+// the input back as its output.
+class FixedShapeEchoBackend : public InferenceInterface {
+  public:
+    explicit FixedShapeEchoBackend(std::vector<int64_t> shape)
+        : InferenceInterface("fake_model", false, static_cast<size_t>(shape[0]), {}), shape_(std::move(shape)) {
+        inference_metadata_.addInput("input", shape_, batch_size_, TensorDataType::Float32);
+        state_ = BackendState::Ready;
+    }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        if (inputs.size() != 1 || inputs[0].shape_vector() != shape_) {
+            throw InferenceExecutionException("unexpected input shape");
+        }
+        const auto* values = reinterpret_cast<const float*>(inputs[0].data);
+        std::vector<TensorElement> output(values, values + inputs[0].size_bytes / sizeof(float));
+        return std::make_tuple(std::vector<std::vector<TensorElement>>{output},
+                               std::vector<std::vector<int64_t>>{shape_});
+    }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        return get_infer_results(make_tensor_views(input_tensors));
+    }
+
+  private:
+    std::vector<int64_t> shape_;
+};
+
+ShapeBucketBackend::Loader echo_bucket_loader(std::atomic<int>& loads) {
+    return [&loads](const ShapeBucket& bucket) -> std::unique_ptr<InferenceInterface> {
+        ++loads;
+        std::vector<int64_t> shape{static_cast<int64_t>(bucket.batch_size)};
+        shape.insert(shape.end(), bucket.input_sizes[0].begin(), bucket.input_sizes[0].end());
+        return std::make_unique<FixedShapeEchoBackend>(shape);
+    };
+}
+
+TEST(ShapeBucketBackendTest, PadsIntoTheSmallestFittingBucketAndCropsOutputs) {
+    std::atomic<int> loads{0};
+    ShapeBucketBackend backend("fake_model", false, make_shape_buckets({1, 2}, {{{2, 2}}, {{4, 4}}}),
+                               echo_bucket_loader(loads));
+    EXPECT_EQ(backend.bucket_count(), 4u);
+    EXPECT_EQ(loads.load(), 0);
+    EXPECT_EQ(backend.select_bucket({{1, 2, 3}}), 1u);
+    EXPECT_EQ(backend.select_bucket({{2, 1, 1}}), 2u);
+    EXPECT_THROW(backend.select_bucket({{3, 1, 1}}), InferenceExecutionException);
+
+    // 1x2x3 runs padded in the 1x4x4 bucket and comes back at 1x2x3.
+    const std::vector<float> frame{1, 2, 3, 4, 5, 6};
+    const std::vector<int64_t> shape{1, 2, 3};
+    const std::vector<TensorView> inputs{TensorView(frame.data(), frame.size() * sizeof(float), shape)};
+    auto [outputs, shapes] = backend.get_infer_results(inputs);
+    ASSERT_EQ(shapes.size(), 1u);
+    EXPECT_EQ(shapes[0], shape);
+    ASSERT_EQ(outputs[0].size(), frame.size());
+    for (size_t i = 0; i < frame.size(); ++i) {
+        EXPECT_FLOAT_EQ(std::get<float>(outputs[0][i]), frame[i]);
+    }
+
+    const auto raw = backend.get_infer_results_raw(inputs);
+    ASSERT_EQ(raw.size(), 1u);
+    EXPECT_EQ(raw[0].shape, shape);
+    ASSERT_EQ(raw[0].bytes.size(), frame.size() * sizeof(float));
+    EXPECT_EQ(std::memcmp(raw[0].bytes.data(), frame.data(), raw[0].bytes.size()), 0);
+    EXPECT_EQ(loads.load(), 1);
+    EXPECT_EQ(backend.loaded_buckets(), 1u);
+
+    // An exact fit runs unpadded in its own bucket.
+    const std::vector<float> pair(2 * 2 * 2, 1.0f);
+    const std::vector<int64_t> pair_shape{2, 2, 2};
+    auto exact = backend.get_infer_results(
+        std::vector<TensorView>{TensorView(pair.data(), pair.size() * sizeof(float), pair_shape)});
+    EXPECT_EQ(std::get<1>(exact)[0], pair_shape);
+    EXPECT_EQ(loads.load(), 2);
+    EXPECT_EQ(backend.get_total_inferences(), 3u);
+}
+
+TEST(ShapeBucketBackendTest, FailedBucketsRetryAndPreloadReportsThem) {
+    std::atomic<int> attempts{0};
+    auto failing = [&attempts](const ShapeBucket&) -> std::unique_ptr<InferenceInterface> {
+        ++attempts;
+        return nullptr;
+    };
+    ShapeBucketBackend lazy("fake_model", false, make_shape_buckets({1}, {{{2}}}), failing);
+    const std::vector<float> values{1, 2};
+    const std::vector<int64_t> shape{1, 2};
+    const std::vector<TensorView> inputs{TensorView(values.data(), sizeof(float) * 2, shape)};
+    EXPECT_THROW(lazy.get_infer_results(inputs), InferenceExecutionException);
+    EXPECT_THROW(lazy.get_infer_results(inputs), InferenceExecutionException);
+    EXPECT_EQ(attempts.load(), 2);
+
+    EXPECT_THROW(ShapeBucketBackend("fake_model", false, make_shape_buckets({1}, {{{2}}}), failing, true),
+                 ModelLoadException);
+    EXPECT_THROW(ShapeBucketBackend("fake_model", false, {}, failing), InferenceException);
+}
+
+// ---------------------------------------------------------------------------
+// Asynchronous inference
+// ---------------------------------------------------------------------------
+
+TEST(AsyncInferenceTest, FutureMatchesSynchronousResults) {
     FakeBackend backend;
-    backend.load();
-    EXPECT_THROW(backend.get_infer_results_raw(make_input()), InferenceExecutionException);
+    const auto expected = backend.get_infer_results(make_input());
+
+    auto owned = backend.infer_async(make_input());
+    EXPECT_EQ(owned.get(), expected);
+
+    const std::vector<std::vector<uint8_t>> input = make_input();
+    auto viewed = backend.infer_async(make_tensor_views(input));
+    EXPECT_EQ(viewed.get(), expected);
+    EXPECT_EQ(backend.call_count_, 3);
 }
 
-TEST(RawOutputApiTest, RawPathKeepsDecoratorAugmentations) {
-    auto fake = std::make_unique<HomogeneousFakeBackend>();
-    HomogeneousFakeBackend* inner = fake.get();
-    CachingBackend cached(std::move(fake));
+TEST(AsyncInferenceTest, FailuresReachTheFutureAndCallback) {
+    FakeBackend backend;
+    backend.throw_on_infer_ = true;
+    auto future = backend.infer_async(make_input());
+    EXPECT_THROW(future.get(), InferenceExecutionException);
+
+    std::promise<bool> failed;
+    backend.infer_async(make_input(), [&failed](std::exception_ptr error, auto results) {
+        failed.set_value(error != nullptr && std::get<0>(results).empty());
+    });
+    EXPECT_TRUE(failed.get_future().get());
+}
 
-    const auto first = cached.get_infer_results_raw(make_input());
-    const auto second = cached.get_infer_results_raw(make_input());
+TEST(AsyncInferenceTest, CallsOnOneInstanceNeverOverlap) {
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    ExclusiveBackend backend(3, active, peak);
 
-    // The raw default routes through the decorator's variant path, so the
-    // second call is a cache hit and the inner backend runs exactly once.
-    EXPECT_EQ(inner->call_count_, 1);
-    ASSERT_EQ(second.size(), first.size());
-    EXPECT_EQ(second[0].bytes, first[0].bytes);
-    EXPECT_EQ(second[1].bytes, first[1].bytes);
+    std::vector<std::future<std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>>>
+        futures;
+    for (int i = 0; i < 16; ++i) {
+        futures.push_back(backend.infer_async(make_input()));
+    }
+    for (auto& future : futures) {
+        EXPECT_EQ(std::get<int32_t>(std::get<0>(future.get())[0][0]), 3);
+    }
+    EXPECT_FALSE(backend.overlapped_);
+    EXPECT_EQ(backend.calls_, 16);
+}
+
+TEST(AsyncInferenceTest, CompletionQueueRunsCallbacksOnTheDrainingThread) {
+    FakeBackend backend;
+    CompletionQueue queue;
+    std::vector<std::thread::id> callback_threads;
+    for (int i = 0; i < 3; ++i) {
+        backend.infer_async(make_input(), queue, [&callback_threads](std::exception_ptr error, auto results) {
+            EXPECT_EQ(error, nullptr);
+            EXPECT_EQ(std::get<0>(results).size(), 1u);
+            callback_threads.push_back(std::this_thread::get_id());
+        });
+    }
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(queue.run_one());
+    }
+    EXPECT_EQ(queue.poll(), 0u);
+    EXPECT_EQ(callback_threads, std::vector<std::thread::id>(3, std::this_thread::get_id()));
+
+    queue.shutdown();
+    EXPECT_FALSE(queue.run_one());
+}
+
+TEST(AsyncInferenceTest, PoolRunsAsyncCallsOnEveryInstance) {
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    std::vector<ExclusiveBackend*> fakes;
+    std::vector<std::unique_ptr<InferenceInterface>> instances;
+    for (int32_t id = 0; id < 2; ++id) {
+        auto fake = std::make_unique<ExclusiveBackend>(id, active, peak);
+        fakes.push_back(fake.get());
+        instances.push_back(std::move(fake));
+    }
+    BackendPool pool(std::move(instances));
+
+    std::vector<std::future<std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>>>
+        futures;
+    for (int i = 0; i < 20; ++i) {
+        futures.push_back(pool.infer_async(make_input()));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+    EXPECT_FALSE(fakes[0]->overlapped_);
+    EXPECT_FALSE(fakes[1]->overlapped_);
+    EXPECT_EQ(fakes[0]->calls_ + fakes[1]->calls_, 20);
+    EXPECT_LE(peak.load(), 2);
+}
+
+TEST(AsyncInferenceTest, RunnerLoadsBeforeStarting) {
+    auto fake = std::make_unique<FakeBackend>();
+    FakeBackend* raw_fake = fake.get();
+    ModelRunner runner(std::move(fake));
+    auto future = runner.run_async(make_input());
+    EXPECT_EQ(raw_fake->load_count_, 1);
+    EXPECT_EQ(std::get<0>(future.get()).size(), 1u);
+}
+
+// ---------------------------------------------------------------------------
+// Lock-free rings and InferencePipeline
+// ---------------------------------------------------------------------------
+
+TEST(LockFreeRingTest, SpscKeepsFifoOrderAndBounds) {
+    SpscRing<int> ring(3);
+    ASSERT_EQ(ring.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(4));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+
+    // Wraps around across threads without losing or reordering values.
+    constexpr int kCount = 100000;
+    std::thread producer([&] {
+        for (int i = 0; i < kCount; ++i) {
+            while (!ring.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int expected = 0;
+    while (expected < kCount) {
+        if (ring.try_pop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+TEST(LockFreeRingTest, MpmcDeliversEveryValueOnce) {
+    MpmcRing<uint32_t> ring(8);
+    constexpr uint32_t kPerProducer = 20000;
+    std::vector<std::atomic<int>> seen(4 * kPerProducer);
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < 4; ++p) {
+        threads.emplace_back([&, p] {
+            for (uint32_t i = 0; i < kPerProducer; ++i) {
+                while (!ring.try_push(p * kPerProducer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::atomic<uint32_t> consumed{0};
+    for (int c = 0; c < 3; ++c) {
+        threads.emplace_back([&] {
+            uint32_t value = 0;
+            while (consumed.load() < 4 * kPerProducer) {
+                if (ring.try_pop(value)) {
+                    seen[value].fetch_add(1);
+                    consumed.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const std::atomic<int>& count : seen) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
+
+namespace {
+
+// Doubles one input byte per frame; the slower post stage reorders
+// completions when it runs on several threads.
+InferencePipeline<int, float>::PreprocessStage byte_preprocess() {
+    return [](const int& input, std::vector<std::vector<uint8_t>>& tensors) {
+        tensors.resize(1);
+        tensors[0].assign(1, static_cast<uint8_t>(input));
+    };
+}
+
+InferencePipeline<int, float>::PostprocessStage float_postprocess() {
+    return [](const int& input, std::vector<RawOutputTensor>& outputs) {
+        if (input % 7 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(300));
+        }
+        float value = 0.0f;
+        std::memcpy(&value, outputs.at(0).bytes.data(), sizeof(value));
+        return value;
+    };
+}
+
+} // namespace
+
+TEST(InferencePipelineTest, DeliversInPushOrderWithParallelStages) {
+    RowBackend backend;
+    PipelineOptions options;
+    options.max_in_flight = 8;
+    options.preprocess_threads = 3;
+    options.postprocess_threads = 4;
+    InferencePipeline<int, float> pipeline(backend, byte_preprocess(), float_postprocess(), options);
+
+    constexpr int kFrames = 200;
+    std::thread producer([&] {
+        for (int i = 0; i < kFrames; ++i) {
+            ASSERT_TRUE(pipeline.push(i % 100));
+        }
+        pipeline.close();
+    });
+    std::vector<float> results;
+    float value = 0.0f;
+    while (pipeline.pop(value)) {
+        results.push_back(value);
+    }
+    producer.join();
+
+    ASSERT_EQ(results.size(), static_cast<size_t>(kFrames));
+    for (int i = 0; i < kFrames; ++i) {
+        EXPECT_EQ(results[i], 2.0f * static_cast<float>(i % 100)) << i;
+    }
+    EXPECT_FALSE(pipeline.push(1));
+}
+
+TEST(InferencePipelineTest, AppliesBackpressureAndRecyclesInputTensors) {
+    RowBackend backend;
+    std::vector<const uint8_t*> buffers;
+    std::mutex buffers_mutex;
+    PipelineOptions options;
+    options.max_in_flight = 2;
+    InferencePipeline<int, float> pipeline(
+        backend,
+        [&](const int& input, std::vector<std::vector<uint8_t>>& tensors) {
+            tensors.resize(1);
+            tensors[0].resize(64);
+            tensors[0][0] = static_cast<uint8_t>(input);
+            tensors[0].resize(1);
+            std::lock_guard<std::mutex> lock(buffers_mutex);
+            buffers.push_back(tensors[0].data());
+        },
+        float_postprocess(), options);
+
+    int input = 1;
+    ASSERT_TRUE(pipeline.try_push(input));
+    input = 2;
+    ASSERT_TRUE(pipeline.try_push(input));
+    input = 3;
+    EXPECT_FALSE(pipeline.try_push(input)); // both slots taken until a pop
+
+    float value = 0.0f;
+    ASSERT_TRUE(pipeline.pop(value));
+    EXPECT_EQ(value, 2.0f);
+    ASSERT_TRUE(pipeline.try_push(input));
+    ASSERT_TRUE(pipeline.pop(value));
+    ASSERT_TRUE(pipeline.pop(value));
+    EXPECT_EQ(value, 6.0f);
+
+    // The third frame reused the first frame's slot and its tensor storage.
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    ASSERT_EQ(buffers.size(), 3u);
+    EXPECT_EQ(buffers[2], buffers[0]);
+}
+
+TEST(InferencePipelineTest, StageFailuresSurfaceInOrder) {
+    RowBackend backend;
+    InferencePipeline<int, float> pipeline(
+        backend,
+        [](const int& input, std::vector<std::vector<uint8_t>>& tensors) {
+            if (input == 2) {
+                throw InferenceException("bad frame");
+            }
+            tensors.assign(1, std::vector<uint8_t>(1, static_cast<uint8_t>(input)));
+        },
+        float_postprocess());
+
+    for (int i = 1; i <= 3; ++i) {
+        ASSERT_TRUE(pipeline.push(i));
+    }
+    float value = 0.0f;
+    ASSERT_TRUE(pipeline.pop(value));
+    EXPECT_EQ(value, 2.0f);
+    EXPECT_THROW(pipeline.pop(value), InferenceException);
+    ASSERT_TRUE(pipeline.pop(value));
+    EXPECT_EQ(value, 6.0f);
+}
+
+// RowBackend for one row at a time, with metadata that fixes its output size.
+class SingleRowBackend : public RowBackend {
+  public:
+    SingleRowBackend() {
+        inference_metadata_.addInput("input", {1}, 1, TensorDataType::UInt8);
+        inference_metadata_.addOutput("output", {1, 1}, 1, TensorDataType::Float32);
+    }
+};
+
+TEST(InferencePipelineTest, RecyclesOutputBuffersUnlessAnOutputIsKept) {
+    SingleRowBackend backend;
+    PipelineOptions options;
+    options.max_in_flight = 1;
+    std::vector<const uint8_t*> buffers;
+    InferencePipeline<int, TensorBuffer> pipeline(
+        backend, byte_preprocess(),
+        [&](const int& input, std::vector<RawOutputTensor>& outputs) {
+            buffers.push_back(outputs.at(0).bytes.data());
+            EXPECT_EQ(outputs[0].shape, (std::vector<int64_t>{1, 1}));
+            // Odd frames keep their output beyond the frame.
+            return input % 2 == 1 ? outputs[0].bytes : TensorBuffer();
+        },
+        options);
+
+    std::vector<TensorBuffer> kept;
+    for (int i = 1; i <= 5; ++i) {
+        ASSERT_TRUE(pipeline.push(i));
+        TensorBuffer result;
+        ASSERT_TRUE(pipeline.pop(result));
+        if (!result.empty()) {
+            kept.push_back(std::move(result));
+        }
+    }
+    ASSERT_EQ(buffers.size(), 5u);
+    // Frame 1 ran on the raw path and sized the slot's buffer. Frame 3
+    // reused frame 2's buffer and kept it, so frame 4 took a new one; frame
+    // 5 reused frame 4's.
+    EXPECT_EQ(buffers[2], buffers[1]);
+    EXPECT_NE(buffers[3], buffers[2]);
+    EXPECT_EQ(buffers[4], buffers[3]);
+    ASSERT_EQ(kept.size(), 3u);
+    float value = 0.0f;
+    std::memcpy(&value, kept[1].data(), sizeof(value));
+    EXPECT_EQ(value, 6.0f);
+    std::memcpy(&value, kept[2].data(), sizeof(value));
+    EXPECT_EQ(value, 10.0f);
+    EXPECT_EQ(backend.batches_.size(), 5u);
+}
+
+// RowBackend for two rows at a time whose output metadata leaves out the
+// batch dim, as OpenVINO's does: it promises 4 bytes per output, not 8.
+class BatchlessMetadataRowBackend : public RowBackend {
+  public:
+    BatchlessMetadataRowBackend() {
+        inference_metadata_.addInput("input", {1}, 2, TensorDataType::UInt8);
+        inference_metadata_.addOutput("output", {1}, 2, TensorDataType::Float32);
+    }
+};
+
+TEST(InferencePipelineTest, SizesOutputBuffersFromTheFirstFrame) {
+    BatchlessMetadataRowBackend backend;
+    PipelineOptions options;
+    options.max_in_flight = 2;
+    InferencePipeline<int, std::vector<float>> pipeline(
+        backend,
+        [](const int& input, std::vector<std::vector<uint8_t>>& tensors) {
+            tensors.assign(1, {static_cast<uint8_t>(input), static_cast<uint8_t>(input + 1)});
+        },
+        [](const int&, std::vector<RawOutputTensor>& outputs) {
+            std::vector<float> values(outputs.at(0).element_count());
+            std::memcpy(values.data(), outputs[0].bytes.data(), outputs[0].bytes.size());
+            return values;
+        },
+        options);
+
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_TRUE(pipeline.push(i * 10));
+        std::vector<float> values;
+        ASSERT_TRUE(pipeline.pop(values));
+        EXPECT_EQ(values, (std::vector<float>{20.0f * i, 20.0f * i + 2.0f})) << i;
+    }
+    EXPECT_EQ(backend.batches_.size(), 6u);
+}
+
+TEST(InferencePipelineTest, RejectsZeroSizedStages) {
+    RowBackend backend;
+    PipelineOptions options;
+    options.inference_threads = 0;
+    using Pipeline = InferencePipeline<int, float>;
+    EXPECT_THROW(Pipeline(backend, byte_preprocess(), float_postprocess(), options), InferenceException);
+}
+
+// ---------------------------------------------------------------------------
+// Abstract Factory products: HostAllocator
+// ---------------------------------------------------------------------------
+
+TEST(HostAllocatorTest, AllocatesUsableMemory) {
+    HostAllocator alloc;
+    EXPECT_STREQ(alloc.name(), "HostAllocator");
+
+    void* p = alloc.allocate(64);
+    ASSERT_NE(p, nullptr);
+    std::memset(p, 0, 64); // must be writable
+    alloc.deallocate(p);
+}
+
+// ---------------------------------------------------------------------------
+// Abstract Factory products: HostTensorConverter
+// ---------------------------------------------------------------------------
+
+TEST(HostTensorConverterTest, ToTypedDecodesFloatBytes) {
+    HostTensorConverter conv;
+    EXPECT_STREQ(conv.name(), "HostTensorConverter");
+
+    const float values[2] = {1.5f, -2.25f};
+    std::vector<uint8_t> raw(sizeof(values));
+    std::memcpy(raw.data(), values, sizeof(values));
+
+    auto out = conv.to_typed(raw, TensorDataType::Float32);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_FLOAT_EQ(std::get<float>(out[0]), 1.5f);
+    EXPECT_FLOAT_EQ(std::get<float>(out[1]), -2.25f);
+}
+
+TEST(HostTensorConverterTest, FromBackendDecodesInt64) {
+    HostTensorConverter conv;
+    const int64_t values[3] = {7, -1, 1000};
+    auto out = conv.from_backend(values, 3, TensorDataType::Int64);
+    ASSERT_EQ(out.size(), 3u);
+    EXPECT_EQ(std::get<int64_t>(out[0]), 7);
+    EXPECT_EQ(std::get<int64_t>(out[1]), -1);
+    EXPECT_EQ(std::get<int64_t>(out[2]), 1000);
+}
+
+TEST(HostTensorConverterTest, WidensInt8ToInt32) {
+    HostTensorConverter conv;
+    const int8_t values[2] = {-5, 5};
+    auto out = conv.from_backend(values, 2, TensorDataType::Int8);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(std::get<int32_t>(out[0]), -5);
+    EXPECT_EQ(std::get<int32_t>(out[1]), 5);
+}
+
+TEST(HostTensorConverterTest, HandlesEmptyAndNull) {
+    HostTensorConverter conv;
+    EXPECT_TRUE(conv.to_typed({}, TensorDataType::Float32).empty());
+    EXPECT_TRUE(conv.from_backend(nullptr, 4, TensorDataType::Int32).empty());
+}
+
+TEST(HostTensorConverterTest, AppendsWidenedFloat16AndBool) {
+    HostTensorConverter conv;
+    std::vector<TensorElement> out;
+    out.emplace_back(int64_t{9});
+
+    const uint16_t halves[3] = {0x3C00, 0xC000, 0x3800}; // 1, -2, 0.5
+    conv.append_elements(out, halves, 3, ElementType::Float16);
+    const uint8_t flags[2] = {0, 42};
+    conv.append_elements(out, flags, 2, ElementType::Bool);
+
+    ASSERT_EQ(out.size(), 6u);
+    EXPECT_EQ(std::get<int64_t>(out[0]), 9);
+    EXPECT_EQ(std::get<float>(out[1]), 1.0f);
+    EXPECT_EQ(std::get<float>(out[2]), -2.0f);
+    EXPECT_EQ(std::get<float>(out[3]), 0.5f);
+    EXPECT_EQ(std::get<uint8_t>(out[4]), 0);
+    EXPECT_EQ(std::get<uint8_t>(out[5]), 1);
+}
+
+TEST(HostTensorConverterTest, WidensInt8AcrossKernelBlocks) {
+    HostTensorConverter conv;
+    std::vector<int8_t> values(1000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int8_t>(static_cast<int>(i % 256) - 128);
+    }
+
+    auto out = conv.from_backend(values.data(), values.size(), TensorDataType::Int8);
+    ASSERT_EQ(out.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(std::get<int32_t>(out[i]), values[i]) << i;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Backend tuning (EngineOptions::tuning)
+// ---------------------------------------------------------------------------
+
+// Sets an environment variable for the lifetime of the object.
+class ScopedEnv {
+  public:
+    ScopedEnv(const char* name, const char* value) : name_(name) { setenv(name, value, 1); }
+    ~ScopedEnv() { unsetenv(name_); }
+
+  private:
+    const char* name_;
+};
+
+TEST(BackendTuningTest, DefaultsLeaveOrtUntouched) {
+    const OrtTuning tuning = OrtTuning().with_env_defaults();
+    EXPECT_EQ(tuning.intra_op_threads, 0);
+    EXPECT_EQ(tuning.inter_op_threads, 0);
+    EXPECT_EQ(tuning.execution_mode, OrtTuning::ExecutionMode::Default);
+    EXPECT_EQ(tuning.graph_optimization, OrtTuning::GraphOptimization::Default);
+    EXPECT_EQ(tuning.allow_spinning, TuningToggle::Default);
+    EXPECT_EQ(tuning.cpu_mem_arena, TuningToggle::Default);
+    EXPECT_EQ(tuning.mem_pattern, TuningToggle::Default);
+    EXPECT_EQ(tuning.global_thread_pools, TuningToggle::Default);
+    EXPECT_EQ(tuning.shared_cpu_allocator, TuningToggle::Default);
+    EXPECT_EQ(tuning.share_prepacked_weights, TuningToggle::Default);
+}
+
+TEST(BackendTuningTest, EnvironmentFillsOnlyUnsetFields) {
+    ScopedEnv intra("NEURIPLO_ORT_INTRA_OP_THREADS", "4");
+    ScopedEnv mode("NEURIPLO_ORT_EXECUTION_MODE", "parallel");
+    ScopedEnv level("NEURIPLO_ORT_GRAPH_OPTIMIZATION", "basic");
+    ScopedEnv spinning("NEURIPLO_ORT_ALLOW_SPINNING", "0");
+    ScopedEnv pools("NEURIPLO_ORT_GLOBAL_THREAD_POOLS", "1");
+    ScopedEnv prepacked("NEURIPLO_ORT_SHARE_PREPACKED_WEIGHTS", "false");
+
+    OrtTuning explicit_fields;
+    explicit_fields.inter_op_threads = 2;
+    explicit_fields.graph_optimization = OrtTuning::GraphOptimization::All;
+
+    const OrtTuning tuning = explicit_fields.with_env_defaults();
+    EXPECT_EQ(tuning.intra_op_threads, 4);
+    EXPECT_EQ(tuning.inter_op_threads, 2);
+    EXPECT_EQ(tuning.execution_mode, OrtTuning::ExecutionMode::Parallel);
+    EXPECT_EQ(tuning.graph_optimization, OrtTuning::GraphOptimization::All);
+    EXPECT_EQ(tuning.allow_spinning, TuningToggle::Off);
+    EXPECT_EQ(tuning.cpu_mem_arena, TuningToggle::Default);
+    EXPECT_EQ(tuning.global_thread_pools, TuningToggle::On);
+    EXPECT_EQ(tuning.share_prepacked_weights, TuningToggle::Off);
+}
+
+TEST(BackendTuningTest, RejectsMalformedEnvironmentValues) {
+    {
+        ScopedEnv threads("NEURIPLO_ORT_INTRA_OP_THREADS", "four");
+        EXPECT_THROW(OrtTuning().with_env_defaults(), InferenceException);
+    }
+    {
+        ScopedEnv arena("NEURIPLO_ORT_CPU_MEM_ARENA", "maybe");
+        EXPECT_THROW(OrtTuning().with_env_defaults(), InferenceException);
+    }
+    EXPECT_NO_THROW(OrtTuning().with_env_defaults());
+}
+
+// ---------------------------------------------------------------------------
+// Artifact cache
+// ---------------------------------------------------------------------------
+
+TEST(ContentHashTest, StreamingMatchesOneShot) {
+    std::vector<uint8_t> bytes(1000);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    const uint64_t whole = content_hash(bytes.data(), bytes.size());
+
+    ContentHasher hasher;
+    for (size_t offset = 0, chunk = 1; offset < bytes.size(); offset += chunk, chunk = chunk % 13 + 1) {
+        hasher.update(bytes.data() + offset, std::min(chunk, bytes.size() - offset));
+    }
+    EXPECT_EQ(hasher.digest(), whole);
+
+    bytes[500] ^= 1;
+    EXPECT_NE(content_hash(bytes.data(), bytes.size()), whole);
+    EXPECT_NE(content_hash(bytes.data(), bytes.size() - 1), content_hash(bytes.data(), bytes.size()));
+}
+
+TEST(ContentHashTest, Wide128BitHashCoversEveryByte) {
+    std::vector<uint8_t> bytes(1000);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    const ContentHash128 whole = content_hash128(bytes.data(), bytes.size());
+    EXPECT_EQ(content_hash128(bytes.data(), bytes.size()), whole);
+    EXPECT_NE(whole.low, whole.high);
+    EXPECT_NE(content_hash128(bytes.data(), bytes.size(), 1), whole);
+
+    // Stripes, whole words and the tail all reach both halves.
+    for (size_t offset : {size_t{0}, size_t{31}, size_t{990}, size_t{999}}) {
+        bytes[offset] ^= 1;
+        const ContentHash128 flipped = content_hash128(bytes.data(), bytes.size());
+        EXPECT_NE(flipped.low, whole.low) << offset;
+        EXPECT_NE(flipped.high, whole.high) << offset;
+        bytes[offset] ^= 1;
+    }
+    // Lengths differing only by trailing zeros hash differently.
+    const std::vector<uint8_t> zeros(16, 0);
+    EXPECT_NE(content_hash128(zeros.data(), 15), content_hash128(zeros.data(), 16));
+    EXPECT_NE(content_hash128(zeros.data(), 0), content_hash128(zeros.data(), 1));
+}
+
+// Fresh directory under the system temp dir, removed with its contents.
+class ScopedTempDir {
+  public:
+    ScopedTempDir() {
+        static std::atomic<int> counter{0};
+        path_ = std::filesystem::temp_directory_path() /
+                ("neuriplo-test-" + std::to_string(::getpid()) + "-" + std::to_string(counter++));
+        std::filesystem::create_directories(path_);
+    }
+    ~ScopedTempDir() {
+        std::error_code error;
+        std::filesystem::remove_all(path_, error);
+    }
+
+    std::string file(const std::string& name, const std::string& content) const {
+        const std::string path = (path_ / name).string();
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+    std::string path() const { return path_.string(); }
+
+  private:
+    std::filesystem::path path_;
+};
+
+TEST(ArtifactCacheTest, DisabledWithoutDirectory) {
+    unsetenv("NEURIPLO_ARTIFACT_CACHE_DIR");
+    const ArtifactCache cache;
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_EQ(cache.artifact_path({"onnxruntime", "1.0", "model.onnx", "", ".onnx"}), "");
+    EXPECT_EQ(cache.backend_directory("openvino", "2025"), "");
+
+    ScopedTempDir dir;
+    ScopedEnv env("NEURIPLO_ARTIFACT_CACHE_DIR", dir.path().c_str());
+    EXPECT_TRUE(ArtifactCache().enabled());
+    EXPECT_EQ(ArtifactCache().root(), dir.path());
+}
+
+TEST(ArtifactCacheTest, KeyFollowsContentVersionAndOptions) {
+    ScopedTempDir dir;
+    const ArtifactCache cache(dir.path() + "/cache");
+    const std::string model = dir.file("model.onnx", "weights-v1");
+    const std::string twin = dir.file("twin.onnx", "weights-v1");
+
+    const ArtifactKey key{"onnxruntime", "1.19.2", model, "level=4", ".ort.onnx"};
+    const std::string path = cache.artifact_path(key);
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.rfind(cache.backend_directory("onnxruntime", "1.19.2"), 0), 0u);
+    EXPECT_EQ(path.substr(path.size() - 9), ".ort.onnx");
+    EXPECT_EQ(cache.artifact_path(key), path);
+
+    // Content-addressed: a copy of the model maps to the same artifact.
+    ArtifactKey copy = key;
+    copy.model_path = twin;
+    EXPECT_EQ(cache.artifact_path(copy), path);
+
+    ArtifactKey other = key;
+    other.options = "level=2";
+    EXPECT_NE(cache.artifact_path(other), path);
+    other = key;
+    other.backend_version = "1.20.0";
+    EXPECT_NE(cache.artifact_path(other), path);
+
+    // Rewriting the model file changes its hash (size differs, so the
+    // memoized value is not reused).
+    dir.file("model.onnx", "weights-v22");
+    EXPECT_NE(cache.artifact_path(key), path);
+
+    EXPECT_EQ(cache.artifact_path({"onnxruntime", "1.19.2", dir.path() + "/missing.onnx", "", ".onnx"}), "");
+}
+
+TEST(ArtifactCacheTest, KeyFollowsDataFiles) {
+    ScopedTempDir dir;
+    const ArtifactCache cache(dir.path() + "/cache");
+    const std::string model = dir.file("model.onnx", "graph");
+    const std::string weights = dir.file("weights.bin", "weights-v1");
+
+    ArtifactKey key{"onnxruntime", "1.19.2", model, "level=4", ".ort.onnx"};
+    const std::string bare = cache.artifact_path(key);
+    key.data_paths = {weights};
+    const std::string path = cache.artifact_path(key);
+    ASSERT_FALSE(path.empty());
+    EXPECT_NE(path, bare);
+
+    // Retrained external weights give the model a new artifact.
+    dir.file("weights.bin", "weights-v22");
+    EXPECT_NE(cache.artifact_path(key), path);
+
+    key.data_paths = {dir.path() + "/missing.bin"};
+    EXPECT_EQ(cache.artifact_path(key), "");
+}
+
+TEST(ArtifactCacheTest, PublishMovesStagingFileIntoPlace) {
+    ScopedTempDir dir;
+    const ArtifactCache cache(dir.path());
+    const std::string model = dir.file("model.tflite", "flatbuffer");
+    const std::string artifact = cache.artifact_path({"litert", "2.19.0", model, "xnnpack", ".xnnpack_cache"});
+    ASSERT_FALSE(artifact.empty());
+
+    const std::string staging = ArtifactCache::staging_path(artifact);
+    EXPECT_NE(staging, ArtifactCache::staging_path(artifact));
+    std::ofstream(staging, std::ios::binary) << "packed";
+    EXPECT_FALSE(std::filesystem::exists(artifact));
+
+    EXPECT_TRUE(ArtifactCache::publish(staging, artifact));
+    EXPECT_FALSE(std::filesystem::exists(staging));
+    std::ifstream published(artifact, std::ios::binary);
+    std::string content;
+    published >> content;
+    EXPECT_EQ(content, "packed");
+
+    EXPECT_FALSE(ArtifactCache::publish(staging, artifact));
+    ArtifactCache::discard(artifact);
+    EXPECT_FALSE(std::filesystem::exists(artifact));
+}
+
+// ---------------------------------------------------------------------------
+// Memory-mapped models
+// ---------------------------------------------------------------------------
+
+TEST(MappedModelTest, MapsFileContentAndSharesLiveMapping) {
+    ScopedTempDir dir;
+    const std::string model = dir.file("model.plan", "serialized-engine");
+
+    MmapTuning tuning;
+    tuning.prefault = TuningToggle::On;
+    const auto first = MappedModel::open(model, tuning);
+    ASSERT_EQ(first->size(), 17u);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(first->data()), first->size()), "serialized-engine");
+
+    const auto second = MappedModel::open(model);
+    EXPECT_EQ(second.get(), first.get());
+}
+
+TEST(MappedModelTest, RemapsChangedFileAndRejectsMissingOnes) {
+    ScopedTempDir dir;
+    const std::string model = dir.file("model.tflite", "v1");
+    const auto old_mapping = MappedModel::open(model);
+
+    // Replaced (not rewritten in place), as deployments swap model files.
+    const std::string replacement = dir.file("model.tflite.new", "version-2");
+    std::filesystem::rename(replacement, model);
+    const auto new_mapping = MappedModel::open(model);
+    EXPECT_NE(new_mapping.get(), old_mapping.get());
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(new_mapping->data()), new_mapping->size()), "version-2");
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(old_mapping->data()), old_mapping->size()), "v1");
+
+    EXPECT_THROW(MappedModel::open(dir.path() + "/missing.plan"), ModelLoadException);
+    EXPECT_THROW(MappedModel::open(dir.file("empty.plan", "")), ModelLoadException);
+}
+
+TEST(MappedModelTest, EnvironmentFillsUnsetSwitches) {
+    ScopedEnv enabled("NEURIPLO_MMAP", "0");
+    ScopedEnv lock("NEURIPLO_MMAP_LOCK", "1");
+    MmapTuning explicit_fields;
+    explicit_fields.enabled = TuningToggle::On;
+
+    const MmapTuning tuning = explicit_fields.with_env_defaults();
+    EXPECT_EQ(tuning.enabled, TuningToggle::On);
+    EXPECT_EQ(tuning.prefault, TuningToggle::Default);
+    EXPECT_EQ(tuning.lock, TuningToggle::On);
+}
+
+// ---------------------------------------------------------------------------
+// Warmup
+// ---------------------------------------------------------------------------
+
+// Sleeps for the next scripted latency (repeating the last) and records the
+// first byte of every input it is given.
+class ScriptedLatencyBackend : public FakeBackend {
+  public:
+    explicit ScriptedLatencyBackend(std::vector<int> latencies_ms) : latencies_ms_(std::move(latencies_ms)) {}
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        const size_t index = std::min(seen_.size(), latencies_ms_.size() - 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(latencies_ms_[index]));
+        seen_.push_back(input_tensors.at(0).at(0));
+        return FakeBackend::get_infer_results(input_tensors);
+    }
+
+    std::vector<uint8_t> seen_;
+
+  private:
+    std::vector<int> latencies_ms_;
+};
+
+TEST(WarmupTest, SynthesizesTypedInputsFromMetadata) {
+    InferenceMetadata metadata;
+    metadata.addInput("images", {-1, 3, 4, 4}, 2);
+    metadata.addInput("ids", {1, -1}, 1, TensorDataType::Int64);
+    metadata.addInput("mask", {1, -1}, 1, TensorDataType::Bool);
+
+    const auto inputs = synthesize_warmup_inputs(metadata, {{3, 4, 4}, {7}});
+    ASSERT_EQ(inputs.size(), 3u);
+    EXPECT_EQ(inputs[0].size(), 2u * 3 * 4 * 4 * sizeof(float));
+    EXPECT_EQ(inputs[1].size(), 7 * sizeof(int64_t));
+    // No size given: dynamic dimensions fall back to 1.
+    EXPECT_EQ(inputs[2].size(), 1u);
+    EXPECT_TRUE(std::all_of(inputs[0].begin(), inputs[0].end(), [](uint8_t byte) { return byte == 0; }));
+}
+
+TEST(WarmupTest, StopsOnceLatencySettles) {
+    ScriptedLatencyBackend backend({40, 20, 10});
+    const WarmupResult result = warm_up(backend, 20, {make_input()});
+    EXPECT_GE(result.iterations, 4u);
+    EXPECT_LT(result.iterations, 20u);
+    EXPECT_GT(result.first_ms, result.last_ms);
+    EXPECT_EQ(warm_up(backend, 0, {make_input()}).iterations, 0u);
+}
+
+TEST(WarmupTest, CyclesThroughSamplesUpToTheLimit) {
+    ScriptedLatencyBackend backend({1, 4, 16});
+    const WarmupResult result = warm_up(backend, 3, {make_input(1), make_input(9)});
+    EXPECT_EQ(result.iterations, 3u);
+    EXPECT_EQ(backend.seen_, (std::vector<uint8_t>{1, 9, 1}));
+
+    backend.throw_on_infer_ = true;
+    EXPECT_THROW(warm_up(backend, 3, {make_input()}), InferenceExecutionException);
+}
+
+// ---------------------------------------------------------------------------
+// Model manager
+// ---------------------------------------------------------------------------
+
+namespace {
+
+EngineOptions model_options(const std::string& model_path, size_t batch_size = 1) {
+    EngineOptions options;
+    options.model_path = model_path;
+    options.batch_size = batch_size;
+    return options;
+}
+
+// Loads FakeBackends counting every load; each model weighs 100 bytes.
+ModelManagerOptions counting_manager_options(std::shared_ptr<std::atomic<int>> loads, size_t budget = 0) {
+    ModelManagerOptions options;
+    options.memory_budget_bytes = budget;
+    options.loader = [loads](const EngineOptions& engine_options) -> std::unique_ptr<InferenceInterface> {
+        ++*loads;
+        if (engine_options.model_path == "broken") {
+            return nullptr;
+        }
+        auto backend = std::make_unique<FakeBackend>();
+        backend->load();
+        return backend;
+    };
+    options.memory_estimator = [](const EngineOptions&, const InferenceInterface&) { return size_t{100}; };
+    return options;
+}
+
+} // namespace
+
+TEST(ModelManagerTest, SharesIdenticalLoads) {
+    auto loads = std::make_shared<std::atomic<int>>(0);
+    ModelManager manager(counting_manager_options(loads));
+
+    const auto first = manager.acquire(model_options("a"));
+    const auto second = manager.acquire(model_options("./a"));
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(loads->load(), 1);
+
+    const auto batched = manager.acquire(model_options("a", 4));
+    EXPECT_NE(batched.get(), first.get());
+    EXPECT_EQ(loads->load(), 2);
+
+    const ModelManager::Stats stats = manager.stats();
+    EXPECT_EQ(stats.loaded_models, 2u);
+    EXPECT_EQ(stats.pinned_models, 2u);
+    EXPECT_EQ(stats.resident_bytes, 200u);
+    EXPECT_EQ(stats.hits, 1u);
+}
+
+TEST(ModelManagerTest, EvictsIdleModelsLeastRecentlyUsedAndReloads) {
+    auto loads = std::make_shared<std::atomic<int>>(0);
+    ModelManager manager(counting_manager_options(loads, 250));
+
+    auto a = manager.acquire(model_options("a"));
+    auto b = manager.acquire(model_options("b"));
+    auto c = manager.acquire(model_options("c"));
+    // Models in use are never evicted, even over budget.
+    EXPECT_EQ(manager.stats().resident_bytes, 300u);
+
+    a.reset();
+    EXPECT_EQ(manager.stats().loaded_models, 2u);
+    b.reset();
+    EXPECT_EQ(manager.stats().loaded_models, 2u);
+
+    // Reloading a pushes the idle b out.
+    a = manager.acquire(model_options("a"));
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(loads->load(), 4);
+    ModelManager::Stats stats = manager.stats();
+    EXPECT_EQ(stats.loaded_models, 2u);
+    EXPECT_EQ(stats.evictions, 2u);
+    EXPECT_EQ(stats.resident_bytes, 200u);
+
+    c.reset();
+    manager.evict_idle();
+    stats = manager.stats();
+    EXPECT_EQ(stats.loaded_models, 1u);
+    EXPECT_EQ(stats.resident_bytes, 100u);
+}
+
+TEST(ModelManagerTest, FailedLoadsReturnNullAndHandlesOutliveTheManager) {
+    auto loads = std::make_shared<std::atomic<int>>(0);
+    std::shared_ptr<InferenceInterface> handle;
+    {
+        ModelManager manager(counting_manager_options(loads));
+        EXPECT_EQ(manager.acquire(model_options("broken")), nullptr);
+        EXPECT_EQ(manager.acquire(model_options("broken")), nullptr);
+        EXPECT_EQ(manager.stats().load_failures, 2u);
+        EXPECT_EQ(manager.stats().loaded_models, 0u);
+        handle = manager.acquire(model_options("a"));
+    }
+    ASSERT_NE(handle, nullptr);
+    auto [outputs, shapes] = handle->get_infer_results(make_input());
+    EXPECT_EQ(outputs.size(), 1u);
+}
+
+TEST(ModelManagerTest, ConcurrentAcquiresLoadOnce) {
+    auto loads = std::make_shared<std::atomic<int>>(0);
+    ModelManager manager(counting_manager_options(loads));
+
+    std::vector<std::shared_ptr<InferenceInterface>> handles(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < handles.size(); ++i) {
+        threads.emplace_back([&, i] { handles[i] = manager.acquire(model_options("a")); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(loads->load(), 1);
+    for (const auto& handle : handles) {
+        EXPECT_EQ(handle.get(), handles.front().get());
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Bulk conversion kernels
+// ---------------------------------------------------------------------------
+
+TEST(ConvertKernelsTest, EverySimdLevelMatchesScalar) {
+    const ElementType types[] = {ElementType::Float32, ElementType::Float16, ElementType::Int32, ElementType::Int64,
+                                 ElementType::UInt8,   ElementType::Int8,    ElementType::Bool};
+    const SimdLevel levels[] = {SimdLevel::NEON, SimdLevel::AVX2, SimdLevel::AVX512};
+    // Odd lengths exercise the scalar tails after each vector width.
+    const size_t counts[] = {0, 1, 3, 7, 8, 9, 15, 16, 17, 31, 33, 63, 64, 65, 257};
+
+    uint32_t state = 12345;
+    std::vector<uint8_t> source(257 * 8 + 1);
+    for (uint8_t& byte : source) {
+        state = state * 1103515245u + 12345u;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+
+    int pairs = 0;
+    for (const ElementType src_type : types) {
+        for (const ElementType dst_type : types) {
+            if (!is_supported_conversion(src_type, dst_type)) {
+                continue;
+            }
+            ++pairs;
+            for (const size_t count : counts) {
+                // Offset by one byte so no kernel can rely on alignment.
+                const uint8_t* src = source.data() + 1;
+                std::vector<uint8_t> expected(count * element_type_size(dst_type) + 1);
+                convert_elements(src, src_type, expected.data() + 1, dst_type, count, SimdLevel::Scalar);
+                for (const SimdLevel level : levels) {
+                    std::vector<uint8_t> actual(expected.size());
+                    convert_elements(src, src_type, actual.data() + 1, dst_type, count, level);
+                    ASSERT_EQ(actual, expected) << simd_level_name(level) << " count " << count << " from "
+                                                << static_cast<int>(src_type) << " to "
+                                                << static_cast<int>(dst_type);
+                }
+            }
+        }
+    }
+    EXPECT_EQ(pairs, 18);
+}
+
+TEST(ConvertKernelsTest, Float16RoundsToNearestEven) {
+    EXPECT_EQ(fp32_to_fp16(1.0f), 0x3C00);
+    EXPECT_EQ(fp32_to_fp16(-0.0f), 0x8000);
+    EXPECT_EQ(fp32_to_fp16(65504.0f), 0x7BFF);
+    EXPECT_EQ(fp32_to_fp16(65520.0f), 0x7C00);             // halfway past max rounds to Inf
+    EXPECT_EQ(fp32_to_fp16(1.0f + 1.0f / 2048.0f), 0x3C00); // tie, even mantissa kept
+    EXPECT_EQ(fp32_to_fp16(1.0f + 3.0f / 2048.0f), 0x3C02); // tie, rounds up to even
+    EXPECT_EQ(fp32_to_fp16(5.9604645e-8f), 0x0001);         // smallest subnormal
+    EXPECT_EQ(fp32_to_fp16(2.9802322e-8f), 0x0000);         // half of it ties to zero
+
+    EXPECT_EQ(fp16_to_fp32(0x3C00), 1.0f);
+    EXPECT_EQ(fp16_to_fp32(0x7BFF), 65504.0f);
+    EXPECT_EQ(fp16_to_fp32(0x0001), 5.9604645e-8f);
+    EXPECT_TRUE(std::isinf(fp16_to_fp32(0xFC00)));
+    EXPECT_TRUE(std::isnan(fp16_to_fp32(0x7E00)));
+}
+
+TEST(ConvertKernelsTest, NarrowsInt64ByTruncation) {
+    const int64_t values[3] = {-1, int64_t{1} << 32, (int64_t{1} << 32) + 5};
+    int32_t out[3] = {};
+    convert_elements(values, ElementType::Int64, out, ElementType::Int32, 3);
+    EXPECT_EQ(out[0], -1);
+    EXPECT_EQ(out[1], 0);
+    EXPECT_EQ(out[2], 5);
+}
+
+TEST(ConvertKernelsTest, RejectsUnsupportedPairs) {
+    EXPECT_FALSE(is_supported_conversion(ElementType::Float32, ElementType::Int64));
+    EXPECT_TRUE(is_supported_conversion(ElementType::UInt8, ElementType::Float32));
+    float src = 1.0f;
+    int64_t dst = 0;
+    EXPECT_THROW(convert_elements(&src, ElementType::Float32, &dst, ElementType::Int64, 1), InferenceException);
+}
+
+// Counts append_elements() calls so tests can tell which converter a backend used.
+class CountingConverter : public HostTensorConverter {
+  public:
+    void append_elements(std::vector<TensorElement>& out, const void* data, std::size_t num_elements,
+                         ElementType type) const override {
+        ++calls_;
+        HostTensorConverter::append_elements(out, data, num_elements, type);
+    }
+
+    mutable int calls_ = 0;
+};
+
+// Emits its int8 output through the installed tensor converter, like the real
+// backends do.
+class ConvertingFakeBackend : public InferenceInterface {
+  public:
+    ConvertingFakeBackend() : InferenceInterface("fake_model", false, 1, {}) {}
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        (void)input_tensors;
+        const int8_t values[2] = {-3, 4};
+        std::vector<TensorElement> output;
+        tensor_converter().append_elements(output, values, 2, ElementType::Int8);
+        return std::make_tuple(std::vector<std::vector<TensorElement>>{std::move(output)},
+                               std::vector<std::vector<int64_t>>{{2}});
+    }
+};
+
+TEST(TensorConverterHookTest, BackendsUseInstalledConverter) {
+    ConvertingFakeBackend backend;
+    auto [outputs, shapes] = backend.get_infer_results(make_input());
+    ASSERT_EQ(outputs.size(), 1u);
+    EXPECT_EQ(std::get<int32_t>(outputs[0][0]), -3);
+
+    auto converter = std::make_shared<CountingConverter>();
+    backend.set_tensor_converter(converter);
+    auto [converted, converted_shapes] = backend.get_infer_results(make_input());
+    EXPECT_EQ(converter->calls_, 1);
+    EXPECT_EQ(converted, outputs);
+
+    backend.set_tensor_converter(nullptr);
+    backend.get_infer_results(make_input());
+    EXPECT_EQ(converter->calls_, 1);
+}
+
+// Shares nothing but hands out replicas, like a backend whose framework can
+// run several requests on one loaded model.
+class ReplicatingFakeBackend : public ConvertingFakeBackend {
+  protected:
+    std::unique_ptr<InferenceInterface> make_replica() override { return std::make_unique<ReplicatingFakeBackend>(); }
+};
+
+TEST(TensorConverterHookTest, ReplicasKeepTheInstalledConverter) {
+    FakeBackend plain;
+    EXPECT_EQ(plain.create_replica(), nullptr);
+
+    ReplicatingFakeBackend backend;
+    auto converter = std::make_shared<CountingConverter>();
+    backend.set_tensor_converter(converter);
+    std::unique_ptr<InferenceInterface> replica = backend.create_replica();
+    ASSERT_NE(replica, nullptr);
+    replica->get_infer_results(make_input());
+    EXPECT_EQ(converter->calls_, 1);
+}
+
+TEST(BackendDecoratorTest, ReplicasWrapAReplicaOfTheInnerBackend) {
+    ProfilingBackend plain(std::make_unique<FakeBackend>());
+    EXPECT_EQ(plain.create_replica(), nullptr);
+
+    LoggingBackend decorated(std::make_unique<ProfilingBackend>(std::make_unique<ReplicatingFakeBackend>()));
+    std::unique_ptr<InferenceInterface> replica = decorated.create_replica();
+    ASSERT_NE(replica, nullptr);
+    auto* logging = dynamic_cast<LoggingBackend*>(replica.get());
+    ASSERT_NE(logging, nullptr);
+    auto* profiling = dynamic_cast<ProfilingBackend*>(logging->inner());
+    ASSERT_NE(profiling, nullptr);
+    EXPECT_NE(dynamic_cast<ReplicatingFakeBackend*>(profiling->inner()), nullptr);
+
+    replica->get_infer_results(make_input());
+    EXPECT_EQ(profiling->get_total_inferences(), 1u);
+    EXPECT_EQ(decorated.get_total_inferences(), 0u);
+}
+
+// ---------------------------------------------------------------------------
+// Raw output API (get_infer_results_raw)
+// ---------------------------------------------------------------------------
+
+// Homogeneous outputs (one FP32 tensor, one INT64 tensor) so the default
+// variant-flattening adapter has well-defined dtypes to produce.
+class HomogeneousFakeBackend : public InferenceInterface {
+  public:
+    HomogeneousFakeBackend() : InferenceInterface("fake_model", false, 1, {}) { state_ = BackendState::Ready; }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        (void)input_tensors;
+        ++call_count_;
+        std::vector<std::vector<TensorElement>> outputs;
+        outputs.push_back({1.5f, -2.0f, 3.25f});
+        outputs.push_back({static_cast<int64_t>(10), static_cast<int64_t>(-20)});
+        std::vector<std::vector<int64_t>> shapes;
+        shapes.push_back({3});
+        shapes.push_back({2});
+        return std::make_tuple(outputs, shapes);
+    }
+
+    int call_count_ = 0;
+};
+
+TEST(RawOutputApiTest, DefaultAdapterFlattensVariantsToTypedBytes) {
+    HomogeneousFakeBackend backend;
+    const auto raw = backend.get_infer_results_raw(make_input());
+
+    ASSERT_EQ(raw.size(), 2u);
+
+    EXPECT_EQ(raw[0].dtype, TensorDtype::FP32);
+    EXPECT_EQ(raw[0].shape, (std::vector<int64_t>{3}));
+    ASSERT_EQ(raw[0].element_count(), 3u);
+    float floats[3];
+    std::memcpy(floats, raw[0].bytes.data(), sizeof(floats));
+    EXPECT_FLOAT_EQ(floats[0], 1.5f);
+    EXPECT_FLOAT_EQ(floats[1], -2.0f);
+    EXPECT_FLOAT_EQ(floats[2], 3.25f);
+
+    EXPECT_EQ(raw[1].dtype, TensorDtype::INT64);
+    EXPECT_EQ(raw[1].shape, (std::vector<int64_t>{2}));
+    ASSERT_EQ(raw[1].element_count(), 2u);
+    int64_t ints[2];
+    std::memcpy(ints, raw[1].bytes.data(), sizeof(ints));
+    EXPECT_EQ(ints[0], 10);
+    EXPECT_EQ(ints[1], -20);
+}
+
+TEST(RawOutputApiTest, DefaultAdapterRejectsMixedElementTypes) {
+    // FakeBackend's canned output mixes int32 and float in one tensor.
+    FakeBackend backend;
+    backend.load();
+    EXPECT_THROW(backend.get_infer_results_raw(make_input()), InferenceExecutionException);
+}
+
+TEST(RawOutputApiTest, RawPathKeepsDecoratorAugmentations) {
+    auto fake = std::make_unique<HomogeneousFakeBackend>();
+    HomogeneousFakeBackend* inner = fake.get();
+    CachingBackend cached(std::move(fake));
+
+    const auto first = cached.get_infer_results_raw(make_input());
+    const auto second = cached.get_infer_results_raw(make_input());
+
+    // The decorator caches raw results as well, so the second call is a cache
+    // hit and the inner backend runs exactly once.
+    EXPECT_EQ(inner->call_count_, 1);
+    ASSERT_EQ(second.size(), first.size());
+    EXPECT_EQ(second[0].bytes, first[0].bytes);
+    EXPECT_EQ(second[1].bytes, first[1].bytes);
+}
+
+// Native raw override that writes typed bytes directly, like the real
+// backends do; `corrupt_` flips one byte so the conformance check must fail.
+class NativeRawFakeBackend : public HomogeneousFakeBackend {
+  public:
+    std::vector<RawOutputTensor>
+    get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        return get_infer_results_raw(make_tensor_views(input_tensors));
+    }
+
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& inputs) override {
+        (void)inputs;
+        ++raw_call_count_;
+        const float floats[3] = {1.5f, -2.0f, 3.25f};
+        const int64_t ints[2] = {10, -20};
+        std::vector<RawOutputTensor> raw(2);
+        raw[0].dtype = TensorDtype::FP32;
+        raw[0].shape = {3};
+        std::vector<uint8_t> float_bytes(sizeof(floats));
+        std::memcpy(float_bytes.data(), floats, sizeof(floats));
+        if (corrupt_) {
+            float_bytes[0] ^= 0x1;
+        }
+        raw[0].bytes = std::move(float_bytes);
+        raw[1].dtype = TensorDtype::INT64;
+        raw[1].shape = {2};
+        const auto* int_bytes = reinterpret_cast<const uint8_t*>(ints);
+        raw[1].bytes = TensorBuffer(int_bytes, int_bytes + sizeof(ints));
+        return raw;
+    }
+
+    int raw_call_count_ = 0;
+    bool corrupt_ = false;
+};
+
+TEST(RawOutputApiTest, ConformanceAcceptsDefaultAndMatchingNativePaths) {
+    HomogeneousFakeBackend adapter;
+    EXPECT_TRUE(RawMatchesVariant(adapter, make_input()));
+
+    NativeRawFakeBackend native;
+    EXPECT_TRUE(RawMatchesVariant(native, make_input()));
+}
+
+TEST(RawOutputApiTest, ConformanceRejectsDivergentNativePath) {
+    NativeRawFakeBackend native;
+    native.corrupt_ = true;
+    EXPECT_FALSE(RawMatchesVariant(native, make_input()));
+}
+
+TEST(RawOutputApiTest, DecoratorChainStaysOnRawPath) {
+    auto native = std::make_unique<NativeRawFakeBackend>();
+    NativeRawFakeBackend* inner = native.get();
+    auto profiled = std::make_unique<ProfilingBackend>(std::make_unique<CachingBackend>(
+        std::make_unique<QuantizedBackend>(std::move(native), QuantizationParams{true, 0.5f, 2})));
+    ProfilingBackend* profiling = profiled.get();
+    LoggingBackend chain(std::move(profiled));
+
+    const auto first = chain.get_infer_results_raw(make_input());
+    const auto second = chain.get_infer_results_raw(make_input());
+
+    // Every layer handles raw outputs natively: the inner variant path is never
+    // taken, the cache absorbs the repeat and profiling still counts both.
+    EXPECT_EQ(inner->call_count_, 0);
+    EXPECT_EQ(inner->raw_call_count_, 1);
+    EXPECT_EQ(profiling->get_total_inferences(), 2u);
+    ASSERT_EQ(second.size(), 2u);
+    EXPECT_EQ(second[1].dtype, TensorDtype::FP32);
+    EXPECT_EQ(second[1].bytes, first[1].bytes);
+}
+
+TEST(RawOutputApiTest, QuantizedRawMatchesVariantPath) {
+    QuantizedBackend passthrough(std::make_unique<NativeRawFakeBackend>());
+    EXPECT_TRUE(RawMatchesVariant(passthrough, make_input()));
+
+    QuantizedBackend dequantized(std::make_unique<NativeRawFakeBackend>(), QuantizationParams{true, 0.5f, 2});
+    EXPECT_TRUE(RawMatchesVariant(dequantized, make_input()));
+
+    const auto raw = dequantized.get_infer_results_raw(make_input());
+    ASSERT_EQ(raw.size(), 2u);
+    ASSERT_EQ(raw[1].dtype, TensorDtype::FP32);
+    float values[2];
+    std::memcpy(values, raw[1].bytes.data(), sizeof(values));
+    EXPECT_FLOAT_EQ(values[0], 4.0f);
+    EXPECT_FLOAT_EQ(values[1], -11.0f);
+}
+
+TEST(RawOutputApiTest, DecoratedInferIntoUsesRawPath) {
+    auto native = std::make_unique<NativeRawFakeBackend>();
+    NativeRawFakeBackend* inner = native.get();
+    ProfilingBackend profiled(std::move(native));
+
+    std::vector<uint8_t> floats(3 * sizeof(float));
+    std::vector<uint8_t> ints(2 * sizeof(int64_t));
+    std::vector<OutputBuffer> outputs{OutputBuffer(floats.data(), floats.size()),
+                                      OutputBuffer(ints.data(), ints.size())};
+    const auto input = make_input();
+    profiled.infer_into(make_tensor_views(input), outputs);
+
+    EXPECT_EQ(inner->call_count_, 0);
+    EXPECT_EQ(inner->raw_call_count_, 1);
+    EXPECT_EQ(profiled.get_total_inferences(), 1u);
+    EXPECT_EQ(outputs[1].dtype, TensorDtype::INT64);
+}
+
+// ---------------------------------------------------------------------------
+// Zero-copy input views (TensorView overloads)
+// ---------------------------------------------------------------------------
+
+// Implements only the view overload and records the buffers it was handed, so
+// tests can tell whether a call chain copied the caller's inputs.
+class ViewRecordingBackend : public InferenceInterface {
+  public:
+    ViewRecordingBackend() : InferenceInterface("fake_model", false, 1, {}) { state_ = BackendState::Ready; }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& inputs) override {
+        ++call_count_;
+        seen_data_.clear();
+        for (const TensorView& view : inputs) {
+            seen_data_.push_back(view.data);
+        }
+        std::vector<std::vector<TensorElement>> outputs;
+        outputs.push_back({static_cast<float>(inputs.empty() ? 0 : inputs[0].size_bytes)});
+        std::vector<std::vector<int64_t>> shapes;
+        shapes.push_back({1});
+        return std::make_tuple(outputs, shapes);
+    }
+
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override {
+        return get_infer_results(make_tensor_views(input_tensors));
+    }
+
+    int call_count_ = 0;
+    std::vector<const uint8_t*> seen_data_;
+};
+
+TEST(TensorViewTest, WrapsCallerMemoryWithOptionalShape) {
+    const float pixels[6] = {0.f, 1.f, 2.f, 3.f, 4.f, 5.f};
+    const std::vector<int64_t> dims{1, 2, 3};
+
+    TensorView bare(pixels, sizeof(pixels));
+    EXPECT_EQ(bare.data, reinterpret_cast<const uint8_t*>(pixels));
+    EXPECT_EQ(bare.size_bytes, sizeof(pixels));
+    EXPECT_FALSE(bare.has_shape());
+    EXPECT_FALSE(bare.dtype.has_value());
+    EXPECT_TRUE(bare.shape_vector().empty());
+
+    TensorView shaped(pixels, sizeof(pixels), dims, TensorDataType::Float32);
+    EXPECT_TRUE(shaped.has_shape());
+    EXPECT_EQ(shaped.shape_vector(), dims);
+    EXPECT_EQ(shaped.dtype, TensorDataType::Float32);
+
+    EXPECT_TRUE(TensorView().empty());
+}
+
+TEST(TensorViewTest, DefaultOverloadMatchesVectorPath) {
+    FakeBackend backend;
+    InferenceInterface& engine = backend; // FakeBackend's own override hides the view overload
+    const auto tensors = make_input(3);
+
+    auto [view_outputs, view_shapes] = engine.get_infer_results(make_tensor_views(tensors));
+    auto [vector_outputs, vector_shapes] = backend.get_infer_results(tensors);
+
+    EXPECT_EQ(backend.call_count_, 2);
+    EXPECT_EQ(view_outputs, vector_outputs);
+    EXPECT_EQ(view_shapes, vector_shapes);
+}
+
+TEST(TensorViewTest, DecoratorChainAndRunnerPassCallerBuffers) {
+    auto fake = std::make_unique<ViewRecordingBackend>();
+    ViewRecordingBackend* inner = fake.get();
+    ModelRunner runner(std::make_unique<LoggingBackend>(std::make_unique<ProfilingBackend>(std::move(fake))));
+
+    const std::vector<uint8_t> frame{1, 2, 3, 4};
+    auto [outputs, shapes] = runner.run(std::vector<TensorView>{TensorView(frame.data(), frame.size())});
+
+    EXPECT_EQ(inner->call_count_, 1);
+    ASSERT_EQ(inner->seen_data_.size(), 1u);
+    EXPECT_EQ(inner->seen_data_[0], frame.data());
+    EXPECT_FLOAT_EQ(std::get<float>(outputs[0][0]), 4.0f);
+}
+
+TEST(TensorViewTest, DecoratorVectorOverloadTakesViewPath) {
+    auto fake = std::make_unique<ViewRecordingBackend>();
+    ViewRecordingBackend* inner = fake.get();
+    ProfilingBackend deco(std::move(fake));
+
+    const auto tensors = make_input();
+    deco.get_infer_results(tensors);
+    deco.get_infer_results(make_tensor_views(tensors));
+
+    // Both entry points reach the profiling override and neither copies.
+    EXPECT_EQ(deco.get_total_inferences(), 2u);
+    EXPECT_EQ(inner->call_count_, 2);
+    EXPECT_EQ(inner->seen_data_[0], tensors[0].data());
+}
+
+TEST(TensorViewTest, CachingSharesEntriesAcrossOverloads) {
+    auto fake = std::make_unique<FakeBackend>();
+    FakeBackend* inner = fake.get();
+    CachingBackend deco(std::move(fake));
+
+    std::vector<uint8_t> frame{9, 8, 7};
+    deco.get_infer_results(std::vector<TensorView>{TensorView(frame.data(), frame.size())});
+    EXPECT_EQ(inner->call_count_, 1);
+
+    // The cache keys on a fingerprint taken when the entry was stored, so
+    // reusing the caller's buffer for the next frame cannot corrupt it.
+    frame[0] = 0;
+    deco.get_infer_results(std::vector<std::vector<uint8_t>>{{9, 8, 7}});
+    EXPECT_EQ(inner->call_count_, 1);
+    deco.get_infer_results(std::vector<TensorView>{TensorView(frame.data(), frame.size())});
+    EXPECT_EQ(inner->call_count_, 2);
+}
+
+// Exposes the protected per-call shape check.
+class ShapeResolvingBackend : public ViewRecordingBackend {
+  public:
+    using InferenceInterface::resolve_input_shape;
+};
+
+TEST(TensorViewTest, ResolvesPerCallShapesAgainstTheModel) {
+    const std::vector<float> pixels(2 * 3 * 5);
+    const std::vector<int64_t> model_shape{-1, 3, -1};
+
+    // No shape: the model's.
+    EXPECT_EQ(ShapeResolvingBackend::resolve_input_shape(TensorView(pixels.data(), 24), 0, {1, 3, 2}, 4),
+              (std::vector<int64_t>{1, 3, 2}));
+
+    const std::vector<int64_t> fits{2, 3, 5};
+    EXPECT_EQ(ShapeResolvingBackend::resolve_input_shape(TensorView(pixels.data(), 120, fits), 0, model_shape, 4),
+              fits);
+
+    const std::vector<int64_t> fixed_dim_differs{2, 5, 3};
+    const std::vector<int64_t> wrong_rank{6, 5};
+    const std::vector<int64_t> non_positive{0, 3, 5};
+    const TensorView mismatched(pixels.data(), 120, fixed_dim_differs);
+    EXPECT_THROW(ShapeResolvingBackend::resolve_input_shape(mismatched, 0, model_shape, 4),
+                 InferenceExecutionException);
+    EXPECT_THROW(
+        ShapeResolvingBackend::resolve_input_shape(TensorView(pixels.data(), 120, wrong_rank), 0, model_shape, 4),
+        InferenceExecutionException);
+    EXPECT_THROW(
+        ShapeResolvingBackend::resolve_input_shape(TensorView(pixels.data(), 0, non_positive), 0, model_shape, 4),
+        InferenceExecutionException);
+    // Bytes for a different extent.
+    EXPECT_THROW(ShapeResolvingBackend::resolve_input_shape(TensorView(pixels.data(), 96, fits), 0, model_shape, 4),
+                 InferenceExecutionException);
+}
+
+TEST(TensorViewTest, CachingKeysOnPerCallShape) {
+    auto fake = std::make_unique<FakeBackend>();
+    FakeBackend* inner = fake.get();
+    CachingBackend deco(std::move(fake));
+
+    // The same bytes read as different shapes are different inputs.
+    const std::vector<uint8_t> bytes(24, 1);
+    const std::vector<int64_t> wide{1, 2, 12};
+    const std::vector<int64_t> tall{1, 12, 2};
+    deco.get_infer_results(std::vector<TensorView>{TensorView(bytes.data(), bytes.size(), wide)});
+    deco.get_infer_results(std::vector<TensorView>{TensorView(bytes.data(), bytes.size(), tall)});
+    EXPECT_EQ(inner->call_count_, 2);
+    deco.get_infer_results(std::vector<TensorView>{TensorView(bytes.data(), bytes.size(), wide)});
+    EXPECT_EQ(inner->call_count_, 2);
+}
+
+TEST(CachingBackendTest, ConcurrentMissesShareOneInference) {
+    std::promise<void> open_gate;
+    std::atomic<bool> destroyed{false};
+    auto gated = std::make_unique<GatedBackend>(open_gate.get_future().share(), destroyed);
+    GatedBackend* inner = gated.get();
+    CachingBackend deco(std::move(gated));
+
+    std::vector<std::future<int32_t>> callers;
+    callers.push_back(std::async(std::launch::async, [&deco] { return first_output(deco); }));
+    while (!inner->entered_) {
+        std::this_thread::yield();
+    }
+    // Later callers with the same inputs wait on the running miss (or hit
+    // the entry it stored) instead of running the backend again.
+    for (int i = 0; i < 3; ++i) {
+        callers.push_back(std::async(std::launch::async, [&deco] { return first_output(deco); }));
+    }
+    open_gate.set_value();
+    for (auto& caller : callers) {
+        EXPECT_EQ(caller.get(), 7);
+    }
+    EXPECT_EQ(inner->call_count_, 1);
+    EXPECT_EQ(deco.cached_entries(), 1u);
+}
+
+TEST(CachingBackendTest, FailedMissesAreNotCached) {
+    auto fake = std::make_unique<FakeBackend>();
+    FakeBackend* inner = fake.get();
+    fake->throw_on_infer_ = true;
+    CachingBackend deco(std::move(fake));
+
+    EXPECT_THROW(deco.get_infer_results(make_input()), InferenceExecutionException);
+    inner->throw_on_infer_ = false;
+    deco.get_infer_results(make_input());
+    deco.get_infer_results(make_input());
+    EXPECT_EQ(inner->call_count_, 2);
+}
+
+TEST(CachingBackendTest, EvictsToStayWithinByteBudget) {
+    CachingOptions unbounded;
+    unbounded.max_entries = 0;
+    unbounded.shards = 1;
+    CachingBackend probe(std::make_unique<FakeBackend>(), unbounded);
+    probe.get_infer_results(make_input(1));
+    const size_t entry_bytes = probe.cached_bytes();
+    ASSERT_GT(entry_bytes, 0u);
+
+    // Room for two entries of this size, not three.
+    CachingOptions options = unbounded;
+    options.max_bytes = entry_bytes * 2 + entry_bytes / 2;
+    auto fake = std::make_unique<FakeBackend>();
+    FakeBackend* inner = fake.get();
+    CachingBackend deco(std::move(fake), options);
+    deco.get_infer_results(make_input(1));
+    deco.get_infer_results(make_input(2));
+    deco.get_infer_results(make_input(1)); // hit, now most recent
+    deco.get_infer_results(make_input(3)); // evicts 2
+    EXPECT_EQ(inner->call_count_, 3);
+    EXPECT_EQ(deco.cached_entries(), 2u);
+    EXPECT_LE(deco.cached_bytes(), options.max_bytes);
+    deco.get_infer_results(make_input(1));
+    EXPECT_EQ(inner->call_count_, 3);
+    deco.get_infer_results(make_input(2));
+    EXPECT_EQ(inner->call_count_, 4);
+
+    // A result larger than the whole budget is returned but never stored.
+    options.max_bytes = entry_bytes / 2;
+    CachingBackend tiny(std::make_unique<FakeBackend>(), options);
+    tiny.get_infer_results(make_input(1));
+    EXPECT_EQ(tiny.cached_entries(), 0u);
+    EXPECT_EQ(tiny.cached_bytes(), 0u);
+}
+
+TEST(CachingBackendTest, HitsShareOneTypedCopyAcrossPaths) {
+    auto native = std::make_unique<NativeRawFakeBackend>();
+    NativeRawFakeBackend* inner = native.get();
+    CachingBackend deco(std::move(native));
+
+    // Neither the inputs nor TensorElement copies of the outputs are kept.
+    const std::vector<uint8_t> frame(1 << 20, 3);
+    const std::vector<TensorView> views{TensorView(frame.data(), frame.size())};
+    const auto first = deco.get_infer_results_raw(views);
+    EXPECT_LT(deco.cached_bytes(), 1024u);
+
+    // Raw hits hand out the stored buffers themselves.
+    const auto second = deco.get_infer_results_raw(views);
+    ASSERT_EQ(second.size(), 2u);
+    EXPECT_EQ(second[0].bytes.data(), first[0].bytes.data());
+    EXPECT_EQ(second[1].bytes.data(), first[1].bytes.data());
+
+    // Variant hits are widened from the same entry.
+    auto [outputs, shapes] = deco.get_infer_results(views);
+    EXPECT_EQ(inner->raw_call_count_, 1);
+    EXPECT_EQ(inner->call_count_, 0);
+    ASSERT_EQ(outputs.size(), 2u);
+    EXPECT_FLOAT_EQ(std::get<float>(outputs[0][2]), 3.25f);
+    EXPECT_EQ(std::get<int64_t>(outputs[1][1]), -20);
+    EXPECT_EQ(shapes[1], (std::vector<int64_t>{2}));
+}
+
+TEST(CachingBackendTest, SpreadsEntriesAcrossShards) {
+    CachingOptions options;
+    options.max_entries = 64;
+    auto fake = std::make_unique<FakeBackend>();
+    FakeBackend* inner = fake.get();
+    CachingBackend deco(std::move(fake), options);
+    EXPECT_EQ(deco.shard_count(), 8u);
+
+    for (uint8_t seed = 0; seed < 16; ++seed) {
+        deco.get_infer_results(make_input(seed));
+    }
+    for (uint8_t seed = 0; seed < 16; ++seed) {
+        deco.get_infer_results(make_input(seed));
+    }
+    EXPECT_EQ(inner->call_count_, 16);
+    EXPECT_EQ(deco.cached_entries(), 16u);
+    deco.clear_cache();
+    EXPECT_EQ(deco.cached_entries(), 0u);
+    EXPECT_EQ(deco.cached_bytes(), 0u);
+}
+
+// RowBackend with a static batch of two rows in its metadata.
+class StaticRowBackend : public RowBackend {
+  public:
+    StaticRowBackend() { inference_metadata_.addInput("rows", {2, 1}, 2, TensorDataType::UInt8); }
+};
+
+std::vector<float> float_outputs(const RawOutputTensor& tensor) {
+    std::vector<float> values(tensor.element_count());
+    std::memcpy(values.data(), tensor.bytes.data(), tensor.bytes.size());
+    return values;
+}
+
+TEST(CachingBackendTest, PerSampleRunsOnlyMissingRows) {
+    auto fake = std::make_unique<RowBackend>();
+    RowBackend* inner = fake.get();
+    CachingOptions options;
+    options.per_sample = true;
+    CachingBackend deco(std::move(fake), options);
+
+    const std::vector<uint8_t> first{1, 2, 3};
+    const std::vector<uint8_t> second{2, 3, 4};
+    const std::vector<uint8_t> third{3, 1};
+    const std::vector<int64_t> three_rows{3, 1};
+    const std::vector<int64_t> two_rows{2, 1};
+    deco.get_infer_results_raw(std::vector<TensorView>{TensorView(first.data(), first.size(), three_rows)});
+    const auto partial =
+        deco.get_infer_results_raw(std::vector<TensorView>{TensorView(second.data(), second.size(), three_rows)});
+    auto [outputs, shapes] =
+        deco.get_infer_results(std::vector<TensorView>{TensorView(third.data(), third.size(), two_rows)});
+
+    ASSERT_EQ(inner->batches_.size(), 2u);
+    EXPECT_EQ(inner->batches_[0], first);
+    EXPECT_EQ(inner->batches_[1], (std::vector<uint8_t>{4}));
+    ASSERT_EQ(partial.size(), 1u);
+    EXPECT_EQ(partial[0].shape, three_rows);
+    EXPECT_EQ(float_outputs(partial[0]), (std::vector<float>{4.0f, 6.0f, 8.0f}));
+    EXPECT_EQ(shapes[0], two_rows);
+    EXPECT_EQ(std::get<float>(outputs[0][0]), 6.0f);
+    EXPECT_EQ(std::get<float>(outputs[0][1]), 2.0f);
+    EXPECT_EQ(deco.cached_entries(), 4u);
+}
+
+TEST(CachingBackendTest, PerSamplePadsStaticBatches) {
+    auto fake = std::make_unique<StaticRowBackend>();
+    RowBackend* inner = fake.get();
+    CachingOptions options;
+    options.per_sample = true;
+    CachingBackend deco(std::move(fake), options);
+
+    // Three missing rows run as two padded batches of the model's two.
+    const std::vector<uint8_t> rows{5, 6, 7};
+    const std::vector<int64_t> shape{3, 1};
+    const auto result = deco.get_infer_results_raw(std::vector<TensorView>{TensorView(rows.data(), 3, shape)});
+    EXPECT_EQ(float_outputs(result[0]), (std::vector<float>{10.0f, 12.0f, 14.0f}));
+    ASSERT_EQ(inner->batches_.size(), 2u);
+    EXPECT_EQ(inner->batches_[0], (std::vector<uint8_t>{5, 6}));
+    EXPECT_EQ(inner->batches_[1], (std::vector<uint8_t>{7, 0}));
+
+    // Inputs without a shape hold the model's batch.
+    deco.get_infer_results(std::vector<std::vector<uint8_t>>{{8, 9}});
+    auto [outputs, shapes] = deco.get_infer_results(std::vector<std::vector<uint8_t>>{{9, 4}});
+    ASSERT_EQ(inner->batches_.size(), 4u);
+    EXPECT_EQ(inner->batches_[2], (std::vector<uint8_t>{8, 9}));
+    EXPECT_EQ(inner->batches_[3], (std::vector<uint8_t>{4, 0}));
+    EXPECT_EQ(std::get<float>(outputs[0][0]), 18.0f);
+    EXPECT_EQ(std::get<float>(outputs[0][1]), 8.0f);
+    EXPECT_EQ(shapes[0], (std::vector<int64_t>{2, 1}));
+}
+
+TEST(CachingBackendTest, PerSampleFallsBackWithoutBatchedOutputs) {
+    auto fake = std::make_unique<HomogeneousFakeBackend>();
+    HomogeneousFakeBackend* inner = fake.get();
+    CachingOptions options;
+    options.per_sample = true;
+    CachingBackend deco(std::move(fake), options);
+
+    // The outputs do not carry the two rows as dim 0: the first call runs again
+    // as a whole, and whole calls are cached from then on.
+    const std::vector<uint8_t> rows{1, 2};
+    const std::vector<int64_t> shape{2, 1};
+    const std::vector<TensorView> views{TensorView(rows.data(), rows.size(), shape)};
+    const auto first = deco.get_infer_results_raw(views);
+    const auto second = deco.get_infer_results_raw(views);
+    EXPECT_EQ(inner->call_count_, 2);
+    ASSERT_EQ(second.size(), first.size());
+    EXPECT_EQ(second[0].shape, (std::vector<int64_t>{3}));
+    EXPECT_EQ(second[0].bytes, first[0].bytes);
+}
+
+TEST(CachingBackendTest, PerSampleTakesTheStaticBatchFromBatchSize) {
+    // OpenVINO-style metadata: dim 0 is the three channels, the batch is two.
+    auto fake = std::make_unique<ChannelRowBackend>(std::vector<int64_t>{3, 2, 2});
+    ChannelRowBackend* inner = fake.get();
+    CachingOptions options;
+    options.per_sample = true;
+    CachingBackend deco(std::move(fake), options);
+
+    std::vector<uint8_t> rows(24, 1);
+    std::fill(rows.begin() + 12, rows.end(), 2);
+    auto [outputs, shapes] = deco.get_infer_results(std::vector<std::vector<uint8_t>>{rows});
+    ASSERT_EQ(inner->shapes_.size(), 1u);
+    EXPECT_EQ(std::get<float>(outputs[0][0]), 12.0f);
+    EXPECT_EQ(std::get<float>(outputs[0][1]), 24.0f);
+    EXPECT_EQ(deco.cached_entries(), 2u);
+
+    // The second row is cached; only the new one runs, padded to the batch.
+    std::fill(rows.begin(), rows.begin() + 12, 2);
+    std::fill(rows.begin() + 12, rows.end(), 3);
+    auto [next_outputs, next_shapes] = deco.get_infer_results(std::vector<std::vector<uint8_t>>{rows});
+    ASSERT_EQ(inner->shapes_.size(), 2u);
+    EXPECT_EQ(std::get<float>(next_outputs[0][0]), 24.0f);
+    EXPECT_EQ(std::get<float>(next_outputs[0][1]), 36.0f);
+    EXPECT_EQ(next_shapes[0], (std::vector<int64_t>{2, 1}));
+}
+
+// Reads eight hot inputs four times each, then scans 200 one-off inputs and
+// returns how many hot inputs still hit afterwards.
+size_t hot_hits_after_scan(CachingBackend& cache, const FakeBackend& inner) {
+    for (int round = 0; round < 4; ++round) {
+        for (uint8_t seed = 0; seed < 8; ++seed) {
+            cache.get_infer_results(make_input(seed));
+        }
+    }
+    for (int seed = 50; seed < 250; ++seed) {
+        cache.get_infer_results(make_input(static_cast<uint8_t>(seed)));
+    }
+    const int calls = inner.call_count_;
+    for (uint8_t seed = 0; seed < 8; ++seed) {
+        cache.get_infer_results(make_input(seed));
+    }
+    return static_cast<size_t>(8 - (inner.call_count_ - calls));
+}
+
+TEST(CachingBackendTest, TinyLfuKeepsHotEntriesThroughScans) {
+    CachingOptions options;
+    options.max_entries = 64;
+    options.shards = 1;
+
+    auto lru_inner = std::make_unique<FakeBackend>();
+    const FakeBackend& lru_calls = *lru_inner;
+    CachingBackend lru(std::move(lru_inner), options);
+    EXPECT_EQ(hot_hits_after_scan(lru, lru_calls), 0u);
+    const CachingStats lru_stats = lru.stats();
+    EXPECT_EQ(lru_stats.hits, 24u);
+    EXPECT_EQ(lru_stats.misses, 216u);
+    EXPECT_EQ(lru_stats.admission_rejects, 0u);
+    EXPECT_EQ(lru_stats.evictions, 216u - 64u);
+
+    options.policy = tiny_lfu_cache_policy();
+    auto lfu_inner = std::make_unique<FakeBackend>();
+    const FakeBackend& lfu_calls = *lfu_inner;
+    CachingBackend lfu(std::move(lfu_inner), options);
+    EXPECT_EQ(hot_hits_after_scan(lfu, lfu_calls), 8u);
+    const CachingStats lfu_stats = lfu.stats();
+    EXPECT_EQ(lfu_stats.hits, 32u);
+    EXPECT_EQ(lfu_stats.misses, 208u);
+    EXPECT_GT(lfu_stats.admission_rejects, 100u);
+    EXPECT_EQ(lfu_stats.admission_rejects + lfu_stats.evictions, 208u - 64u);
+    EXPECT_EQ(lfu.cached_entries(), 64u);
+}
+
+TEST(CachingBackendTest, TinyLfuAdmitsNewlyPopularEntries) {
+    TinyLfuPolicy policy(4);
+    const ContentHash128 a{1, 11}, b{2, 12}, c{3, 13}, d{4, 14}, e{5, 15}, f{6, 16};
+    // a, b and c fill the main area; d waits in the one-entry window.
+    for (const ContentHash128& key : {a, b, c, d}) {
+        policy.record_access(key);
+        policy.on_insert(key);
+    }
+
+    // d leaves the window no more popular than the main area's oldest entry.
+    for (int i = 0; i < 3; ++i) {
+        policy.record_access(e);
+    }
+    policy.on_insert(e);
+    const CachePolicy::Victim rejected = policy.evict();
+    EXPECT_TRUE(rejected.rejected);
+    EXPECT_EQ(rejected.key, d);
+
+    // e was read more often, so it replaces a when it leaves the window.
+    policy.record_access(f);
+    policy.on_insert(f);
+    const CachePolicy::Victim evicted = policy.evict();
+    EXPECT_FALSE(evicted.rejected);
+    EXPECT_EQ(evicted.key, a);
+}
+
+TEST(TensorViewTest, RawViewOverloadFlattensDefaultPath) {
+    HomogeneousFakeBackend backend;
+    InferenceInterface& engine = backend;
+    const auto tensors = make_input();
+    const auto from_views = engine.get_infer_results_raw(make_tensor_views(tensors));
+    const auto from_vectors = backend.get_infer_results_raw(tensors);
+
+    ASSERT_EQ(from_views.size(), from_vectors.size());
+    for (size_t i = 0; i < from_views.size(); ++i) {
+        EXPECT_EQ(from_views[i].dtype, from_vectors[i].dtype);
+        EXPECT_EQ(from_views[i].shape, from_vectors[i].shape);
+        EXPECT_EQ(from_views[i].bytes, from_vectors[i].bytes);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Caller-provided output buffers (infer_into)
+// ---------------------------------------------------------------------------
+
+TEST(InferIntoTest, OutputByteSizeFromMetadata) {
+    LayerInfo boxes{"boxes", {1, 100, 4}, 1, TensorDataType::Float32};
+    LayerInfo labels{"labels", {1, 100}, 1, TensorDataType::Int64};
+    LayerInfo dynamic{"dets", {1, -1, 6}, 1, TensorDataType::Float32};
+    EXPECT_EQ(output_byte_size(boxes), 1u * 100u * 4u * sizeof(float));
+    EXPECT_EQ(output_byte_size(labels), 100u * sizeof(int64_t));
+    EXPECT_EQ(output_byte_size(dynamic), 0u);
+}
+
+TEST(InferIntoTest, DefaultWritesIntoCallerBuffers) {
+    HomogeneousFakeBackend backend;
+    float scores[3] = {};
+    int64_t ids[4] = {};
+    std::vector<OutputBuffer> outputs{OutputBuffer(scores, sizeof(scores)), OutputBuffer(ids, sizeof(ids))};
+
+    const auto tensors = make_input();
+    backend.infer_into(make_tensor_views(tensors), outputs);
+
+    EXPECT_EQ(outputs[0].data, reinterpret_cast<uint8_t*>(scores));
+    EXPECT_EQ(outputs[0].dtype, TensorDtype::FP32);
+    EXPECT_EQ(outputs[0].size_bytes, sizeof(scores));
+    EXPECT_EQ(outputs[0].shape, (std::vector<int64_t>{3}));
+    EXPECT_FLOAT_EQ(scores[0], 1.5f);
+    EXPECT_FLOAT_EQ(scores[2], 3.25f);
+
+    // A buffer larger than the output is fine; size_bytes reports what was written.
+    EXPECT_EQ(outputs[1].dtype, TensorDtype::INT64);
+    EXPECT_EQ(outputs[1].size_bytes, 2 * sizeof(int64_t));
+    EXPECT_EQ(ids[0], 10);
+    EXPECT_EQ(ids[1], -20);
+
+    // Reusing the same buffers keeps the caller's memory and shape capacity.
+    const int64_t* shape_storage = outputs[0].shape.data();
+    backend.infer_into(make_tensor_views(tensors), outputs);
+    EXPECT_EQ(outputs[0].shape.data(), shape_storage);
+    EXPECT_EQ(backend.call_count_, 2);
+}
+
+TEST(InferIntoTest, RejectsWrongCountOrUndersizedBuffers) {
+    HomogeneousFakeBackend backend;
+    const auto tensors = make_input();
+
+    float scores[3] = {};
+    std::vector<OutputBuffer> too_few{OutputBuffer(scores, sizeof(scores))};
+    EXPECT_THROW(backend.infer_into(make_tensor_views(tensors), too_few), InferenceExecutionException);
+
+    int64_t ids[2] = {};
+    std::vector<OutputBuffer> too_small{OutputBuffer(scores, sizeof(float)), OutputBuffer(ids, sizeof(ids))};
+    EXPECT_THROW(backend.infer_into(make_tensor_views(tensors), too_small), InferenceExecutionException);
+}
+
+TEST(InferIntoTest, RunnerAndDecoratorsKeepAugmentations) {
+    auto fake = std::make_unique<HomogeneousFakeBackend>();
+    HomogeneousFakeBackend* inner = fake.get();
+    ModelRunner runner(std::make_unique<CachingBackend>(std::move(fake)));
+
+    float scores[3] = {};
+    int64_t ids[2] = {};
+    std::vector<OutputBuffer> outputs{OutputBuffer(scores, sizeof(scores)), OutputBuffer(ids, sizeof(ids))};
+    const auto tensors = make_input();
+    runner.run_into(make_tensor_views(tensors), outputs);
+    runner.run_into(make_tensor_views(tensors), outputs);
+
+    EXPECT_EQ(inner->call_count_, 1);
+    EXPECT_FLOAT_EQ(scores[1], -2.0f);
+    EXPECT_EQ(ids[1], -20);
+}
+
+// ---------------------------------------------------------------------------
+// TensorBuffer (owned or adopted output bytes)
+// ---------------------------------------------------------------------------
+
+TEST(TensorBufferTest, OwnsVectorBytes) {
+    TensorBuffer buffer(std::vector<uint8_t>{1, 2, 3});
+    EXPECT_FALSE(buffer.is_external());
+    ASSERT_EQ(buffer.size(), 3u);
+    EXPECT_EQ(buffer.data()[2], 3);
+    EXPECT_EQ(buffer.to_vector(), (std::vector<uint8_t>{1, 2, 3}));
+    EXPECT_TRUE(TensorBuffer().empty());
+
+    // Copies share storage rather than duplicating it.
+    TensorBuffer copy = buffer;
+    EXPECT_EQ(copy.data(), buffer.data());
+    EXPECT_EQ(copy, buffer);
+    EXPECT_NE(copy, TensorBuffer(std::vector<uint8_t>{1, 2, 4}));
+}
+
+TEST(TensorBufferTest, AdoptKeepsOwnerAliveUntilLastCopy) {
+    auto frame = std::make_shared<std::vector<float>>(std::vector<float>{0.5f, 1.5f});
+    std::weak_ptr<std::vector<float>> watch = frame;
+    const float* storage = frame->data();
+
+    TensorBuffer copy;
+    {
+        TensorBuffer adopted = TensorBuffer::adopt(storage, 2 * sizeof(float), std::move(frame));
+        EXPECT_TRUE(adopted.is_external());
+        EXPECT_EQ(adopted.data(), reinterpret_cast<const uint8_t*>(storage));
+        copy = adopted;
+    }
+    EXPECT_FALSE(watch.expired());
+    EXPECT_EQ(copy.size(), 2 * sizeof(float));
+
+    copy = TensorBuffer();
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST(TensorBufferTest, WithReleaseRunsCallbackOnce) {
+    static const uint8_t kBytes[4] = {9, 9, 9, 9};
+    int releases = 0;
+    {
+        TensorBuffer buffer = TensorBuffer::with_release(kBytes, sizeof(kBytes), [&releases]() { ++releases; });
+        TensorBuffer copy = buffer;
+        EXPECT_EQ(copy.data(), kBytes);
+        EXPECT_EQ(releases, 0);
+    }
+    EXPECT_EQ(releases, 1);
+}
+
+TEST(TensorBufferTest, RawOutputAcceptsAdoptedStorage) {
+    auto values = std::vector<int64_t>{4, 5, 6};
+    const int64_t* storage = values.data();
+
+    RawOutputTensor raw;
+    raw.dtype = TensorDtype::INT64;
+    raw.shape = {3};
+    raw.bytes = TensorBuffer::adopt(storage, values.size() * sizeof(int64_t), std::move(values));
+    EXPECT_EQ(raw.element_count(), 3u);
+    EXPECT_EQ(raw.bytes.data(), reinterpret_cast<const uint8_t*>(storage));
+    EXPECT_EQ(reinterpret_cast<const int64_t*>(raw.bytes.data())[1], 5);
 }
 
 int main(int argc, char** argv) {
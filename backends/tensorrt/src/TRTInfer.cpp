@@ -1,5 +1,8 @@
 #include "TRTInfer.hpp"
 
+#include "ITensorConverter.hpp"
+#include "MappedModel.hpp"
+
 #include <cuda_fp16.h> // For __half if using half-precision
 #include <fstream>
 
@@ -15,10 +18,17 @@
     } while (0)
 
 TRTInfer::TRTInfer(const std::string& model_path, bool use_gpu, size_t batch_size,
-                   const std::vector<std::vector<int64_t>>& input_sizes)
+                   const std::vector<std::vector<int64_t>>& input_sizes, const MmapTuning& mmap)
     : InferenceInterface{model_path, true, batch_size, input_sizes} {
     LOG(INFO) << "Initializing TensorRT for model " << model_path;
-    initializeBuffers(model_path, input_sizes);
+    MmapTuning mmap_tuning;
+    try {
+        mmap_tuning = mmap.with_env_defaults();
+    } catch (const InferenceException& ex) {
+        state_ = BackendState::Failed;
+        throw ModelLoadException(std::string("TensorRT model mapping: ") + ex.what());
+    }
+    initializeBuffers(model_path, input_sizes, mmap_tuning);
     populateInferenceMetadata(input_sizes);
     state_ = BackendState::Ready;
 }
@@ -45,25 +55,38 @@ TRTInfer::~TRTInfer() {
     }
 }
 
-void TRTInfer::initializeBuffers(const std::string& engine_path, const std::vector<std::vector<int64_t>>& input_sizes) {
+void TRTInfer::initializeBuffers(const std::string& engine_path, const std::vector<std::vector<int64_t>>& input_sizes,
+                                 const MmapTuning& mmap) {
     // Create TensorRT runtime
     Logger logger;
     runtime_ = nvinfer1::createInferRuntime(logger);
 
-    // Load engine file
-    std::ifstream engine_file(engine_path, std::ios::binary);
-    if (!engine_file) {
-        throw std::runtime_error("Failed to open engine file: " + engine_path);
+    if (mmap.enabled != TuningToggle::Off) {
+        // TensorRT copies the engine out of the plan, so the mapping is only
+        // needed while deserializing.
+        std::shared_ptr<const MappedModel> plan;
+        try {
+            plan = MappedModel::open(engine_path, mmap);
+        } catch (const ModelLoadException&) {
+            state_ = BackendState::Failed;
+            throw;
+        }
+        engine_.reset(runtime_->deserializeCudaEngine(plan->data(), plan->size()));
+    } else {
+        // Load engine file
+        std::ifstream engine_file(engine_path, std::ios::binary);
+        if (!engine_file) {
+            throw std::runtime_error("Failed to open engine file: " + engine_path);
+        }
+        engine_file.seekg(0, std::ios::end);
+        size_t file_size = engine_file.tellg();
+        engine_file.seekg(0, std::ios::beg);
+        std::vector<char> engine_data(file_size);
+        engine_file.read(engine_data.data(), file_size);
+        engine_file.close();
+
+        engine_.reset(runtime_->deserializeCudaEngine(engine_data.data(), file_size));
     }
-    engine_file.seekg(0, std::ios::end);
-    size_t file_size = engine_file.tellg();
-    engine_file.seekg(0, std::ios::beg);
-    std::vector<char> engine_data(file_size);
-    engine_file.read(engine_data.data(), file_size);
-    engine_file.close();
-
-    // Deserialize engine
-    engine_.reset(runtime_->deserializeCudaEngine(engine_data.data(), file_size));
     if (!engine_) {
         state_ = BackendState::Failed;
         throw std::runtime_error("Failed to deserialize TensorRT engine (plan built with an "
@@ -204,8 +227,7 @@ void TRTInfer::createContextAndAllocateBuffers(const std::vector<std::vector<int
     }
 }
 
-std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-TRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+void TRTInfer::enqueue_inference(const std::vector<TensorView>& input_tensors) {
 
     // Process user-provided input tensors
     if (input_tensors.size() != num_inputs_) {
@@ -263,7 +285,7 @@ TRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tenso
         }
 
         size_t expected_bytes = vol * element_size;
-        size_t actual_bytes = input_tensors[i].size();
+        size_t actual_bytes = input_tensors[i].size_bytes;
 
         // 4. Validation
         if (actual_bytes != expected_bytes) {
@@ -272,7 +294,7 @@ TRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tenso
         }
 
         // 5. Pass to CUDA (No casting needed!)
-        CHECK_CUDA(cudaMemcpy(buffers_[i], input_tensors[i].data(), actual_bytes, cudaMemcpyHostToDevice));
+        CHECK_CUDA(cudaMemcpy(buffers_[i], input_tensors[i].data, actual_bytes, cudaMemcpyHostToDevice));
     }
 
     // Perform inference
@@ -305,6 +327,32 @@ TRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tenso
         throw InferenceExecutionException("TensorRT enqueueV3 inference call failed");
     }
 
+    // Callers read the output buffers back with blocking cudaMemcpy calls, so
+    // the stream is only needed until the enqueued work has finished.
+    CHECK_CUDA(cudaStreamSynchronize(stream));
+    CHECK_CUDA(cudaStreamDestroy(stream));
+}
+
+std::vector<int64_t> TRTInfer::output_shape(size_t index) const {
+    const std::string& tensor_name = output_tensor_names_[index];
+    nvinfer1::Dims dims;
+    if (context_) {
+        dims = context_->getTensorShape(tensor_name.c_str());
+    } else {
+        dims = engine_->getTensorShape(tensor_name.c_str());
+    }
+    return std::vector<int64_t>(dims.d, dims.d + dims.nbDims);
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+TRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+TRTInfer::get_infer_results(const std::vector<TensorView>& input_tensors) {
+    enqueue_inference(input_tensors);
+
     // Extract outputs and their shapes
     std::vector<std::vector<int64_t>> output_shapes;
     std::vector<std::vector<TensorElement>> outputs;
@@ -321,47 +369,28 @@ TRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tenso
 
         std::vector<TensorElement> tensor_data;
 
-        switch (engine_->getTensorDataType(tensor_name.c_str())) {
-        case nvinfer1::DataType::kFLOAT: {
-            std::vector<float> output_data_float(num_elements);
-            CHECK_CUDA(cudaMemcpy(output_data_float.data(), buffers_[i + num_inputs_], num_elements * sizeof(float),
-                                  cudaMemcpyDeviceToHost));
+        // Stages the device output in host memory, then lets the converter
+        // build the elements (kHALF widens to float there).
+        auto append_output = [&](auto element, ElementType type) {
+            std::vector<decltype(element)> host_data(num_elements);
+            CHECK_CUDA(cudaMemcpy(host_data.data(), buffers_[i + num_inputs_],
+                                  num_elements * sizeof(decltype(element)), cudaMemcpyDeviceToHost));
+            tensor_converter().append_elements(tensor_data, host_data.data(), num_elements, type);
+        };
 
-            for (const auto& value : output_data_float) {
-                tensor_data.push_back(static_cast<float>(value));
-            }
+        switch (engine_->getTensorDataType(tensor_name.c_str())) {
+        case nvinfer1::DataType::kFLOAT:
+            append_output(float{}, ElementType::Float32);
             break;
-        }
-        case nvinfer1::DataType::kINT32: {
-            std::vector<int32_t> output_data_int(num_elements);
-            CHECK_CUDA(cudaMemcpy(output_data_int.data(), buffers_[i + num_inputs_], num_elements * sizeof(int32_t),
-                                  cudaMemcpyDeviceToHost));
-
-            for (const auto& value : output_data_int) {
-                tensor_data.push_back(static_cast<int32_t>(value));
-            }
+        case nvinfer1::DataType::kINT32:
+            append_output(int32_t{}, ElementType::Int32);
             break;
-        }
-        case nvinfer1::DataType::kINT64: {
-            std::vector<int64_t> output_data_int64(num_elements);
-            CHECK_CUDA(cudaMemcpy(output_data_int64.data(), buffers_[i + num_inputs_], num_elements * sizeof(int64_t),
-                                  cudaMemcpyDeviceToHost));
-
-            for (const auto& value : output_data_int64) {
-                tensor_data.push_back(static_cast<int64_t>(value));
-            }
+        case nvinfer1::DataType::kINT64:
+            append_output(int64_t{}, ElementType::Int64);
             break;
-        }
-        case nvinfer1::DataType::kHALF: {
-            std::vector<__half> output_data_half(num_elements);
-            CHECK_CUDA(cudaMemcpy(output_data_half.data(), buffers_[i + num_inputs_], num_elements * sizeof(__half),
-                                  cudaMemcpyDeviceToHost));
-
-            for (const auto& value : output_data_half) {
-                tensor_data.push_back(static_cast<float>(__half2float(value)));
-            }
+        case nvinfer1::DataType::kHALF:
+            append_output(uint16_t{}, ElementType::Float16);
             break;
-        }
         default:
             LOG(ERROR) << "Unsupported output data type for tensor " << tensor_name;
             state_ = BackendState::Failed;
@@ -378,11 +407,75 @@ TRTInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tenso
         output_shapes.emplace_back(out_shape);
     }
 
-    CHECK_CUDA(cudaStreamDestroy(stream));
-
     return std::make_tuple(std::move(outputs), std::move(output_shapes));
 }
 
+std::vector<RawOutputTensor> TRTInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> TRTInfer::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
+    enqueue_inference(input_tensors);
+
+    std::vector<RawOutputTensor> raw_outputs;
+    raw_outputs.reserve(num_outputs_);
+
+    for (size_t i = 0; i < num_outputs_; ++i) {
+        const std::string& tensor_name = output_tensor_names_[i];
+        const void* device_data = buffers_[i + num_inputs_];
+
+        RawOutputTensor raw;
+        raw.shape = output_shape(i);
+        size_t num_elements = 1;
+        for (const int64_t dim : raw.shape) {
+            if (dim > 0) {
+                num_elements *= static_cast<size_t>(dim);
+            }
+        }
+
+        // Device buffers are reused by the next call, so each output is copied
+        // once straight into its host byte buffer.
+        auto copy_bytes = [&](TensorDtype dtype) {
+            std::vector<uint8_t> bytes(num_elements * tensor_dtype_size(dtype));
+            CHECK_CUDA(cudaMemcpy(bytes.data(), device_data, bytes.size(), cudaMemcpyDeviceToHost));
+            raw.dtype = dtype;
+            raw.bytes = std::move(bytes);
+        };
+
+        switch (engine_->getTensorDataType(tensor_name.c_str())) {
+        case nvinfer1::DataType::kFLOAT:
+            copy_bytes(TensorDtype::FP32);
+            break;
+        case nvinfer1::DataType::kINT32:
+            copy_bytes(TensorDtype::INT32);
+            break;
+        case nvinfer1::DataType::kINT64:
+            copy_bytes(TensorDtype::INT64);
+            break;
+        case nvinfer1::DataType::kHALF: {
+            // Widened to FP32, matching the variant path.
+            std::vector<__half> output_data_half(num_elements);
+            CHECK_CUDA(cudaMemcpy(output_data_half.data(), device_data, num_elements * sizeof(__half),
+                                  cudaMemcpyDeviceToHost));
+            std::vector<uint8_t> bytes(num_elements * sizeof(float));
+            tensor_converter().convert(output_data_half.data(), ElementType::Float16, bytes.data(),
+                                       ElementType::Float32, num_elements);
+            raw.dtype = TensorDtype::FP32;
+            raw.bytes = std::move(bytes);
+            break;
+        }
+        default:
+            LOG(ERROR) << "Unsupported output data type for tensor " << tensor_name;
+            state_ = BackendState::Failed;
+            throw InferenceExecutionException("Unsupported output data type for tensor " + tensor_name);
+        }
+
+        raw_outputs.push_back(std::move(raw));
+    }
+
+    return raw_outputs;
+}
+
 void TRTInfer::populateInferenceMetadata(const std::vector<std::vector<int64_t>>& input_sizes) {
     bool dynamic_axis_detected = false;
 
@@ -1,4 +1,5 @@
 #pragma once
+#include "BackendTuning.hpp"
 #include "InferenceInterface.hpp"
 #include "Logger.hpp"
 
@@ -21,12 +22,16 @@ class TRTInfer : public InferenceInterface {
 
   public:
     TRTInfer(const std::string& model_path, bool use_gpu = true, size_t batch_size = 1,
-             const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>());
+             const std::vector<std::vector<int64_t>>& input_sizes = std::vector<std::vector<int64_t>>(),
+             const MmapTuning& mmap = MmapTuning());
 
     // Create execution context and allocate input/output buffers
     void createContextAndAllocateBuffers(const std::vector<std::vector<int64_t>>& input_sizes);
 
-    void initializeBuffers(const std::string& engine_path, const std::vector<std::vector<int64_t>>& input_sizes);
+    // Deserializes the plan straight from a mapping of the file unless mmap
+    // is Off, then creates the context and buffers.
+    void initializeBuffers(const std::string& engine_path, const std::vector<std::vector<int64_t>>& input_sizes,
+                           const MmapTuning& mmap = MmapTuning());
 
     // calculate size of tensor
     size_t getSizeByDim(const nvinfer1::Dims& dims);
@@ -41,7 +46,17 @@ class TRTInfer : public InferenceInterface {
 
     std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
     get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+    get_infer_results(const std::vector<TensorView>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) override;
+    std::vector<RawOutputTensor> get_infer_results_raw(const std::vector<TensorView>& input_tensors) override;
 
     void populateInferenceMetadata(const std::vector<std::vector<int64_t>>& input_sizes);
     ~TRTInfer();
+
+  private:
+    // Uploads the inputs, runs the engine and waits for it; results stay in
+    // the device output buffers.
+    void enqueue_inference(const std::vector<TensorView>& input_tensors);
+    std::vector<int64_t> output_shape(size_t index) const;
 };
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include "RawOutputConformance.hpp"
 #include "TRTInfer.hpp"
 
 #include <cstdlib>
@@ -107,6 +108,21 @@ TEST_F(TensorRTInferTest, InferenceResults) {
                             [](const TensorElement& element) { return std::holds_alternative<float>(element); }));
 }
 
+// Raw path must stay byte-identical to the variant path
+TEST_F(TensorRTInferTest, RawMatchesVariant) {
+    TRTInfer infer(model_path, true);
+
+    cv::Mat input = cv::Mat::zeros(224, 224, CV_32FC3);
+    cv::Mat blob;
+    cv::dnn::blobFromImage(input, blob, 1.f / 255.f, cv::Size(224, 224), cv::Scalar(), true, false);
+
+    std::vector<uint8_t> input_data(blob.total() * blob.elemSize());
+    memcpy(input_data.data(), blob.data, input_data.size());
+    std::vector<std::vector<uint8_t>> input_tensors = {input_data};
+
+    EXPECT_TRUE(RawMatchesVariant(infer, input_tensors));
+}
+
 // Test metadata retrieval - DISABLED due to crash
 TEST_F(TensorRTInferTest, InferenceMetadataRetrieval) {
     TRTInfer infer(model_path, true);
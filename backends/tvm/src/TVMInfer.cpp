@@ -88,10 +88,7 @@ TVMInfer::TVMInfer(const std::string& model_path, bool use_gpu, size_t batch_siz
     state_ = BackendState::Ready;
 }
 
-std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
-TVMInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
-    start_timer();
-
+void TVMInfer::check_inputs(const std::vector<TensorView>& input_tensors) const {
     if (!model_loaded_) {
         LOG(ERROR) << "TVM model not loaded";
         throw InferenceExecutionException("TVM model not loaded");
@@ -102,12 +99,23 @@ TVMInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tenso
         throw std::runtime_error("TVM backend currently supports only single input models, got " +
                                  std::to_string(input_tensors.size()) + " inputs");
     }
+}
 
-    const std::vector<uint8_t>& input_data = input_tensors[0];
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+TVMInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results(make_tensor_views(input_tensors));
+}
+
+std::tuple<std::vector<std::vector<TensorElement>>, std::vector<std::vector<int64_t>>>
+TVMInfer::get_infer_results(const std::vector<TensorView>& input_tensors) {
+    start_timer();
+    check_inputs(input_tensors);
+
+    const TensorView& input_data = input_tensors[0];
 
     try {
         LOG(INFO) << "TVM inference requested - returning dummy results";
-        LOG(INFO) << "Input data size (bytes): " << input_data.size();
+        LOG(INFO) << "Input data size (bytes): " << input_data.size_bytes;
 
         // Return dummy results for now
         std::vector<std::vector<TensorElement>> output_vectors;
@@ -143,4 +151,46 @@ TVMInfer::get_infer_results(const std::vector<std::vector<uint8_t>>& input_tenso
         LOG(ERROR) << "TVM inference failed: " << e.what();
         throw InferenceExecutionException(e.what());
     }
-}
\ No newline at end of file
+}
+
+std::vector<RawOutputTensor> TVMInfer::get_infer_results_raw(const std::vector<std::vector<uint8_t>>& input_tensors) {
+    return get_infer_results_raw(make_tensor_views(input_tensors));
+}
+
+std::vector<RawOutputTensor> TVMInfer::get_infer_results_raw(const std::vector<TensorView>& input_tensors) {
+    start_timer();
+    check_inputs(input_tensors);
+
+    try {
+        LOG(INFO) << "TVM raw inference requested - returning dummy results";
+
+        std::vector<RawOutputTensor> raw_outputs;
+        raw_outputs.reserve(num_outputs_);
+
+        for (int i = 0; i < num_outputs_; ++i) {
+            size_t num_elements = 1;
+            for (auto dim : output_shapes_[i]) {
+                num_elements *= dim;
+            }
+
+            // Dummy float32 scores written straight into the output bytes.
+            std::vector<uint8_t> bytes(num_elements * sizeof(float));
+            float* scores = reinterpret_cast<float*>(bytes.data());
+            for (size_t j = 0; j < num_elements; ++j) {
+                scores[j] = static_cast<float>(rand()) / RAND_MAX;
+            }
+
+            RawOutputTensor raw;
+            raw.dtype = TensorDtype::FP32;
+            raw.bytes = std::move(bytes);
+            raw.shape = output_shapes_[i];
+            raw_outputs.push_back(std::move(raw));
+        }
+
+        end_timer();
+        return raw_outputs;
+    } catch (const std::exception& e) {
+        LOG(ERROR) << "TVM inference failed: " << e.what();
+        throw InferenceExecutionException(e.what());
+    }
+}
@@ -38,8 +38,12 @@ function(neuriplo_add_backend_plugin backend)
     add_library(${target} MODULE
         ${entry_file}
         ${backend_sources}
+        ${NEURIPLO_PLUGIN_REPO_ROOT}/backends/src/ArtifactCache.cpp
+        ${NEURIPLO_PLUGIN_REPO_ROOT}/backends/src/AsyncInference.cpp
+        ${NEURIPLO_PLUGIN_REPO_ROOT}/backends/src/ConvertKernels.cpp
         ${NEURIPLO_PLUGIN_REPO_ROOT}/backends/src/InferenceInterface.cpp
         ${NEURIPLO_PLUGIN_REPO_ROOT}/backends/src/InferenceMetadata.cpp
+        ${NEURIPLO_PLUGIN_REPO_ROOT}/backends/src/MappedModel.cpp
     )
 
     target_include_directories(${target} PRIVATE
@@ -54,6 +58,7 @@ function(neuriplo_add_backend_plugin backend)
         ${OpenCV_LIBS}
         ${GLOG_LIBRARIES}
         glog::glog
+        Threads::Threads
     )
 
     # Only the C entry point is exported: hidden visibility plus a version
@@ -1,5 +1,10 @@
 #pragma once
+#include "BackendPool.hpp"
+#include "BackendTuning.hpp"
+#include "DeferredBackend.hpp"
+#include "HotSwapBackend.hpp"
 #include "InferenceInterface.hpp"
+#include "ShapeBucketBackend.hpp"
 #include "common.hpp"
 
 // Options for selecting and configuring an inference backend at runtime.
@@ -16,10 +21,56 @@ struct EngineOptions {
     // Directory scanned for libneuriplo_backend_*.so plugins before backend
     // resolution; the NEURIPLO_PLUGIN_DIR environment variable is also honored.
     std::string plugin_dir;
+    // Framework-specific tuning, e.g. tuning.ort.intra_op_threads. Unset
+    // fields keep the framework defaults; also passed to plugin backends.
+    BackendTuning tuning;
+    // Warmup run before setup returns, so the backend takes traffic at steady
+    // state (see Warmup.hpp): up to warmup_iterations inferences, stopping
+    // once latency settles. 0 falls back to NEURIPLO_WARMUP_ITERATIONS, and
+    // without it skips warmup. Inputs cycle through warmup_inputs (one tensor
+    // set per sample), or are zero tensors built from the input metadata.
+    size_t warmup_iterations = 0;
+    std::vector<std::vector<std::vector<uint8_t>>> warmup_inputs;
+    // Return at once in the Loading state and load (and warm up) on
+    // DeferredBackend::loader_pool(), so several models load in parallel.
+    // The result is then a DeferredBackend; see
+    // setup_inference_engine_deferred() for its readiness future.
+    bool load_in_background = false;
 };
 
 std::unique_ptr<InferenceInterface> setup_inference_engine(const EngineOptions& options);
 
+// Starts loading `options` in the background and returns at once; the result
+// is Loading until the load finishes. `on_ready`, when given, runs with Ready
+// or Failed at that point; ready() returns the same as a future. A load that
+// fails ends in Failed rather than a nullptr return.
+std::unique_ptr<DeferredBackend> setup_inference_engine_deferred(const EngineOptions& options,
+                                                                 DeferredBackend::ReadyCallback on_ready = nullptr);
+
+// Builds a BackendPool of `instances` backends for concurrent serving. The
+// first comes from setup_inference_engine(options); the others are replicas
+// sharing its weights where the backend supports that, and independently
+// loaded copies otherwise. Returns nullptr if any instance fails to load or
+// `instances` is 0.
+std::unique_ptr<BackendPool> setup_backend_pool(const EngineOptions& options, size_t instances);
+
+// HotSwapBackend serving setup_inference_engine(options); nullptr if that
+// fails to load.
+std::unique_ptr<HotSwapBackend> setup_hot_swap_backend(const EngineOptions& options);
+
+// Loads `options` on a background thread and swaps it into `backend` once it
+// is Ready, without interrupting calls. The future is false when the new model
+// fails to load, and `backend` then keeps serving its current one.
+std::future<bool> swap_model(HotSwapBackend& backend, const EngineOptions& options);
+
+// ShapeBucketBackend with one setup_inference_engine() instance per bucket,
+// each loaded with `options` at the bucket's batch_size and input_sizes.
+// With `preload` every bucket loads now and nullptr is returned if one
+// fails; otherwise each loads on its first call.
+std::unique_ptr<ShapeBucketBackend> setup_shape_bucketed_engine(const EngineOptions& options,
+                                                                std::vector<ShapeBucket> buckets,
+                                                                bool preload = false);
+
 // Backend ids available in this process: compiled-in registrations plus any
 // loaded plugins. Pass a plugin directory to scan it first ("" = environment
 // configuration only).
@@ -0,0 +1,80 @@
+#pragma once
+#include "InferenceBackendSetup.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+struct ModelManagerOptions {
+    // Upper bound on the estimated memory of loaded models; 0 = unbounded.
+    // Idle models are evicted least recently used first to stay under it.
+    // Models with live handles are never evicted, so the budget can be
+    // exceeded while every loaded model is in use.
+    size_t memory_budget_bytes = 0;
+    // Instances per model in the BackendPool behind each handle; more lets
+    // that many callers of one model run in parallel.
+    size_t instances_per_model = 1;
+    // Builds a loaded backend for a model, or returns nullptr on failure.
+    // Empty: setup_backend_pool(options, instances_per_model). A custom
+    // loader must return a backend that is safe to call concurrently if
+    // handles are shared between threads.
+    std::function<std::unique_ptr<InferenceInterface>(const EngineOptions&)> loader;
+    // Bytes a loaded model counts against the budget. Empty: the backend's
+    // get_memory_usage_mb() when it reports one, otherwise the size of the
+    // model files times instances_per_model.
+    std::function<size_t(const EngineOptions&, const InferenceInterface&)> memory_estimator;
+};
+
+// Shares loaded models between callers and bounds their total memory.
+//
+// acquire() deduplicates loads: callers asking for the same model path,
+// backend and options get handles to one backend instead of each loading a
+// copy. A handle is a shared_ptr that pins the model while any copy of it is
+// alive; once the last handle goes away the model stays loaded but becomes
+// idle, and idle models are evicted least recently used first whenever the
+// memory budget is exceeded. The next acquire() of an evicted model reloads
+// it transparently.
+//
+// Thread-safe. Concurrent acquire() calls of one model load it once; loads
+// of different models run in parallel. Handles may outlive the manager.
+class ModelManager {
+  public:
+    struct Stats {
+        size_t loaded_models = 0;
+        size_t pinned_models = 0;
+        size_t resident_bytes = 0;
+        uint64_t hits = 0;
+        uint64_t loads = 0;
+        uint64_t load_failures = 0;
+        uint64_t evictions = 0;
+    };
+
+    explicit ModelManager(ModelManagerOptions options = ModelManagerOptions());
+    ~ModelManager();
+    ModelManager(const ModelManager&) = delete;
+    ModelManager& operator=(const ModelManager&) = delete;
+
+    // Handle to the model described by `options`, loading it if it is not
+    // resident. Returns nullptr when the model fails to load, like
+    // setup_inference_engine().
+    std::shared_ptr<InferenceInterface> acquire(const EngineOptions& options);
+
+    // Evicts every idle model regardless of the budget.
+    void evict_idle();
+
+    // Changes the budget and evicts idle models to meet it.
+    void set_memory_budget(size_t bytes);
+
+    Stats stats() const;
+
+    // Identity of a load: two EngineOptions with the same key share a model.
+    static std::string model_key(const EngineOptions& options);
+
+  private:
+    struct Entry;
+    struct State;
+
+    std::shared_ptr<State> state_;
+};
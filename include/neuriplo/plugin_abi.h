@@ -58,7 +58,8 @@ typedef struct neuriplo_shape_t {
     size_t ndim;
 } neuriplo_shape_t;
 
-/* C mirror of EngineOptions. */
+/* C mirror of EngineOptions. Plugins read fields past n_input_sizes only when
+ * struct_size covers them, so hosts built before they were added still work. */
 typedef struct neuriplo_engine_options_t {
     uint32_t struct_size; /* sizeof(neuriplo_engine_options_t), for extension */
     const char* model_path;
@@ -66,6 +67,25 @@ typedef struct neuriplo_engine_options_t {
     size_t batch_size;
     const neuriplo_shape_t* input_sizes;
     size_t n_input_sizes;
+    /* EngineOptions::tuning.ort. Enum fields carry the OrtTuning enumerator
+     * index; 0 everywhere keeps ONNX Runtime's defaults. */
+    int32_t ort_intra_op_threads;
+    int32_t ort_inter_op_threads;
+    int32_t ort_execution_mode;
+    int32_t ort_graph_optimization;
+    int32_t ort_allow_spinning;
+    int32_t ort_cpu_mem_arena;
+    int32_t ort_mem_pattern;
+    int32_t ort_global_thread_pools;
+    int32_t ort_shared_cpu_allocator;
+    int32_t ort_share_prepacked_weights;
+    /* EngineOptions::tuning.artifact_cache_dir; NULL or "" leaves the cache
+     * to NEURIPLO_ARTIFACT_CACHE_DIR. */
+    const char* artifact_cache_dir;
+    /* EngineOptions::tuning.mmap, as TuningToggle indices (0 = default). */
+    int32_t mmap_enabled;
+    int32_t mmap_prefault;
+    int32_t mmap_lock;
 } neuriplo_engine_options_t;
 
 typedef struct neuriplo_layer_info_t {
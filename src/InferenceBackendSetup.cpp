@@ -1,11 +1,13 @@
 #include "InferenceBackendSetup.hpp"
 
 #include "BackendRuntimeRegistry.hpp"
+#include "Warmup.hpp"
 #include "decorators/LoggingBackend.hpp"
 #include "decorators/ProfilingBackend.hpp"
 #include "plugin/PluginLoader.hpp"
 
 #include <cstdlib>
+#include <future>
 #include <glog/logging.h>
 #include <memory>
 #include <string>
@@ -59,8 +61,36 @@ std::string known_backend_ids(const std::string& plugin_dir) {
     return ids;
 }
 
+size_t warmup_iterations(const EngineOptions& options) {
+    if (options.warmup_iterations != 0) {
+        return options.warmup_iterations;
+    }
+    const char* value = std::getenv("NEURIPLO_WARMUP_ITERATIONS");
+    if (value == nullptr || value[0] == '\0') {
+        return 0;
+    }
+    char* end = nullptr;
+    const unsigned long iterations = std::strtoul(value, &end, 10);
+    if (*end != '\0') {
+        LOG(WARNING) << "Ignoring NEURIPLO_WARMUP_ITERATIONS='" << value << "': expected an iteration count";
+        return 0;
+    }
+    return iterations;
+}
+
+// Best effort: synthesized inputs cannot fit every model, and a backend that
+// failed to warm up still serves correctly, only slower at first.
+void warm_up_if_configured(InferenceInterface& backend, const EngineOptions& options) {
+    try {
+        warm_up(backend, warmup_iterations(options), options.warmup_inputs, options.input_sizes);
+    } catch (const std::exception& e) {
+        LOG(WARNING) << "setup_inference_engine: warmup of '" << options.model_path << "' failed: " << e.what();
+    }
+}
+
 std::unique_ptr<InferenceInterface> finalize_backend(std::unique_ptr<InferenceInterface> backend,
-                                                     const std::string& model_path) {
+                                                     const EngineOptions& options) {
+    const std::string& model_path = options.model_path;
     if (!backend) {
         return nullptr;
     }
@@ -76,6 +106,8 @@ std::unique_ptr<InferenceInterface> finalize_backend(std::unique_ptr<InferenceIn
         LOG(ERROR) << "setup_inference_engine: backend failed to load model '" << model_path << "'";
         return nullptr;
     }
+
+    warm_up_if_configured(*backend, options);
     return backend;
 }
 
@@ -104,6 +136,9 @@ std::vector<std::string> available_backend_ids(const std::string& plugin_dir) {
 }
 
 std::unique_ptr<InferenceInterface> setup_inference_engine(const EngineOptions& options) {
+    if (options.load_in_background) {
+        return setup_inference_engine_deferred(options);
+    }
     load_configured_plugins(options.plugin_dir);
 
     // Compiled-in backends win id collisions with plugins (the loader already
@@ -130,8 +165,8 @@ std::unique_ptr<InferenceInterface> setup_inference_engine(const EngineOptions&
 
     if (plugin != nullptr) {
         auto backend = create_plugin_backend(*plugin, options.model_path, options.use_gpu, options.batch_size,
-                                             options.input_sizes);
-        return finalize_backend(std::move(backend), options.model_path);
+                                             options.input_sizes, options.tuning);
+        return finalize_backend(std::move(backend), options);
     }
 
     if (registration == nullptr || registration->create_factory == nullptr) {
@@ -145,9 +180,12 @@ std::unique_ptr<InferenceInterface> setup_inference_engine(const EngineOptions&
     bool effective_use_gpu = registration->force_gpu ? true : options.use_gpu;
 
     try {
-        auto backend =
-            factory->create_backend(options.model_path, effective_use_gpu, options.batch_size, options.input_sizes);
-        return finalize_backend(std::move(backend), options.model_path);
+        auto backend = factory->create_backend(options.model_path, effective_use_gpu, options.batch_size,
+                                               options.input_sizes, options.tuning);
+        if (backend) {
+            backend->set_tensor_converter(factory->create_converter());
+        }
+        return finalize_backend(std::move(backend), options);
     } catch (const InferenceException& e) {
         // Translate load failures into the nullptr contract both downstream
         // consumers already handle, instead of terminating the process.
@@ -161,6 +199,83 @@ std::unique_ptr<InferenceInterface> setup_inference_engine(const EngineOptions&
     }
 }
 
+std::unique_ptr<DeferredBackend> setup_inference_engine_deferred(const EngineOptions& options,
+                                                                 DeferredBackend::ReadyCallback on_ready) {
+    EngineOptions foreground = options;
+    foreground.load_in_background = false;
+    auto backend = std::make_unique<DeferredBackend>(options.model_path, options.use_gpu, options.batch_size,
+                                                     [foreground] { return setup_inference_engine(foreground); });
+    if (on_ready) {
+        backend->on_ready(std::move(on_ready));
+    }
+    return backend;
+}
+
+std::unique_ptr<BackendPool> setup_backend_pool(const EngineOptions& options, size_t instances) {
+    if (instances == 0) {
+        LOG(ERROR) << "setup_backend_pool: a pool needs at least one instance";
+        return nullptr;
+    }
+    std::vector<std::unique_ptr<InferenceInterface>> pool;
+    pool.reserve(instances);
+    pool.push_back(setup_inference_engine(options));
+    if (!pool.front()) {
+        return nullptr;
+    }
+
+    try {
+        while (pool.size() < instances) {
+            std::unique_ptr<InferenceInterface> replica = pool.front()->create_replica();
+            if (replica) {
+                warm_up_if_configured(*replica, options);
+            } else {
+                replica = setup_inference_engine(options);
+                if (!replica) {
+                    LOG(ERROR) << "setup_backend_pool: instance " << pool.size() << " of " << instances
+                               << " failed to load";
+                    return nullptr;
+                }
+            }
+            pool.push_back(std::move(replica));
+        }
+        return std::make_unique<BackendPool>(std::move(pool));
+    } catch (const std::exception& e) {
+        LOG(ERROR) << "setup_backend_pool: " << e.what();
+        return nullptr;
+    }
+}
+
+std::unique_ptr<HotSwapBackend> setup_hot_swap_backend(const EngineOptions& options) {
+    std::unique_ptr<InferenceInterface> initial = setup_inference_engine(options);
+    if (!initial) {
+        return nullptr;
+    }
+    return std::make_unique<HotSwapBackend>(std::move(initial));
+}
+
+std::future<bool> swap_model(HotSwapBackend& backend, const EngineOptions& options) {
+    return backend.swap_async([options] { return setup_inference_engine(options); });
+}
+
+std::unique_ptr<ShapeBucketBackend> setup_shape_bucketed_engine(const EngineOptions& options,
+                                                                std::vector<ShapeBucket> buckets, bool preload) {
+    EngineOptions base = options;
+    base.load_in_background = false;
+    auto loader = [base](const ShapeBucket& bucket) {
+        EngineOptions bucket_options = base;
+        bucket_options.batch_size = bucket.batch_size;
+        bucket_options.input_sizes = bucket.input_sizes;
+        return setup_inference_engine(bucket_options);
+    };
+    try {
+        return std::make_unique<ShapeBucketBackend>(options.model_path, options.use_gpu, std::move(buckets),
+                                                    std::move(loader), preload);
+    } catch (const InferenceException& e) {
+        LOG(ERROR) << "setup_shape_bucketed_engine: " << e.what();
+        return nullptr;
+    }
+}
+
 std::unique_ptr<InferenceInterface> setup_inference_engine(const std::string& model_path, bool use_gpu,
                                                            size_t batch_size,
                                                            const std::vector<std::vector<int64_t>>& input_sizes) {
@@ -0,0 +1,297 @@
+#include "ModelManager.hpp"
+
+#include <filesystem>
+#include <glog/logging.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void append_field(std::string& key, const std::string& value) {
+    key += std::to_string(value.size());
+    key += ':';
+    key += value;
+}
+
+void append_field(std::string& key, long long value) { append_field(key, std::to_string(value)); }
+
+// Size of a model on disk: the file, every file of a model directory, and the
+// weights next to an OpenVINO IR.
+size_t model_file_bytes(const std::string& model_path) {
+    std::error_code error;
+    const fs::path path(model_path);
+    if (fs::is_directory(path, error)) {
+        size_t total = 0;
+        for (fs::recursive_directory_iterator it(path, error), end; !error && it != end; it.increment(error)) {
+            if (it->is_regular_file(error)) {
+                total += static_cast<size_t>(it->file_size(error));
+            }
+        }
+        return total;
+    }
+    size_t total = 0;
+    const auto size = fs::file_size(path, error);
+    if (!error) {
+        total += static_cast<size_t>(size);
+    }
+    if (path.extension() == ".xml") {
+        const auto weights = fs::file_size(fs::path(path).replace_extension(".bin"), error);
+        if (!error) {
+            total += static_cast<size_t>(weights);
+        }
+    }
+    return total;
+}
+
+size_t estimate_bytes(const ModelManagerOptions& manager_options, const EngineOptions& options,
+                      const InferenceInterface& backend) {
+    if (manager_options.memory_estimator) {
+        return manager_options.memory_estimator(options, backend);
+    }
+    if (const size_t reported_mb = backend.get_memory_usage_mb()) {
+        return reported_mb * 1024 * 1024;
+    }
+    return model_file_bytes(options.model_path) * manager_options.instances_per_model;
+}
+
+} // namespace
+
+struct ModelManager::Entry {
+    explicit Entry(EngineOptions engine_options) : options(std::move(engine_options)) {}
+
+    const EngineOptions options;
+    // Serializes loads of this model.
+    std::mutex load_mutex;
+
+    // The rest is guarded by State::mutex.
+    std::shared_ptr<InferenceInterface> backend;
+    size_t bytes = 0;
+    size_t users = 0;
+    bool idle = false;
+    std::list<Entry*>::iterator idle_position;
+};
+
+struct ModelManager::State {
+    explicit State(ModelManagerOptions manager_options) : options(std::move(manager_options)) {}
+
+    // Unlinks the least recently used idle models until the budget holds;
+    // their backends are moved to `evicted` so the caller destroys them
+    // outside the lock.
+    void trim_locked(bool evict_all, std::vector<std::shared_ptr<InferenceInterface>>& evicted) {
+        while (!idle.empty() &&
+               (evict_all || (options.memory_budget_bytes != 0 && resident_bytes > options.memory_budget_bytes))) {
+            Entry* entry = idle.front();
+            idle.pop_front();
+            entry->idle = false;
+            resident_bytes -= entry->bytes;
+            LOG(INFO) << "ModelManager: evicting idle model " << entry->options.model_path << " (" << entry->bytes
+                      << " bytes)";
+            entry->bytes = 0;
+            evicted.push_back(std::move(entry->backend));
+            ++stats.evictions;
+        }
+    }
+
+    // Drops one user of `entry`; the model becomes idle with the last one.
+    void release_locked(Entry* entry, std::vector<std::shared_ptr<InferenceInterface>>& evicted) {
+        if (--entry->users == 0 && entry->backend) {
+            entry->idle = true;
+            entry->idle_position = idle.insert(idle.end(), entry);
+            trim_locked(false, evicted);
+        }
+    }
+
+    ModelManagerOptions options;
+    mutable std::mutex mutex;
+    // Entries are kept after eviction, so Entry pointers stay valid for the
+    // lifetime of the state.
+    std::unordered_map<std::string, std::unique_ptr<Entry>> entries;
+    // Idle loaded models, least recently used first.
+    std::list<Entry*> idle;
+    size_t resident_bytes = 0;
+    Stats stats;
+};
+
+namespace {
+
+// Control block of the handles of one acquire(): releases the model when the
+// last copy of the handle goes away.
+struct ModelLease {
+    ModelLease(std::shared_ptr<InferenceInterface> backend, std::function<void()> release)
+        : backend(std::move(backend)), release(std::move(release)) {}
+    ~ModelLease() { release(); }
+    ModelLease(const ModelLease&) = delete;
+    ModelLease& operator=(const ModelLease&) = delete;
+
+    std::shared_ptr<InferenceInterface> backend;
+    std::function<void()> release;
+};
+
+} // namespace
+
+ModelManager::ModelManager(ModelManagerOptions options) : state_(std::make_shared<State>(std::move(options))) {
+    if (state_->options.instances_per_model == 0) {
+        throw InferenceException("ModelManager needs at least one instance per model");
+    }
+}
+
+ModelManager::~ModelManager() { evict_idle(); }
+
+std::string ModelManager::model_key(const EngineOptions& options) {
+    // Different spellings of one file share a model.
+    std::error_code error;
+    fs::path path = fs::weakly_canonical(fs::absolute(options.model_path, error), error);
+    if (error) {
+        path = fs::path(options.model_path).lexically_normal();
+    }
+
+    std::string key;
+    append_field(key, path.string());
+    append_field(key, options.backend_id);
+    append_field(key, options.use_gpu ? 1 : 0);
+    append_field(key, static_cast<long long>(options.batch_size));
+    append_field(key, static_cast<long long>(options.input_sizes.size()));
+    for (const auto& shape : options.input_sizes) {
+        append_field(key, static_cast<long long>(shape.size()));
+        for (const int64_t dim : shape) {
+            append_field(key, static_cast<long long>(dim));
+        }
+    }
+    append_field(key, options.plugin_dir);
+
+    // Every BackendTuning field: a load with different tuning is a different
+    // model instance.
+    const OrtTuning& ort = options.tuning.ort;
+    append_field(key, ort.intra_op_threads);
+    append_field(key, ort.inter_op_threads);
+    append_field(key, static_cast<long long>(ort.execution_mode));
+    append_field(key, static_cast<long long>(ort.graph_optimization));
+    append_field(key, static_cast<long long>(ort.allow_spinning));
+    append_field(key, static_cast<long long>(ort.cpu_mem_arena));
+    append_field(key, static_cast<long long>(ort.mem_pattern));
+    append_field(key, static_cast<long long>(ort.global_thread_pools));
+    append_field(key, static_cast<long long>(ort.shared_cpu_allocator));
+    append_field(key, static_cast<long long>(ort.share_prepacked_weights));
+    const MmapTuning& mmap = options.tuning.mmap;
+    append_field(key, static_cast<long long>(mmap.enabled));
+    append_field(key, static_cast<long long>(mmap.prefault));
+    append_field(key, static_cast<long long>(mmap.lock));
+    append_field(key, options.tuning.artifact_cache_dir);
+    return key;
+}
+
+std::shared_ptr<InferenceInterface> ModelManager::acquire(const EngineOptions& options) {
+    const std::string key = model_key(options);
+    State& state = *state_;
+
+    Entry* entry = nullptr;
+    std::shared_ptr<InferenceInterface> backend;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto& slot = state.entries[key];
+        if (!slot) {
+            slot = std::make_unique<Entry>(options);
+        }
+        entry = slot.get();
+        // Pinned from here on, so eviction cannot race the load below.
+        ++entry->users;
+        if (entry->idle) {
+            state.idle.erase(entry->idle_position);
+            entry->idle = false;
+        }
+        backend = entry->backend;
+        if (backend) {
+            ++state.stats.hits;
+        }
+    }
+
+    if (!backend) {
+        std::lock_guard<std::mutex> load_lock(entry->load_mutex);
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            backend = entry->backend;
+            if (backend) {
+                ++state.stats.hits;
+            }
+        }
+        if (!backend) {
+            std::unique_ptr<InferenceInterface> loaded;
+            size_t bytes = 0;
+            try {
+                loaded = state.options.loader ? state.options.loader(entry->options)
+                                              : setup_backend_pool(entry->options, state.options.instances_per_model);
+                if (loaded) {
+                    bytes = estimate_bytes(state.options, entry->options, *loaded);
+                }
+            } catch (const std::exception& e) {
+                LOG(ERROR) << "ModelManager: " << e.what();
+                loaded.reset();
+            }
+
+            std::vector<std::shared_ptr<InferenceInterface>> evicted;
+            if (!loaded) {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                ++state.stats.load_failures;
+                state.release_locked(entry, evicted);
+                return nullptr;
+            }
+
+            backend = std::move(loaded);
+            std::lock_guard<std::mutex> lock(state.mutex);
+            entry->backend = backend;
+            entry->bytes = bytes;
+            state.resident_bytes += bytes;
+            ++state.stats.loads;
+            state.trim_locked(false, evicted);
+            if (state.options.memory_budget_bytes != 0 && state.resident_bytes > state.options.memory_budget_bytes) {
+                LOG(WARNING) << "ModelManager: " << state.resident_bytes << " bytes of models in use exceed the "
+                             << state.options.memory_budget_bytes << " byte budget";
+            }
+        }
+    }
+
+    // The lease keeps the state alive, so handles may outlive the manager.
+    std::shared_ptr<State> owner = state_;
+    auto lease = std::make_shared<ModelLease>(backend, [owner, entry] {
+        std::vector<std::shared_ptr<InferenceInterface>> evicted;
+        std::lock_guard<std::mutex> lock(owner->mutex);
+        owner->release_locked(entry, evicted);
+    });
+    InferenceInterface* raw = lease->backend.get();
+    return std::shared_ptr<InferenceInterface>(std::move(lease), raw);
+}
+
+void ModelManager::evict_idle() {
+    std::vector<std::shared_ptr<InferenceInterface>> evicted;
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->trim_locked(true, evicted);
+}
+
+void ModelManager::set_memory_budget(size_t bytes) {
+    std::vector<std::shared_ptr<InferenceInterface>> evicted;
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->options.memory_budget_bytes = bytes;
+    state_->trim_locked(false, evicted);
+}
+
+ModelManager::Stats ModelManager::stats() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    Stats stats = state_->stats;
+    stats.resident_bytes = state_->resident_bytes;
+    for (const auto& slot : state_->entries) {
+        if (slot.second->backend) {
+            ++stats.loaded_models;
+            if (slot.second->users != 0) {
+                ++stats.pinned_models;
+            }
+        }
+    }
+    return stats;
+}